@@ -39,9 +39,13 @@
 /* automatically gathered by fwd; do not hand-edit */
 /* === regcomp.c === */
 int compile(regex_t *, const chr *, size_t, int);
+const chr *TclReLiteral(regex_t *, size_t *);
+void TclReDFAStats(regex_t *, size_t [3]);
 static void moresubs(struct vars *, size_t);
 static int freev(struct vars *, int);
 static void makesearch(struct vars *, struct nfa *);
+static void findmust(struct guts *, const chr *, size_t);
+static chr *mustchain(struct cnfa *, const chr *, size_t, size_t);
 static struct subre *parse(struct vars *, int, int, struct state *, struct state *);
 static struct subre *parsebranch(struct vars *, int, int, struct state *, struct state *, int);
 static void parseqatom(struct vars *, int, int, struct state *, struct state *, struct subre *);
@@ -355,6 +359,15 @@ compile(
     v->cm = &g->cmap;
     g->lacons = NULL;
     g->nlacons = 0;
+    g->prefix = NULL;
+    g->nprefix = 0;
+    g->must = NULL;
+    g->nmust = 0;
+    g->dfas = NULL;
+    g->dfabytes = 0;
+    g->ndfabuilt = 0;
+    g->ndfareused = 0;
+    g->nssbuilt = 0;
     ZAPCNFA(g->search);
     v->nfa = newnfa(v, v->cm, NULL);
     CNOERR();
@@ -455,6 +468,7 @@ compile(
     g->lacons = v->lacons;
     v->lacons = NULL;
     g->nlacons = v->nlacons;
+    findmust(g, string, len);
 
     if (flags&REG_DUMP) {
 	dump(re, stdout);
@@ -464,6 +478,56 @@ compile(
     return freev(v, 0);
 }
 
+/*
+ - TclReLiteral - get the longest literal that every match contains
+ * Returns the literal found by findmust() at compile time, so that callers
+ * can look for it before converting a string for exec(), or NULL if there
+ * is none.
+ ^ const chr *TclReLiteral(regex_t *, size_t *);
+ */
+const chr *
+TclReLiteral(
+    regex_t *re,
+    size_t *lenp)		/* where to put the length of the literal */
+{
+    struct guts *g;
+
+    *lenp = 0;
+    if (re == NULL || re->re_magic != REMAGIC) {
+	return NULL;
+    }
+    g = (struct guts *) re->re_guts;
+    if (g->nmust > g->nprefix) {
+	*lenp = g->nmust;
+	return g->must;
+    }
+    *lenp = g->nprefix;
+    return g->prefix;
+}
+
+/*
+ - TclReDFAStats - report how well exec() has done at keeping DFAs
+ * Fills in the number of DFAs built, the number reused from earlier calls,
+ * and the number of DFA state sets computed.
+ ^ void TclReDFAStats(regex_t *, size_t [3]);
+ */
+void
+TclReDFAStats(
+    regex_t *re,
+    size_t stats[3])
+{
+    struct guts *g;
+
+    stats[0] = stats[1] = stats[2] = 0;
+    if (re == NULL || re->re_magic != REMAGIC) {
+	return;
+    }
+    g = (struct guts *) re->re_guts;
+    stats[0] = g->ndfabuilt;
+    stats[1] = g->ndfareused;
+    stats[2] = g->nssbuilt;
+}
+
 /*
  - moresubs - enlarge subRE vector
  ^ static void moresubs(struct vars *, size_t);
@@ -638,6 +702,189 @@ makesearch(
     }
 }
 
+/*
+ - findmust - find literal strings that every match must contain
+ * Looks in the compacted NFA of the whole RE for chains of states that each
+ * have a single outarc, labelled with a color of exactly one chr. If every
+ * arc out of pre leads straight into such a chain, its chrs begin every
+ * match and exec() can start searching at their first occurrence. The
+ * longest chain that every path from pre to post runs through gives chrs
+ * that any matching string must contain, so exec() can reject strings that
+ * lack them before starting up a DFA. This is purely an optimization, so
+ * running out of memory just leaves the literals empty.
+ ^ static void findmust(struct guts *, const chr *, size_t);
+ */
+static void
+findmust(
+    struct guts *g,
+    const chr *string,		/* source of the RE */
+    size_t len)
+{
+    struct cnfa *cnfa = &g->tree->cnfa;
+    struct colormap *cm = &g->cmap;
+    struct carc *ca;
+    chr *colorchr;		/* the chr of each single-chr color */
+    char *known;		/* which colorchr entries are valid */
+    size_t *chainlen;		/* length of chain starting at each state */
+    size_t *stack;		/* work area for reachability checks */
+    char *seen;
+    size_t i, s, head, nprefix, sp;
+    int tries;
+    color co;
+#define	MAXMUST		64	/* longest literal worth remembering */
+#define	MAXMUSTSTATES	1000	/* don't bother with bigger NFAs */
+#define	MAXMUSTTRIES	8	/* candidate chains to check */
+#define	MUSTNEXT(s)	(cnfa->states[s][0].co != COLORLESS \
+	&& cnfa->states[s][1].co == COLORLESS \
+	&& cnfa->states[s][0].co < cnfa->ncolors \
+	&& known[cnfa->states[s][0].co])
+
+    if (NULLCNFA(*cnfa) || cnfa->nstates > MAXMUSTSTATES
+	    || (g->cflags&REG_EXPECT)) {
+	return;
+    }
+
+    colorchr = (chr *) MALLOC(cnfa->ncolors * sizeof(chr));
+    known = (char *) MALLOC(cnfa->ncolors + cnfa->nstates);
+    chainlen = (size_t *) MALLOC(2 * cnfa->nstates * sizeof(size_t));
+    if (colorchr == NULL || known == NULL || chainlen == NULL) {
+	goto done;
+    }
+    seen = known + cnfa->ncolors;
+    stack = chainlen + cnfa->nstates;
+
+    /*
+     * A color holding a single chr that appears in the RE source can only
+     * have come from that chr; colors of other chrs are of no interest.
+     */
+
+    memset(known, 0, cnfa->ncolors);
+    for (i = 0; i < len; i++) {
+	co = GETCOLOR(cm, string[i]);
+	if (co >= 0 && co < cnfa->ncolors && cm->cd[co].nchrs == 1
+		&& !(cm->cd[co].flags&PSEUDO)) {
+	    colorchr[co] = string[i];
+	    known[co] = 1;
+	}
+    }
+
+    /*
+     * Measure the chain starting at each state. The arcs out of pre match
+     * the chr before the match, so pre cannot start a chain.
+     */
+
+    for (i = 0; i < cnfa->nstates; i++) {
+	chainlen[i] = 0;
+	if (i == cnfa->pre) {
+	    continue;
+	}
+	for (s = i; chainlen[i] < MAXMUST && MUSTNEXT(s);
+		s = cnfa->states[s][0].to) {
+	    chainlen[i]++;
+	}
+    }
+
+    /*
+     * If every arc out of pre goes to the state that starts a chain, every
+     * match begins with that chain.
+     */
+
+    nprefix = 0;
+    head = cnfa->states[cnfa->pre][0].to;
+    if (cnfa->states[cnfa->pre][0].co != COLORLESS) {
+	for (ca = cnfa->states[cnfa->pre]; ca->co != COLORLESS; ca++) {
+	    if (ca->co >= cnfa->ncolors || ca->to != head) {
+		break;
+	    }
+	}
+	if (ca->co == COLORLESS) {
+	    nprefix = chainlen[head];
+	    g->prefix = mustchain(cnfa, colorchr, head, nprefix);
+	    if (g->prefix != NULL) {
+		g->nprefix = nprefix;
+	    }
+	}
+    }
+
+    /*
+     * Try the longest chains that beat the prefix, looking for one whose
+     * first state cannot be avoided on the way from pre to post.
+     */
+
+    for (tries = 0; tries < MAXMUSTTRIES; tries++) {
+	head = 0;
+	for (i = 1; i < cnfa->nstates; i++) {
+	    if (chainlen[i] > chainlen[head]) {
+		head = i;
+	    }
+	}
+	if (chainlen[head] <= nprefix) {
+	    break;
+	}
+
+	memset(seen, 0, cnfa->nstates);
+	seen[head] = 1;
+	seen[cnfa->pre] = 1;
+	stack[0] = cnfa->pre;
+	sp = 1;
+	while (sp > 0 && !seen[cnfa->post]) {
+	    s = stack[--sp];
+	    for (ca = cnfa->states[s]; ca->co != COLORLESS; ca++) {
+		if (!seen[ca->to]) {
+		    seen[ca->to] = 1;
+		    stack[sp++] = ca->to;
+		}
+	    }
+	}
+	if (!seen[cnfa->post]) {
+	    g->must = mustchain(cnfa, colorchr, head, chainlen[head]);
+	    if (g->must != NULL) {
+		g->nmust = chainlen[head];
+	    }
+	    break;
+	}
+	chainlen[head] = 0;
+    }
+
+  done:
+    if (colorchr != NULL) {
+	FREE(colorchr);
+    }
+    if (known != NULL) {
+	FREE(known);
+    }
+    if (chainlen != NULL) {
+	FREE(chainlen);
+    }
+#undef	MUSTNEXT
+}
+
+/*
+ - mustchain - copy out the chrs along a chain found by findmust
+ ^ static chr *mustchain(struct cnfa *, const chr *, size_t, size_t);
+ */
+static chr *
+mustchain(
+    struct cnfa *cnfa,
+    const chr *colorchr,	/* the chr of each single-chr color */
+    size_t s,			/* first state of the chain */
+    size_t len)			/* number of arcs in the chain */
+{
+    chr *chain;
+    size_t i;
+
+    if (len == 0) {
+	return NULL;
+    }
+    chain = (chr *) MALLOC(len * sizeof(chr));
+    if (chain != NULL) {
+	for (i = 0; i < len; i++, s = cnfa->states[s][0].to) {
+	    chain[i] = colorchr[cnfa->states[s][0].co];
+	}
+    }
+    return chain;
+}
+
 /*
  - parse - parse an RE
  * This is actually just the top level, which parses a bunch of branches tied
@@ -2032,6 +2279,13 @@ rfree(
 	if (!NULLCNFA(g->search)) {
 	    freecnfa(&g->search);
 	}
+	if (g->prefix != NULL) {
+	    FREE(g->prefix);
+	}
+	if (g->must != NULL) {
+	    FREE(g->must);
+	}
+	freedfas(g);
 	FREE(g);
     }
 }
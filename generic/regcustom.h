@@ -103,6 +103,7 @@ typedef int celt;		/* Type to hold chr, or NOCELT */
 
 #define	compile		TclReComp
 #define	exec		TclReExec
+#define	freedfas	TclReFreeDFAs
 
 /*
 & Enable/disable debugging code (by whether REG_DEBUG is defined or not).
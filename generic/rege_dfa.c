@@ -320,19 +320,16 @@ newDFA(
     struct dfa *d;
     size_t nss = cnfa->nstates * 2;
     size_t wordsper = (cnfa->nstates + UBITS - 1) / UBITS;
-    struct smalldfa *smallwas = sml;
 
     assert(cnfa != NULL && cnfa->nstates != 0);
 
-    if (nss <= FEWSTATES && cnfa->ncolors <= FEWCOLORS) {
+    /*
+     * Small DFAs go in the preallocated space if there is any. Otherwise
+     * everything is sized to fit, since exec() may keep the DFA for a while.
+     */
+
+    if (sml != NULL && nss <= FEWSTATES && cnfa->ncolors <= FEWCOLORS) {
 	assert(wordsper == 1);
-	if (sml == NULL) {
-	    sml = (struct smalldfa *) MALLOC(sizeof(struct smalldfa));
-	    if (sml == NULL) {
-		ERR(REG_ESPACE);
-		return NULL;
-	    }
-	}
 	d = &sml->dfa;
 	d->ssets = sml->ssets;
 	d->statesarea = sml->statesarea;
@@ -340,7 +337,8 @@ newDFA(
 	d->outsarea = sml->outsarea;
 	d->incarea = sml->incarea;
 	d->cptsmalloced = 0;
-	d->mallocarea = (smallwas == NULL) ? (char *)sml : NULL;
+	d->mallocarea = NULL;
+	d->nbytes = sizeof(struct smalldfa);
     } else {
 	d = (struct dfa *) MALLOC(sizeof(struct dfa));
 	if (d == NULL) {
@@ -357,6 +355,10 @@ newDFA(
 		MALLOC(nss * cnfa->ncolors * sizeof(struct arcp));
 	d->cptsmalloced = 1;
 	d->mallocarea = (char *)d;
+	d->nbytes = sizeof(struct dfa) + nss * sizeof(struct sset)
+		+ (nss+WORK) * wordsper * sizeof(unsigned)
+		+ nss * cnfa->ncolors * (sizeof(struct sset *)
+		+ sizeof(struct arcp));
 	if (d->ssets == NULL || d->statesarea == NULL ||
 		d->outsarea == NULL || d->incarea == NULL) {
 	    freeDFA(d);
@@ -578,6 +580,7 @@ miss(
 	 }
     }
     if (i == 0) {		/* nope, need a new cache entry */
+	v->g->nssbuilt++;
 	p = getVacantSS(v, d, cp, start);
 	assert(p != css);
 	for (i = 0; i < d->wordsper; i++) {
@@ -197,7 +197,7 @@ typedef struct {
  */
 #define	REG_NOTBOL	0001	/* BOS is not BOL */
 #define	REG_NOTEOL	0002	/* EOS is not EOL */
-#define	REG_STARTEND	0004	/* backward compatibility kludge */
+#define	REG_STARTEND	0004	/* search from pmatch[0].rm_so */
 #define	REG_FTRACE	0010	/* none of your business */
 #define	REG_MTRACE	0020	/* none of your business */
 #define	REG_SMALL	0040	/* none of your business */
@@ -266,6 +266,10 @@ int regexec(regex_t *, const char *, size_t, regmatch_t [], int);
 #ifdef __REG_WIDE_T
 MODULE_SCOPE int __REG_WIDE_EXEC(regex_t *, const __REG_WIDE_T *, size_t, rm_detail_t *, size_t, regmatch_t [], int);
 #endif
+#ifdef __REG_WIDE_T
+MODULE_SCOPE const __REG_WIDE_T *TclReLiteral(regex_t *, size_t *);
+#endif
+MODULE_SCOPE void TclReDFAStats(regex_t *, size_t [3]);
 MODULE_SCOPE void regfree(regex_t *);
 MODULE_SCOPE size_t regerror(int, char *, size_t);
 /* automatically gathered by fwd; do not hand-edit */
@@ -74,10 +74,19 @@ struct dfa {
     chr *lastnopr;		/* location of last cache-flushed NOPROGRESS */
     struct sset *search;	/* replacement-search-pointer memory */
     char *mallocarea;		/* self, or malloced area, or NULL */
+    size_t nbytes;		/* memory used, all told */
 };
 
 #define	WORK	1		/* number of work bitvectors needed */
 
+/*
+ * DFAs built by exec() are kept in the guts for later calls, which then
+ * start with all the state sets found so far, as long as they take up no
+ * more than this much memory per RE.
+ */
+
+#define	DFACACHE	(512*1024)
+
 /*
  * Setup for non-malloc allocation for small cases.
  */
@@ -105,10 +114,9 @@ struct vars {
     rm_detail_t *details;
     chr *start;			/* start of string */
     chr *stop;			/* just past end of string */
+    chr *search;		/* where the search for a match begins */
     int err;			/* error code if any (0 none) */
-    struct dfa **subdfas;	/* per-subre DFAs */
-    struct smalldfa dfa1;
-    struct smalldfa dfa2;
+    struct dfa **subdfas;	/* per-subre DFAs, [0] being the search DFA */
 };
 #define	VISERR(vv) ((vv)->err != 0)	/* have we seen an error yet? */
 #define	ISERR()	VISERR(v)
@@ -125,7 +133,9 @@ struct vars {
 /* automatically gathered by fwd; do not hand-edit */
 /* === regexec.c === */
 int exec(regex_t *, const chr *, size_t, rm_detail_t *, size_t, regmatch_t [], int);
+static struct dfa *getdfa(struct vars *, int, struct cnfa *, struct colormap *);
 static struct dfa *getsubdfa(struct vars *, struct subre *);
+void freedfas(struct guts *);
 static int simpleFind(struct vars *const, struct cnfa *const, struct colormap *const);
 static int complicatedFind(struct vars *const, struct cnfa *const, struct colormap *const);
 static int complicatedFindLoop(struct vars *const, struct dfa *const, struct dfa *const, chr **const);
@@ -201,6 +211,41 @@ exec(
 	FreeVars(v);
 	return REG_NOMATCH;
     }
+
+    /*
+     * If every match contains some literal, look for that first: without it
+     * there is no match. If a literal begins every match, the search can
+     * start at its first occurrence.
+     */
+
+    v->search = (chr *)string;
+    if (flags&REG_STARTEND) {
+	/*
+	 * The search begins at pmatch[0].rm_so; what comes before it is only
+	 * context for the first characters searched.
+	 */
+
+	if (nmatch == 0 || pmatch == NULL || pmatch[0].rm_so > len) {
+	    FreeVars(v);
+	    return REG_INVARG;
+	}
+	v->search += pmatch[0].rm_so;
+    }
+    if (v->g->nmust > 0 && TclUniCharFind(v->search,
+	    string + len - v->search, v->g->must, v->g->nmust) < 0) {
+	FreeVars(v);
+	return REG_NOMATCH;
+    }
+    if (v->g->nprefix > 0) {
+	Tcl_Size at = TclUniCharFind(v->search, string + len - v->search,
+		v->g->prefix, v->g->nprefix);
+
+	if (at < 0) {
+	    FreeVars(v);
+	    return REG_NOMATCH;
+	}
+	v->search += at;
+    }
     backref = (v->g->info&REG_UBACKREF) ? 1 : 0;
     v->eflags = flags;
     if (v->g->cflags&REG_NOSUB) {
@@ -244,8 +289,25 @@ exec(
 	FreeVars(v);
 	return REG_ESPACE;
     }
-    for (i = 0; i < n; i++)
+    for (i = 0; i < n; i++) {
 	v->subdfas[i] = NULL;
+    }
+
+    /*
+     * Take over the DFAs kept by earlier calls. Their state sets depend only
+     * on the RE, so whatever they found out is still good.
+     */
+
+    if (v->g->dfas != NULL && !(flags&REG_SMALL)) {
+	for (i = 0; i < n; i++) {
+	    v->subdfas[i] = v->g->dfas[i];
+	    v->g->dfas[i] = NULL;
+	    if (v->subdfas[i] != NULL) {
+		v->g->ndfareused++;
+	    }
+	}
+	v->g->dfabytes = 0;
+    }
 
     /*
      * Do it.
@@ -276,9 +338,26 @@ exec(
 	FREE(v->pmatch);
     }
     n = v->g->ntree;
+    if (v->g->dfas == NULL && !(flags&REG_SMALL)) {
+	v->g->dfas = (struct dfa **) MALLOC(n * sizeof(struct dfa *));
+	if (v->g->dfas != NULL) {
+	    for (i = 0; i < n; i++) {
+		v->g->dfas[i] = NULL;
+	    }
+	}
+    }
     for (i = 0; i < n; i++) {
-	if (v->subdfas[i] != NULL) {
-	    freeDFA(v->subdfas[i]);
+	struct dfa *d = v->subdfas[i];
+
+	if (d == NULL) {
+	    continue;
+	}
+	if (v->g->dfas != NULL && !(flags&REG_SMALL)
+		&& v->g->dfabytes + d->nbytes <= DFACACHE) {
+	    v->g->dfas[i] = d;
+	    v->g->dfabytes += d->nbytes;
+	} else {
+	    freeDFA(d);
 	}
     }
     if (v->subdfas != subdfas) {
@@ -288,22 +367,62 @@ exec(
     return st;
 }
 
+/*
+ - getdfa - create or re-fetch the DFA in one of the subdfas slots
+ * We only need to create the DFA once per overall regex execution, or less
+ * often if exec() manages to keep it. Either way, it is dealt with by the
+ * cleanup step in exec().
+ ^ static struct dfa *getdfa(struct vars *, int, struct cnfa *,
+ ^	struct colormap *);
+ */
+static struct dfa *
+getdfa(
+    struct vars *v,
+    int i,			/* subre id, or 0 for the search DFA */
+    struct cnfa *cnfa,
+    struct colormap *cm)
+{
+    if (v->subdfas[i] == NULL) {
+	v->subdfas[i] = newDFA(v, cnfa, cm, NULL);
+	if (ISERR()) {
+	    return NULL;
+	}
+	v->g->ndfabuilt++;
+    }
+    return v->subdfas[i];
+}
+
 /*
  - getsubdfa - create or re-fetch the DFA for a subre node
- * We only need to create the DFA once per overall regex execution.
- * The DFA will be freed by the cleanup step in exec().
  */
 static struct dfa *
 getsubdfa(struct vars * v,
 	  struct subre * t)
 {
-    if (v->subdfas[t->id] == NULL) {
-	v->subdfas[t->id] = newDFA(v, &t->cnfa, &v->g->cmap, NULL);
-	if (ISERR()) {
-	    return NULL;
+    return getdfa(v, t->id, &t->cnfa, &v->g->cmap);
+}
+
+/*
+ - freedfas - free the DFAs kept in an RE's guts
+ ^ void freedfas(struct guts *);
+ */
+void
+freedfas(
+    struct guts *g)
+{
+    size_t i;
+
+    if (g->dfas == NULL) {
+	return;
+    }
+    for (i = 0; i < g->ntree; i++) {
+	if (g->dfas[i] != NULL) {
+	    freeDFA(g->dfas[i]);
 	}
     }
-    return v->subdfas[t->id];
+    FREE(g->dfas);
+    g->dfas = NULL;
+    g->dfabytes = 0;
 }
 
 /*
@@ -328,13 +447,12 @@ simpleFind(
      * First, a shot with the search RE.
      */
 
-    s = newDFA(v, &v->g->search, cm, &v->dfa1);
+    s = getdfa(v, 0, &v->g->search, cm);
     assert(!(ISERR() && s != NULL));
     NOERR();
-    MDEBUG(("\nsearch at %" TCL_Z_MODIFIER "u\n", LOFF(v->start)));
+    MDEBUG(("\nsearch at %" TCL_Z_MODIFIER "u\n", LOFF(v->search)));
     cold = NULL;
-    close = shortest(v, s, v->start, v->start, v->stop, &cold, NULL);
-    freeDFA(s);
+    close = shortest(v, s, v->search, v->search, v->stop, &cold, NULL);
     NOERR();
     if (v->g->cflags&REG_EXPECT) {
 	assert(v->details != NULL);
@@ -360,7 +478,7 @@ simpleFind(
     open = cold;
     cold = NULL;
     MDEBUG(("between %" TCL_Z_MODIFIER "u and %" TCL_Z_MODIFIER "u\n", LOFF(open), LOFF(close)));
-    d = newDFA(v, cnfa, cm, &v->dfa1);
+    d = getdfa(v, v->g->tree->id, cnfa, cm);
     assert(!(ISERR() && d != NULL));
     NOERR();
     for (begin = open; begin <= close; begin++) {
@@ -371,7 +489,6 @@ simpleFind(
 	    end = longest(v, d, begin, v->stop, &hitend);
 	}
 	if (ISERR()) {
-	    freeDFA(d);
 	    return v->err;
 	}
 	if (hitend && cold == NULL) {
@@ -382,7 +499,6 @@ simpleFind(
 	}
     }
     assert(end != NULL);	/* search RE succeeded so loop should */
-    freeDFA(d);
 
     /*
      * And pin down details.
@@ -425,19 +541,13 @@ complicatedFind(
     chr *cold = NULL; /* silence gcc 4 warning */
     int ret;
 
-    s = newDFA(v, &v->g->search, cm, &v->dfa1);
+    s = getdfa(v, 0, &v->g->search, cm);
+    NOERR();
+    d = getdfa(v, v->g->tree->id, cnfa, cm);
     NOERR();
-    d = newDFA(v, cnfa, cm, &v->dfa2);
-    if (ISERR()) {
-	assert(d == NULL);
-	freeDFA(s);
-	return v->err;
-    }
 
     ret = complicatedFindLoop(v, d, s, &cold);
 
-    freeDFA(d);
-    freeDFA(s);
     NOERR();
     if (v->g->cflags&REG_EXPECT) {
 	assert(v->details != NULL);
@@ -473,7 +583,7 @@ complicatedFindLoop(
 
     assert(d != NULL && s != NULL);
     cold = NULL;
-    close = v->start;
+    close = v->search;
     do {
 	MDEBUG(("\ncsearch at %" TCL_Z_MODIFIER "u\n", LOFF(close)));
 	close = shortest(v, s, close, close, v->stop, &cold, NULL);
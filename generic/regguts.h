@@ -388,6 +388,8 @@ struct fns {
  * the insides of a regex_t, hidden behind a void *
  */
 
+struct dfa;			/* see regexec.c */
+
 struct guts {
     int magic;
 #define	GUTSMAGIC	0xFED9
@@ -401,8 +403,20 @@ struct guts {
     int (*compare) (const chr *, const chr *, size_t);
     struct subre *lacons;	/* lookahead-constraint vector */
     size_t nlacons;		/* size of lacons */
+    chr *prefix;		/* literal every match begins with, or NULL */
+    size_t nprefix;		/* length of prefix */
+    chr *must;			/* longer literal every match contains */
+    size_t nmust;		/* length of must */
+    struct dfa **dfas;		/* DFAs kept from earlier matches, indexed
+				 * by subre id, [0] being the search DFA */
+    size_t dfabytes;		/* memory held by dfas */
+    size_t ndfabuilt;		/* statistics: DFAs built by exec() */
+    size_t ndfareused;		/* DFAs exec() found already built */
+    size_t nssbuilt;		/* DFA state sets computed */
 };
 
+MODULE_SCOPE void freedfas(struct guts *);
+
 /*
  * Magic for allocating a variable workspace. This default version is
  * stack-hungry.
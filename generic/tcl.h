@@ -1373,10 +1373,12 @@ typedef void (Tcl_ScaleTimeProc) (Tcl_Time *timebuf, void *clientData);
 #endif
 
 /*
- * Channel version tag. This was introduced in 8.3.2/8.4.
+ * Channel version tag. This was introduced in 8.3.2/8.4. Version 6 adds the
+ * outputvProc field.
  */
 
 #define TCL_CHANNEL_VERSION_5	((Tcl_ChannelTypeVersion) 0x5)
+#define TCL_CHANNEL_VERSION_6	((Tcl_ChannelTypeVersion) 0x6)
 
 /*
  * TIP #218: Channel Actions, Ids for Tcl_DriverThreadActionProc.
@@ -1422,6 +1424,16 @@ typedef void	(Tcl_DriverThreadActionProc) (void *instanceData,
  */
 typedef int	(Tcl_DriverTruncateProc) (void *instanceData,
 			long long length);
+/*
+ * Gathered output, one Tcl_ChannelIOVec per buffer to write.
+ */
+typedef struct Tcl_ChannelIOVec {
+    const char *buf;		/* First byte to write. */
+    int len;			/* Number of bytes to write from buf. */
+} Tcl_ChannelIOVec;
+typedef int	(Tcl_DriverOutputvProc) (void *instanceData,
+			const Tcl_ChannelIOVec *vec, int count,
+			int *errorCodePtr);
 
 /*
  * struct Tcl_ChannelType:
@@ -1483,6 +1495,10 @@ typedef struct Tcl_ChannelType {
 				/* Function to call to truncate the underlying
 				 * file to a particular length. May be NULL if
 				 * the channel does not support truncation. */
+    Tcl_DriverOutputvProc *outputvProc;
+				/* Function to call to write several buffers
+				 * in one go. May be NULL. Only present in
+				 * TCL_CHANNEL_VERSION_6 channel types. */
 } Tcl_ChannelType;
 
 /*
@@ -96,6 +96,26 @@ typedef struct {
 #define SORTMODE_DICTIONARY	4
 #define SORTMODE_ASCII_NC	8
 
+/*
+ * Numeric sorts (-integer and -real) of at least this many elements are done
+ * with an LSD radix sort on the pre-extracted collation keys instead of the
+ * merge sort. Below this the merge sort is at least as fast.
+ */
+
+#define RADIX_SORT_THRESHOLD	64
+
+/*
+ * Structure used by RadixSortElements to hold the order-preserving unsigned
+ * transform of a numeric collation key together with the element it belongs
+ * to.
+ */
+
+typedef struct {
+    Tcl_WideUInt key;		/* Unsigned key whose natural order is the
+				 * desired sort order. */
+    SortElement *elemPtr;	/* Element the key was extracted from. */
+} RadixElement;
+
 /*
  * Definitions for [lseq] command
  */
@@ -139,6 +159,8 @@ static Tcl_ObjCmdProc	InfoCmdTypeCmd;
 static Tcl_ObjCmdProc	InfoTclVersionCmd;
 static SortElement *	MergeLists(SortElement *leftPtr, SortElement *rightPtr,
 			    SortInfo *infoPtr);
+static SortElement *	RadixSortElements(SortElement *elementArray,
+			    Tcl_Size length, SortInfo *infoPtr);
 static int		SortCompare(SortElement *firstPtr, SortElement *second,
 			    SortInfo *infoPtr);
 static Tcl_Obj *	SelectObjFromSublist(Tcl_Obj *firstPtr,
@@ -4902,31 +4924,48 @@ Tcl_LsortObjCmd(
 	} else {
 	    elementArray[i].payload.objPtr = listObjPtrs[idx];
 	}
+	elementArray[i].nextPtr = NULL;
+    }
+
+    /*
+     * All collation keys are now extracted, so no further list lookups or
+     * numeric conversions happen while sorting. Large numeric sorts use a
+     * radix sort on those keys; it gives up (returning NULL) only when it
+     * cannot get its working memory.
+     */
+
+    elementPtr = NULL;
+    if ((sortMode == SORTMODE_INTEGER || sortMode == SORTMODE_REAL)
+	    && (length >= RADIX_SORT_THRESHOLD)) {
+	elementPtr = RadixSortElements(elementArray, length, &sortInfo);
+    }
 
+    if (elementPtr == NULL) {
 	/*
-	 * Merge this element in the preexisting sublists (and merge together
+	 * Merge each element in the preexisting sublists (and merge together
 	 * sublists when we have two of the same size).
 	 */
 
-	elementArray[i].nextPtr = NULL;
-	elementPtr = &elementArray[i];
-	for (j=0 ; subList[j] ; j++) {
-	    elementPtr = MergeLists(subList[j], elementPtr, &sortInfo);
-	    subList[j] = NULL;
-	}
-	if (j >= NUM_LISTS) {
-	    j = NUM_LISTS-1;
+	for (i=0; i < length; i++) {
+	    elementPtr = &elementArray[i];
+	    for (j=0 ; subList[j] ; j++) {
+		elementPtr = MergeLists(subList[j], elementPtr, &sortInfo);
+		subList[j] = NULL;
+	    }
+	    if (j >= NUM_LISTS) {
+		j = NUM_LISTS-1;
+	    }
+	    subList[j] = elementPtr;
 	}
-	subList[j] = elementPtr;
-    }
 
-    /*
-     * Merge all sublists
-     */
+	/*
+	 * Merge all sublists
+	 */
 
-    elementPtr = subList[0];
-    for (j=1 ; j<NUM_LISTS ; j++) {
-	elementPtr = MergeLists(subList[j], elementPtr, &sortInfo);
+	elementPtr = subList[0];
+	for (j=1 ; j<NUM_LISTS ; j++) {
+	    elementPtr = MergeLists(subList[j], elementPtr, &sortInfo);
+	}
     }
 
     /*
@@ -5204,6 +5243,126 @@ MergeLists(
     return headPtr;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * RadixSortElements --
+ *
+ *	This procedure sorts an array of SortElement structures holding
+ *	integer or real collation keys with a stable LSD radix sort, one byte
+ *	of the key per pass. Passes in which all keys share the same byte are
+ *	skipped, so small ranges of values cost only a few passes.
+ *
+ * Results:
+ *	The sorted elements linked together through their nextPtr fields, in
+ *	exactly the order MergeLists would have produced, or NULL if the
+ *	working memory is unavailable and the elements must be sorted by
+ *	MergeLists instead. NaN never gets here: Tcl_GetDoubleFromObj rejects
+ *	it, so the real keys are totally ordered.
+ *
+ * Side effects:
+ *	If infoPtr->unique is set then infoPtr->numElements may be updated.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static SortElement *
+RadixSortElements(
+    SortElement *elementArray,	/* Elements with collation keys set. */
+    Tcl_Size length,		/* Number of elements in elementArray. */
+    SortInfo *infoPtr)		/* Information about the sort. */
+{
+    RadixElement *items, *src, *dst, *tmp;
+    Tcl_Size i, count[8][256];
+    Tcl_WideUInt key;
+    SortElement *headPtr, *tailPtr;
+    int pass, digit;
+
+    items = (RadixElement *)Tcl_AttemptAlloc(
+	    2 * length * sizeof(RadixElement));
+    if (items == NULL) {
+	return NULL;
+    }
+    memset(count, 0, sizeof(count));
+
+    /*
+     * Map each key onto an unsigned integer with the same ordering, and
+     * count the occurrences of each byte value for all passes at once.
+     */
+
+    for (i = 0; i < length; i++) {
+	if (infoPtr->sortMode == SORTMODE_INTEGER) {
+	    key = (Tcl_WideUInt) elementArray[i].collationKey.wideValue
+		    ^ ((Tcl_WideUInt) 1 << 63);
+	} else {
+	    double d = elementArray[i].collationKey.doubleValue;
+
+	    if (d == 0.0) {
+		d = 0.0;		/* -0.0 and 0.0 compare equal. */
+	    }
+	    memcpy(&key, &d, sizeof(key));
+	    if (key >> 63) {
+		key = ~key;
+	    } else {
+		key |= (Tcl_WideUInt) 1 << 63;
+	    }
+	}
+	if (!infoPtr->isIncreasing) {
+	    key = ~key;
+	}
+	items[i].key = key;
+	items[i].elemPtr = &elementArray[i];
+	for (pass = 0; pass < 8; pass++) {
+	    count[pass][(key >> (8 * pass)) & 0xFF]++;
+	}
+    }
+
+    src = items;
+    dst = items + length;
+    for (pass = 0; pass < 8; pass++) {
+	Tcl_Size offset = 0, n;
+
+	if (count[pass][(src[0].key >> (8 * pass)) & 0xFF] == length) {
+	    continue;
+	}
+	for (digit = 0; digit < 256; digit++) {
+	    n = count[pass][digit];
+	    count[pass][digit] = offset;
+	    offset += n;
+	}
+	for (i = 0; i < length; i++) {
+	    digit = (src[i].key >> (8 * pass)) & 0xFF;
+	    dst[count[pass][digit]++] = src[i];
+	}
+	tmp = src;
+	src = dst;
+	dst = tmp;
+    }
+
+    /*
+     * Link the sorted elements. As with MergeLists, -unique keeps only the
+     * last of a run of equal elements.
+     */
+
+    headPtr = tailPtr = NULL;
+    for (i = 0; i < length; i++) {
+	if (infoPtr->unique && (i + 1 < length)
+		&& (src[i].key == src[i + 1].key)) {
+	    infoPtr->numElements--;
+	    continue;
+	}
+	if (tailPtr == NULL) {
+	    headPtr = src[i].elemPtr;
+	} else {
+	    tailPtr->nextPtr = src[i].elemPtr;
+	}
+	tailPtr = src[i].elemPtr;
+    }
+    tailPtr->nextPtr = NULL;
+    Tcl_Free(items);
+    return headPtr;
+}
+
 /*
  *----------------------------------------------------------------------
  *
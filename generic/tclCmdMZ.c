@@ -34,6 +34,86 @@ static int		StringCmpOpts(Tcl_Interp *interp, int objc,
 			    Tcl_Obj *const objv[], int *nocase,
 			    Tcl_Size *reqlength);
 
+/*
+ * A "string map" with at least MAP_AUTOMATON_PAIRS key/value pairs is done
+ * with an Aho-Corasick automaton over its keys, so that the cost of mapping
+ * no longer grows with the number of keys. Smaller maps are cheaper to scan
+ * directly.
+ */
+
+#define MAP_AUTOMATON_PAIRS	4
+
+/*
+ * An edge of the key trie, labelled with a (case-folded for -nocase)
+ * character. The edges leaving a node are stored consecutively, sorted by
+ * character.
+ */
+
+typedef struct {
+    Tcl_UniChar ch;		/* Character labelling the edge. */
+    Tcl_Size target;		/* Index of the node the edge leads to. */
+} MapEdge;
+
+/*
+ * A node of the key trie. Node 0 is the root. Every node stands for the
+ * prefix of one or more keys spelled by the path from the root.
+ */
+
+typedef struct {
+    Tcl_Size firstEdge;		/* Index of the first outgoing edge. */
+    Tcl_Size numEdges;		/* Number of outgoing edges. */
+    Tcl_Size depth;		/* Length of the prefix. */
+    Tcl_Size fail;		/* Node of the longest proper suffix of the
+				 * prefix that is also a prefix of a key. */
+    Tcl_Size key;		/* Index of the first key equal to the
+				 * prefix, or -1. */
+    Tcl_Size output;		/* Nearest node along the fail chain (not
+				 * including this one) with key >= 0, or -1. */
+} MapNode;
+
+/*
+ * The matching automaton for one map. It keeps a reference to the map value
+ * it was built from; as that makes the value shared, the value can't change
+ * while the automaton exists.
+ */
+
+typedef struct {
+    Tcl_Obj *mapObj;		/* Map the automaton was built from. */
+    int nocase;			/* Whether keys are matched case-insensitively. */
+    MapNode *nodes;		/* The trie, root first. */
+    MapEdge *edges;		/* Edges of all nodes. */
+    Tcl_Size rootAscii[128];	/* Fast lookup of the root's edges for ASCII
+				 * characters: target node, or 0 if none. */
+    Tcl_Size numValues;		/* Number of key/value pairs. */
+    Tcl_UniChar **values;	/* Replacement for each key. */
+    Tcl_Size *valueLens;	/* Length of each replacement. */
+} MapAutomaton;
+
+/*
+ * Thread local storage used to maintain a per-thread cache of map automata,
+ * most recently used first.
+ */
+
+#define NUM_MAP_AUTOMATA 4
+
+typedef struct {
+    int initialized;		/* Set to 1 when the cache is initialized. */
+    MapAutomaton *automata[NUM_MAP_AUTOMATA];
+				/* Cached automata, or NULL. */
+} ThreadSpecificData;
+
+static Tcl_ThreadDataKey dataKey;
+
+static void		FinalizeMapAutomata(void *clientData);
+static inline Tcl_Size	FindMapEdge(const MapAutomaton *amPtr, Tcl_Size node,
+			    Tcl_UniChar ch);
+static void		FreeMapAutomaton(MapAutomaton *amPtr);
+static MapAutomaton *	GetMapAutomaton(Tcl_Obj *mapObj, Tcl_Size mapElemc,
+			    Tcl_Obj *const mapElemv[], int nocase);
+static void		MapWithAutomaton(MapAutomaton *amPtr,
+			    const Tcl_UniChar *ustring, Tcl_Size length,
+			    Tcl_Obj *resultPtr);
+
 /*
  * Default set of characters to trim in [string trim] and friends. This is a
  * UTF-8 literal string containing all Unicode space characters [TIP #413]
@@ -466,6 +546,342 @@ Tcl_RegexpObjCmd(
     return TCL_OK;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclRegexpStreamObjCmd --
+ *
+ *	This procedure is invoked to process the
+ *	"::tcl::unsupported::regexpstream" command:
+ *
+ *	    regexpstream ?-option ...? exp channelId cmdPrefix
+ *
+ *	It reads the channel to its end and calls the command prefix with one
+ *	extra argument for each match of exp in the text read, in the form
+ *	that "regexp -all -inline" gives for a match: a list of the matched
+ *	text and the text of each subexpression, or with -indices their
+ *	character indices in the stream. A break from the command stops the
+ *	reading. Only the text from which a match could still start is kept,
+ *	so memory use is bounded by the read size plus the longest match or
+ *	partial match, not by the size of the input.
+ *
+ * Results:
+ *	A standard Tcl result; on success, the number of matches.
+ *
+ * Side effects:
+ *	Reads from the channel and evaluates the command prefix.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+TclRegexpStreamObjCmd(
+    TCL_UNUSED(void *),
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    Tcl_Size bufferSize = 4096, base, offset, length, cold, start, end;
+    Tcl_Size numParts, count;
+    int i, j, indices, mode, eof, afterMatch, match, eflags, cflags;
+    int result = TCL_OK;
+    Tcl_RegExp regExpr;
+    Tcl_RegExpInfo info;
+    Tcl_Channel chan;
+    Tcl_Obj *patternPtr, *bufPtr, *chunkPtr, *matchPtr, *cmdPtr, *newPtr;
+    static const char *const options[] = {
+	"-buffersize",	"-expanded",	"-indices",	"-line",
+	"-linestop",	"-lineanchor",	"-nocase",	"--",
+	NULL
+    };
+    enum regexpstreamoptions {
+	STREAM_BUFFERSIZE,	STREAM_EXPANDED,	STREAM_INDICES,
+	STREAM_LINE,	STREAM_LINESTOP,	STREAM_LINEANCHOR,
+	STREAM_NOCASE,	STREAM_LAST
+    } index;
+
+    indices = 0;
+    cflags = TCL_REG_ADVANCED | TCL_REG_CANMATCH;
+
+    for (i = 1; i < objc; i++) {
+	const char *name;
+
+	name = TclGetString(objv[i]);
+	if (name[0] != '-') {
+	    break;
+	}
+	if (Tcl_GetIndexFromObj(interp, objv[i], options, "option", TCL_EXACT,
+		&index) != TCL_OK) {
+	    return TCL_ERROR;
+	}
+	switch (index) {
+	case STREAM_BUFFERSIZE:
+	    if (++i >= objc) {
+		goto endOfForLoop;
+	    }
+	    if (Tcl_GetSizeIntFromObj(interp, objv[i], &bufferSize) != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    if (bufferSize < 1) {
+		Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+			"expected positive buffer size but got \"%s\"",
+			TclGetString(objv[i])));
+		Tcl_SetErrorCode(interp, "TCL", "VALUE", "BUFFERSIZE",
+			(char *)NULL);
+		return TCL_ERROR;
+	    }
+	    break;
+	case STREAM_EXPANDED:
+	    cflags |= TCL_REG_EXPANDED;
+	    break;
+	case STREAM_INDICES:
+	    indices = 1;
+	    break;
+	case STREAM_LINE:
+	    cflags |= TCL_REG_NEWLINE;
+	    break;
+	case STREAM_LINESTOP:
+	    cflags |= TCL_REG_NLSTOP;
+	    break;
+	case STREAM_LINEANCHOR:
+	    cflags |= TCL_REG_NLANCH;
+	    break;
+	case STREAM_NOCASE:
+	    cflags |= TCL_REG_NOCASE;
+	    break;
+	case STREAM_LAST:
+	    i++;
+	    goto endOfForLoop;
+	}
+    }
+
+  endOfForLoop:
+    if (objc - i != 3) {
+	Tcl_WrongNumArgs(interp, 1, objv,
+		"?-option ...? exp channelId cmdPrefix");
+	return TCL_ERROR;
+    }
+    if (TclGetChannelFromObj(interp, objv[i+1], &chan, &mode, 0) != TCL_OK) {
+	return TCL_ERROR;
+    }
+    if (!(mode & TCL_READABLE)) {
+	Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		"channel \"%s\" wasn't opened for reading",
+		TclGetString(objv[i+1])));
+	Tcl_SetErrorCode(interp, "TCL", "OPERATION", "REGEXPSTREAM",
+		"NOT_READABLE", (char *)NULL);
+	return TCL_ERROR;
+    }
+    if (TclListObjLength(interp, objv[i+2], &numParts) != TCL_OK) {
+	return TCL_ERROR;
+    }
+    if (numParts < 1) {
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		"command prefix must be a list of at least one element", -1));
+	Tcl_SetErrorCode(interp, "TCL", "OPERATION", "REGEXPSTREAM",
+		"CMDEMPTY", (char *)NULL);
+	return TCL_ERROR;
+    }
+
+    /*
+     * The command may shimmer the pattern object, which would free the
+     * compiled regexp under our feet; work on a private copy instead.
+     */
+
+    patternPtr = Tcl_DuplicateObj(objv[i]);
+    Tcl_IncrRefCount(patternPtr);
+    regExpr = Tcl_GetRegExpFromObj(interp, patternPtr, cflags);
+    if (regExpr == NULL) {
+	Tcl_DecrRefCount(patternPtr);
+	return TCL_ERROR;
+    }
+
+    /*
+     * Keep the channel open even if the command closes it.
+     */
+
+    Tcl_RegisterChannel(NULL, chan);
+    TclNewObj(bufPtr);
+    Tcl_IncrRefCount(bufPtr);
+
+    /*
+     * The buffer holds the text from one character before the point where
+     * the next match could start (that character is only context for \m,
+     * \y and the like); base is the index of the buffer's first character in
+     * the stream, offset the buffer index where the next search starts.
+     * afterMatch records whether offset was set by a match, in which case,
+     * as with "regexp -all", no empty match is looked for at the very end.
+     */
+
+    base = 0;
+    offset = 0;
+    count = 0;
+    eof = 0;
+    afterMatch = 0;
+    while (1) {
+	if (!eof) {
+	    TclNewObj(chunkPtr);
+	    Tcl_IncrRefCount(chunkPtr);
+	    if (Tcl_ReadChars(chan, chunkPtr, bufferSize, 0) < 0) {
+		Tcl_DecrRefCount(chunkPtr);
+		if (!TclChanCaughtErrorBypass(interp, chan)) {
+		    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+			    "error reading \"%s\": %s",
+			    TclGetString(objv[i+1]), Tcl_PosixError(interp)));
+		}
+		result = TCL_ERROR;
+		goto done;
+	    }
+	    if (Tcl_Eof(chan)) {
+		eof = 1;
+	    } else if (Tcl_GetCharLength(chunkPtr) == 0
+		    && Tcl_InputBlocked(chan)) {
+		Tcl_DecrRefCount(chunkPtr);
+		Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+			"channel \"%s\" is in nonblocking mode",
+			TclGetString(objv[i+1])));
+		Tcl_SetErrorCode(interp, "TCL", "OPERATION", "REGEXPSTREAM",
+			"NONBLOCKING", (char *)NULL);
+		result = TCL_ERROR;
+		goto done;
+	    }
+	    if (Tcl_IsShared(bufPtr)) {
+		newPtr = Tcl_DuplicateObj(bufPtr);
+		Tcl_IncrRefCount(newPtr);
+		Tcl_DecrRefCount(bufPtr);
+		bufPtr = newPtr;
+	    }
+	    Tcl_AppendObjToObj(bufPtr, chunkPtr);
+	    Tcl_DecrRefCount(chunkPtr);
+	}
+	length = Tcl_GetCharLength(bufPtr);
+
+	while (offset < length || (offset == length && eof && !afterMatch)) {
+	    /*
+	     * Before the end of the channel, the end of the buffer is not the
+	     * end of the text.
+	     */
+
+	    eflags = eof ? 0 : TCL_REG_NOTEOL;
+	    match = TclRegExpExecFromObj(interp, regExpr, bufPtr, offset,
+		    TCL_INDEX_NONE, eflags);
+	    if (match < 0) {
+		result = TCL_ERROR;
+		goto done;
+	    }
+	    Tcl_RegExpGetInfo(regExpr, &info);
+	    if (match == 0 && eof) {
+		goto done;
+	    }
+
+	    /*
+	     * No match can start before cold, the point where the matcher
+	     * would have to see more text to tell. A match that starts at or
+	     * after it might still grow, or lose to one starting earlier, once
+	     * more text has been read; so might one that reaches the end of
+	     * the buffer, where a constraint such as \M or $ was only checked
+	     * against the end of the text read so far.
+	     */
+
+	    cold = info.extendStart;
+	    if (cold < offset) {
+		cold = offset;
+	    }
+	    if (match && !eof && (cold <= info.matches[0].start
+		    || info.matches[0].end == length)) {
+		if (cold > info.matches[0].start) {
+		    cold = info.matches[0].start;
+		}
+		match = 0;
+	    }
+	    if (match == 0) {
+		if (cold > offset) {
+		    offset = cold;
+		    afterMatch = 0;
+		}
+		break;
+	    }
+
+	    TclNewObj(matchPtr);
+	    for (j = 0; j <= (int) info.nsubs; j++) {
+		start = info.matches[j].start;
+		end = info.matches[j].end;
+		if (indices) {
+		    Tcl_Obj *objs[2];
+
+		    if (start >= 0) {
+			TclNewIndexObj(objs[0], base + start);
+			TclNewIndexObj(objs[1], base + end - 1);
+		    } else {
+			TclNewIndexObj(objs[0], TCL_INDEX_NONE);
+			TclNewIndexObj(objs[1], TCL_INDEX_NONE);
+		    }
+		    newPtr = Tcl_NewListObj(2, objs);
+		} else if (start >= 0 && end > start) {
+		    newPtr = Tcl_GetRange(bufPtr, start, end - 1);
+		} else {
+		    TclNewObj(newPtr);
+		}
+		Tcl_ListObjAppendElement(NULL, matchPtr, newPtr);
+	    }
+	    count++;
+	    start = info.matches[0].start;
+	    offset = info.matches[0].end;
+	    if (offset == start) {
+		offset++;
+	    }
+	    afterMatch = 1;
+
+	    cmdPtr = Tcl_DuplicateObj(objv[i+2]);
+	    Tcl_IncrRefCount(cmdPtr);
+	    Tcl_ListObjAppendElement(NULL, cmdPtr, matchPtr);
+	    result = Tcl_EvalObjEx(interp, cmdPtr, 0);
+	    Tcl_DecrRefCount(cmdPtr);
+	    if (result == TCL_BREAK) {
+		result = TCL_OK;
+		goto done;
+	    } else if (result == TCL_ERROR) {
+		Tcl_AppendObjToErrorInfo(interp, Tcl_NewStringObj(
+			"\n    (regexpstream command prefix)", -1));
+		goto done;
+	    } else if (result != TCL_OK && result != TCL_CONTINUE) {
+		goto done;
+	    }
+	    result = TCL_OK;
+	}
+	if (eof) {
+	    break;
+	}
+
+	/*
+	 * Drop the text that no match can start in any more, keeping one
+	 * character of context. Only do so once that is at least half the
+	 * buffer, so that a long partial match is not copied on every read.
+	 */
+
+	start = ((offset < length) ? offset : length) - 1;
+	if (start > 0 && start >= length - start) {
+	    newPtr = Tcl_GetRange(bufPtr, start, length - 1);
+	    Tcl_IncrRefCount(newPtr);
+	    Tcl_DecrRefCount(bufPtr);
+	    bufPtr = newPtr;
+	    base += start;
+	    offset -= start;
+	}
+    }
+
+  done:
+    Tcl_DecrRefCount(bufPtr);
+    Tcl_DecrRefCount(patternPtr);
+    if (Tcl_UnregisterChannel(NULL, chan) != TCL_OK && result == TCL_OK) {
+	result = TCL_ERROR;
+    }
+    if (result == TCL_OK) {
+	Tcl_SetObjResult(interp, Tcl_NewWideIntObj(count));
+    }
+    return result;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -1180,7 +1596,7 @@ Tcl_SplitObjCmd(
     int ch = 0;
     int len;
     const char *splitChars;
-    const char *stringPtr;
+    const char *start, *stringPtr;
     const char *end;
     Tcl_Size splitCharLen, stringLen;
     Tcl_Obj *listPtr, *objPtr;
@@ -1195,10 +1611,16 @@ Tcl_SplitObjCmd(
 	return TCL_ERROR;
     }
 
-    stringPtr = TclGetStringFromObj(objv[1], &stringLen);
+    start = TclGetStringFromObj(objv[1], &stringLen);
+    stringPtr = start;
     end = stringPtr + stringLen;
     TclNewObj(listPtr);
 
+    /*
+     * Fields are made with TclNewSubstringObj so that long ones share the
+     * bytes of objv[1] instead of copying them.
+     */
+
     if (stringLen == 0) {
 	/*
 	 * Do nothing.
@@ -1247,11 +1669,13 @@ Tcl_SplitObjCmd(
 	 */
 
 	while (*stringPtr && (p=strchr(stringPtr,*splitChars)) != NULL) {
-	    objPtr = Tcl_NewStringObj(stringPtr, p - stringPtr);
+	    objPtr = TclNewSubstringObj(objv[1], stringPtr - start,
+		    p - stringPtr, TCL_INDEX_NONE);
 	    Tcl_ListObjAppendElement(NULL, listPtr, objPtr);
 	    stringPtr = p + 1;
 	}
-	TclNewStringObj(objPtr, stringPtr, end - stringPtr);
+	objPtr = TclNewSubstringObj(objv[1], stringPtr - start,
+		end - stringPtr, TCL_INDEX_NONE);
 	Tcl_ListObjAppendElement(NULL, listPtr, objPtr);
     } else {
 	const char *element, *p, *splitEnd;
@@ -1270,7 +1694,8 @@ Tcl_SplitObjCmd(
 	    for (p = splitChars; p < splitEnd; p += splitLen) {
 		splitLen = TclUtfToUniChar(p, &splitChar);
 		if (ch == splitChar) {
-		    TclNewStringObj(objPtr, element, stringPtr - element);
+		    objPtr = TclNewSubstringObj(objv[1], element - start,
+			    stringPtr - element, TCL_INDEX_NONE);
 		    Tcl_ListObjAppendElement(NULL, listPtr, objPtr);
 		    element = stringPtr + len;
 		    break;
@@ -1278,7 +1703,8 @@ Tcl_SplitObjCmd(
 	    }
 	}
 
-	TclNewStringObj(objPtr, element, stringPtr - element);
+	objPtr = TclNewSubstringObj(objv[1], element - start,
+		stringPtr - element, TCL_INDEX_NONE);
 	Tcl_ListObjAppendElement(NULL, listPtr, objPtr);
     }
     Tcl_SetObjResult(interp, listPtr);
@@ -1524,6 +1950,7 @@ StringIsCmd(
 {
     const char *string1, *end, *stop;
     int (*chcomp)(int) = NULL;	/* The UniChar comparison function. */
+    int cls = 0;		/* Its InstStringClassType. */
     int i, result = 1, strict = 0;
     Tcl_Size failat = 0, length1, length2, length3;
     Tcl_Obj *objPtr, *failVarObj = NULL;
@@ -1600,12 +2027,15 @@ StringIsCmd(
     switch (index) {
     case STR_IS_ALNUM:
 	chcomp = Tcl_UniCharIsAlnum;
+	cls = STR_CLASS_ALNUM;
 	break;
     case STR_IS_ALPHA:
 	chcomp = Tcl_UniCharIsAlpha;
+	cls = STR_CLASS_ALPHA;
 	break;
     case STR_IS_ASCII:
 	chcomp = UniCharIsAscii;
+	cls = STR_CLASS_ASCII;
 	break;
     case STR_IS_BOOL:
     case STR_IS_TRUE:
@@ -1625,6 +2055,7 @@ StringIsCmd(
 	break;
     case STR_IS_CONTROL:
 	chcomp = Tcl_UniCharIsControl;
+	cls = STR_CLASS_CONTROL;
 	break;
     case STR_IS_DICT: {
 	int dresult;
@@ -1677,6 +2108,7 @@ StringIsCmd(
     }
     case STR_IS_DIGIT:
 	chcomp = Tcl_UniCharIsDigit;
+	cls = STR_CLASS_DIGIT;
 	break;
     case STR_IS_DOUBLE: {
 	if (TclHasInternalRep(objPtr, &tclDoubleType) ||
@@ -1707,6 +2139,7 @@ StringIsCmd(
     }
     case STR_IS_GRAPH:
 	chcomp = Tcl_UniCharIsGraph;
+	cls = STR_CLASS_GRAPH;
 	break;
     case STR_IS_INT:
     case STR_IS_ENTIER:
@@ -1858,24 +2291,31 @@ StringIsCmd(
 	break;
     case STR_IS_LOWER:
 	chcomp = Tcl_UniCharIsLower;
+	cls = STR_CLASS_LOWER;
 	break;
     case STR_IS_PRINT:
 	chcomp = Tcl_UniCharIsPrint;
+	cls = STR_CLASS_PRINT;
 	break;
     case STR_IS_PUNCT:
 	chcomp = Tcl_UniCharIsPunct;
+	cls = STR_CLASS_PUNCT;
 	break;
     case STR_IS_SPACE:
 	chcomp = Tcl_UniCharIsSpace;
+	cls = STR_CLASS_SPACE;
 	break;
     case STR_IS_UPPER:
 	chcomp = Tcl_UniCharIsUpper;
+	cls = STR_CLASS_UPPER;
 	break;
     case STR_IS_WORD:
 	chcomp = Tcl_UniCharIsWordChar;
+	cls = STR_CLASS_WORD;
 	break;
     case STR_IS_XDIGIT:
 	chcomp = UniCharIsHexDigit;
+	cls = STR_CLASS_XDIGIT;
 	break;
     }
 
@@ -1891,6 +2331,17 @@ StringIsCmd(
 	for (; string1 < end; string1 += length2, failat++) {
 	    int ucs4;
 
+	    /*
+	     * Runs of ASCII are classified by table; only the characters
+	     * after them are decoded and passed to chcomp.
+	     */
+
+	    length2 = TclUtfClassRun(string1, end - string1, cls);
+	    string1 += length2;
+	    failat += length2;
+	    if (string1 >= end) {
+		break;
+	    }
 	    length2 = TclUtfToUniChar(string1, &ucs4);
 	    if (!chcomp(ucs4)) {
 		result = 0;
@@ -1929,6 +2380,428 @@ UniCharIsHexDigit(
     return (character >= 0) && (character < 0x80) && isxdigit(UCHAR(character));
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * GetMapAutomaton --
+ *
+ *	Returns the Aho-Corasick automaton matching the keys of a "string map"
+ *	charMap, taking it from the per-thread cache or building (and caching)
+ *	it.
+ *
+ * Results:
+ *	The automaton. It stays valid until the next call.
+ *
+ * Side effects:
+ *	May evict and free the least recently used cached automaton.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static MapAutomaton *
+GetMapAutomaton(
+    Tcl_Obj *mapObj,		/* The charMap value. */
+    Tcl_Size mapElemc,		/* Number of keys plus values. */
+    Tcl_Obj *const mapElemv[],	/* Alternating keys and values. */
+    int nocase)			/* Match keys case-insensitively? */
+{
+    ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
+    MapAutomaton *amPtr;
+    MapNode *nodes;
+    MapEdge *edges;
+    Tcl_Size *nextEdge, *queue, numNodes, maxNodes, numEdges, i, j, k;
+    Tcl_Size head, tail, length, valueTotal;
+    Tcl_UniChar *key, *value;
+
+    if (!tsdPtr->initialized) {
+	tsdPtr->initialized = 1;
+	Tcl_CreateThreadExitHandler(FinalizeMapAutomata, NULL);
+    }
+
+    for (i = 0; i < NUM_MAP_AUTOMATA; i++) {
+	amPtr = tsdPtr->automata[i];
+	if (amPtr == NULL) {
+	    break;
+	}
+	if (amPtr->mapObj == mapObj && amPtr->nocase == nocase) {
+	    for (j = i; j > 0; j--) {
+		tsdPtr->automata[j] = tsdPtr->automata[j - 1];
+	    }
+	    tsdPtr->automata[0] = amPtr;
+	    return amPtr;
+	}
+    }
+
+    /*
+     * Build the trie of keys. While building, the edges of each node form a
+     * linked list through nextEdge, headed by the node's firstEdge.
+     */
+
+    maxNodes = 1;
+    valueTotal = 0;
+    for (i = 0; i < mapElemc; i += 2) {
+	Tcl_GetUnicodeFromObj(mapElemv[i], &length);
+	maxNodes += length;
+	Tcl_GetUnicodeFromObj(mapElemv[i + 1], &length);
+	valueTotal += length;
+    }
+    nodes = (MapNode *)Tcl_Alloc(maxNodes * sizeof(MapNode));
+    edges = (MapEdge *)Tcl_Alloc(maxNodes * sizeof(MapEdge));
+    nextEdge = (Tcl_Size *)Tcl_Alloc(maxNodes * sizeof(Tcl_Size));
+    nodes[0].firstEdge = -1;
+    nodes[0].numEdges = 0;
+    nodes[0].depth = 0;
+    nodes[0].key = -1;
+    numNodes = 1;
+    numEdges = 0;
+    for (i = 0; i < mapElemc; i += 2) {
+	Tcl_Size node = 0;
+
+	key = Tcl_GetUnicodeFromObj(mapElemv[i], &length);
+	if (length == 0) {
+	    continue;			/* Empty keys never match. */
+	}
+	for (j = 0; j < length; j++) {
+	    Tcl_UniChar ch = nocase ? Tcl_UniCharToLower(key[j]) : key[j];
+
+	    for (k = nodes[node].firstEdge; k >= 0; k = nextEdge[k]) {
+		if (edges[k].ch == ch) {
+		    break;
+		}
+	    }
+	    if (k < 0) {
+		k = numEdges++;
+		edges[k].ch = ch;
+		edges[k].target = numNodes;
+		nextEdge[k] = nodes[node].firstEdge;
+		nodes[node].firstEdge = k;
+		nodes[node].numEdges++;
+		nodes[numNodes].firstEdge = -1;
+		nodes[numNodes].numEdges = 0;
+		nodes[numNodes].depth = j + 1;
+		nodes[numNodes].key = -1;
+		numNodes++;
+	    }
+	    node = edges[k].target;
+	}
+	if (nodes[node].key < 0) {
+	    nodes[node].key = i / 2;	/* The first of equal keys wins. */
+	}
+    }
+
+    /*
+     * Lay out the edges of each node consecutively, sorted by character.
+     * Nodes are visited breadth first; that order is also what computing
+     * the fail links needs, so the queue is kept for that.
+     */
+
+    amPtr = (MapAutomaton *)Tcl_Alloc(sizeof(MapAutomaton));
+    amPtr->edges = (MapEdge *)Tcl_Alloc((numEdges ? numEdges : 1)
+	    * sizeof(MapEdge));
+    queue = (Tcl_Size *)Tcl_Alloc(numNodes * sizeof(Tcl_Size));
+    queue[0] = 0;
+    head = 0;
+    tail = 1;
+    numEdges = 0;
+    while (head < tail) {
+	Tcl_Size node = queue[head++], first = numEdges;
+
+	for (k = nodes[node].firstEdge; k >= 0; k = nextEdge[k]) {
+	    MapEdge edge = edges[k];
+
+	    /*
+	     * Insertion sort; nodes rarely have many edges except the root,
+	     * which only gets sorted once.
+	     */
+
+	    for (j = numEdges++; j > first
+		    && amPtr->edges[j - 1].ch > edge.ch; j--) {
+		amPtr->edges[j] = amPtr->edges[j - 1];
+	    }
+	    amPtr->edges[j] = edge;
+	}
+	nodes[node].firstEdge = first;
+	for (j = first; j < numEdges; j++) {
+	    queue[tail++] = amPtr->edges[j].target;
+	}
+    }
+    Tcl_Free(nextEdge);
+    Tcl_Free(edges);
+    amPtr->nodes = nodes;
+
+    /*
+     * Compute the fail and output links in breadth first order, so the
+     * links of all shallower nodes are known.
+     */
+
+    memset(amPtr->rootAscii, 0, sizeof(amPtr->rootAscii));
+    nodes[0].fail = 0;
+    nodes[0].output = -1;
+    for (head = 0; head < numNodes; head++) {
+	Tcl_Size node = queue[head];
+
+	for (j = nodes[node].firstEdge;
+		j < nodes[node].firstEdge + nodes[node].numEdges; j++) {
+	    Tcl_Size child = amPtr->edges[j].target, fail = 0;
+	    Tcl_UniChar ch = amPtr->edges[j].ch;
+
+	    if (node == 0) {
+		if (ch >= 0 && ch < 128) {
+		    amPtr->rootAscii[ch] = child;
+		}
+	    } else {
+		Tcl_Size f = nodes[node].fail;
+
+		while ((fail = FindMapEdge(amPtr, f, ch)) < 0 && f != 0) {
+		    f = nodes[f].fail;
+		}
+		if (fail < 0) {
+		    fail = 0;
+		}
+	    }
+	    nodes[child].fail = fail;
+	    nodes[child].output = (nodes[fail].key >= 0) ? fail
+		    : nodes[fail].output;
+	}
+    }
+    Tcl_Free(queue);
+
+    /*
+     * Copy the replacement strings, as the values' own Tcl_UniChar reps may
+     * be shimmered away.
+     */
+
+    amPtr->numValues = mapElemc / 2;
+    amPtr->values = (Tcl_UniChar **)Tcl_Alloc(amPtr->numValues
+	    * sizeof(Tcl_UniChar *) + (valueTotal + 1) * sizeof(Tcl_UniChar));
+    amPtr->valueLens = (Tcl_Size *)Tcl_Alloc(amPtr->numValues
+	    * sizeof(Tcl_Size));
+    key = (Tcl_UniChar *) (amPtr->values + amPtr->numValues);
+    for (i = 0; i < amPtr->numValues; i++) {
+	value = Tcl_GetUnicodeFromObj(mapElemv[2 * i + 1], &length);
+	memcpy(key, value, length * sizeof(Tcl_UniChar));
+	amPtr->values[i] = key;
+	amPtr->valueLens[i] = length;
+	key += length;
+    }
+
+    amPtr->mapObj = mapObj;
+    Tcl_IncrRefCount(mapObj);
+    amPtr->nocase = nocase;
+
+    if (tsdPtr->automata[NUM_MAP_AUTOMATA - 1] != NULL) {
+	FreeMapAutomaton(tsdPtr->automata[NUM_MAP_AUTOMATA - 1]);
+    }
+    for (j = NUM_MAP_AUTOMATA - 1; j > 0; j--) {
+	tsdPtr->automata[j] = tsdPtr->automata[j - 1];
+    }
+    tsdPtr->automata[0] = amPtr;
+    return amPtr;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * FindMapEdge --
+ *
+ *	Looks up the edge of a map automaton node labelled with a character.
+ *
+ * Results:
+ *	The node the edge leads to, or -1 if there is no such edge.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static inline Tcl_Size
+FindMapEdge(
+    const MapAutomaton *amPtr,
+    Tcl_Size node,
+    Tcl_UniChar ch)
+{
+    const MapEdge *lo = amPtr->edges + amPtr->nodes[node].firstEdge;
+    const MapEdge *hi = lo + amPtr->nodes[node].numEdges;
+
+    while (lo < hi) {
+	const MapEdge *mid = lo + (hi - lo) / 2;
+
+	if (mid->ch < ch) {
+	    lo = mid + 1;
+	} else if (mid->ch > ch) {
+	    hi = mid;
+	} else {
+	    return mid->target;
+	}
+    }
+    return -1;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * MapWithAutomaton --
+ *
+ *	Performs a "string map" of a string in a single pass with an
+ *	Aho-Corasick automaton. The result is the same as with the direct
+ *	scan in StringMapCmd: at the leftmost position where any key matches,
+ *	the first such key in the map is replaced, and scanning continues
+ *	after it.
+ *
+ *	The automaton reports matches by their end position, so a match is
+ *	held back until no match starting at or before it can still turn up,
+ *	that is, until it starts before the longest key prefix ending at the
+ *	current position.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Appends the mapped string to resultPtr.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+MapWithAutomaton(
+    MapAutomaton *amPtr,	/* Automaton of the map. */
+    const Tcl_UniChar *ustring,	/* String to map. */
+    Tcl_Size length,		/* Length of ustring. */
+    Tcl_Obj *resultPtr)		/* Where to append the mapped string. */
+{
+    MapNode *nodes = amPtr->nodes;
+    Tcl_Size state = 0, copied = 0, pos = 0;
+    Tcl_Size bestStart = -1, bestNode = -1, node;
+
+    for (;;) {
+	if (pos < length) {
+	    Tcl_UniChar ch = ustring[pos];
+
+	    if (amPtr->nocase) {
+		ch = Tcl_UniCharToLower(ch);
+	    }
+
+	    /*
+	     * Follow the goto function, falling back along the fail links.
+	     */
+
+	    while (state != 0) {
+		node = FindMapEdge(amPtr, state, ch);
+		if (node >= 0) {
+		    break;
+		}
+		state = nodes[state].fail;
+	    }
+	    if (state != 0) {
+		state = node;
+	    } else if (ch >= 0 && ch < 128) {
+		state = amPtr->rootAscii[ch];
+	    } else if ((state = FindMapEdge(amPtr, 0, ch)) < 0) {
+		state = 0;
+	    }
+	    pos++;
+
+	    /*
+	     * Note every key ending here; keep the leftmost, and of those the
+	     * first in the map.
+	     */
+
+	    node = (nodes[state].key >= 0) ? state : nodes[state].output;
+	    for (; node >= 0; node = nodes[node].output) {
+		Tcl_Size start = pos - nodes[node].depth;
+
+		if (bestStart < 0 || start < bestStart || (start == bestStart
+			&& nodes[node].key < nodes[bestNode].key)) {
+		    bestStart = start;
+		    bestNode = node;
+		}
+	    }
+	    if (bestStart < 0 || bestStart >= pos - nodes[state].depth) {
+		continue;
+	    }
+	} else if (bestStart < 0) {
+	    break;
+	}
+
+	/*
+	 * Replace the match, then restart the automaton right after it.
+	 */
+
+	if (copied < bestStart) {
+	    Tcl_AppendUnicodeToObj(resultPtr, ustring + copied,
+		    bestStart - copied);
+	}
+	Tcl_AppendUnicodeToObj(resultPtr, amPtr->values[nodes[bestNode].key],
+		amPtr->valueLens[nodes[bestNode].key]);
+	pos = copied = bestStart + nodes[bestNode].depth;
+	state = 0;
+	bestStart = -1;
+    }
+    if (copied < length) {
+	Tcl_AppendUnicodeToObj(resultPtr, ustring + copied, length - copied);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * FreeMapAutomaton --
+ *
+ *	Releases an automaton built by GetMapAutomaton.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Frees memory and releases the map value.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+FreeMapAutomaton(
+    MapAutomaton *amPtr)
+{
+    Tcl_DecrRefCount(amPtr->mapObj);
+    Tcl_Free(amPtr->nodes);
+    Tcl_Free(amPtr->edges);
+    Tcl_Free(amPtr->values);
+    Tcl_Free(amPtr->valueLens);
+    Tcl_Free(amPtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * FinalizeMapAutomata --
+ *
+ *	Frees the per-thread cache of "string map" automata when the thread
+ *	exits.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Frees memory.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+FinalizeMapAutomata(
+    TCL_UNUSED(void *))
+{
+    ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
+    int i;
+
+    for (i = 0; i < NUM_MAP_AUTOMATA && tsdPtr->automata[i] != NULL; i++) {
+	FreeMapAutomaton(tsdPtr->automata[i]);
+	tsdPtr->automata[i] = NULL;
+    }
+    tsdPtr->initialized = 0;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -2117,6 +2990,10 @@ StringMapCmd(
 		}
 	    }
 	}
+    } else if (mapElemc >= 2 * MAP_AUTOMATON_PAIRS) {
+	MapWithAutomaton(GetMapAutomaton(objv[objc-2], mapElemc, mapElemv,
+		nocase), ustring1, length1, resultPtr);
+	ustring1 = p = end;
     } else {
 	Tcl_UniChar **mapStrings;
 	Tcl_Size *mapLens;
@@ -2301,7 +3178,7 @@ StringRangeCmd(
     }
 
     if (last >= 0) {
-	Tcl_SetObjResult(interp, Tcl_GetRange(objv[1], first, last));
+	Tcl_SetObjResult(interp, TclGetSharedRange(objv[1], first, last));
     }
     return TCL_OK;
 }
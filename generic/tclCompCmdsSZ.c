@@ -1421,6 +1421,113 @@ StringClassDesc const tclStringClassTable[] = {
     {"xdigit",	UniCharIsHexDigit},
     {"",	NULL}
 };
+
+/*
+ * The classes of the ASCII characters, one bit per InstStringClassType, as
+ * the comparators above report them. Runs of ASCII are classified with this
+ * table instead of being passed to the comparators one character at a time.
+ * Unicode counts $+<=>^`|~ as symbols, so they are not in "punct".
+ */
+
+static const unsigned short asciiClasses[128] = {
+    0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C,
+    0x000C, 0x020C, 0x020C, 0x020C, 0x020C, 0x020C, 0x000C, 0x000C,
+    0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C,
+    0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C, 0x000C,
+    0x0284, 0x01A4, 0x01A4, 0x01A4, 0x00A4, 0x01A4, 0x01A4, 0x01A4,
+    0x01A4, 0x01A4, 0x01A4, 0x00A4, 0x01A4, 0x01A4, 0x01A4, 0x01A4,
+    0x18B5, 0x18B5, 0x18B5, 0x18B5, 0x18B5, 0x18B5, 0x18B5, 0x18B5,
+    0x18B5, 0x18B5, 0x01A4, 0x01A4, 0x00A4, 0x00A4, 0x00A4, 0x01A4,
+    0x01A4, 0x1CA7, 0x1CA7, 0x1CA7, 0x1CA7, 0x1CA7, 0x1CA7, 0x0CA7,
+    0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7,
+    0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7, 0x0CA7,
+    0x0CA7, 0x0CA7, 0x0CA7, 0x01A4, 0x01A4, 0x01A4, 0x00A4, 0x09A4,
+    0x00A4, 0x18E7, 0x18E7, 0x18E7, 0x18E7, 0x18E7, 0x18E7, 0x08E7,
+    0x08E7, 0x08E7, 0x08E7, 0x08E7, 0x08E7, 0x08E7, 0x08E7, 0x08E7,
+    0x08E7, 0x08E7, 0x08E7, 0x08E7, 0x08E7, 0x08E7, 0x08E7, 0x08E7,
+    0x08E7, 0x08E7, 0x08E7, 0x01A4, 0x00A4, 0x01A4, 0x00A4, 0x000C
+};
+
+#define HIGH_BITS	((uint64_t) 0x8080808080808080ULL)
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclUtfClassRun --
+ *
+ *	Measures the run of ASCII characters in a character class at the start
+ *	of a UTF-8 string. Eight bytes at a time are checked for being ASCII
+ *	and looked up together.
+ *
+ * Results:
+ *	The length of the run in bytes. The character after it, if any, is
+ *	either not ASCII or not in the class.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+Tcl_Size
+TclUtfClassRun(
+    const char *src,		/* The UTF-8 string to examine. */
+    Tcl_Size length,		/* Number of bytes at src. */
+    int cls)			/* The class, an InstStringClassType. */
+{
+    const unsigned char *p = (const unsigned char *) src;
+    const unsigned char *endPtr = p + length;
+    unsigned bit = 1U << cls;
+    uint64_t word;
+
+    while (endPtr - p >= (Tcl_Size) sizeof(word)) {
+	memcpy(&word, p, sizeof(word));
+	if ((word & HIGH_BITS) || !(bit & asciiClasses[p[0]]
+		& asciiClasses[p[1]] & asciiClasses[p[2]] & asciiClasses[p[3]]
+		& asciiClasses[p[4]] & asciiClasses[p[5]] & asciiClasses[p[6]]
+		& asciiClasses[p[7]])) {
+	    break;
+	}
+	p += sizeof(word);
+    }
+    while (p < endPtr && *p < 0x80 && (asciiClasses[*p] & bit)) {
+	p++;
+    }
+    return (const char *) p - src;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclUniCharClassRun --
+ *
+ *	Measures the run of ASCII characters in a character class at the start
+ *	of a Tcl_UniChar string.
+ *
+ * Results:
+ *	The length of the run. The character after it, if any, is either not
+ *	ASCII or not in the class.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+Tcl_Size
+TclUniCharClassRun(
+    const Tcl_UniChar *src,	/* The string to examine. */
+    Tcl_Size length,		/* Number of Tcl_UniChars at src. */
+    int cls)			/* The class, an InstStringClassType. */
+{
+    const Tcl_UniChar *p = src, *endPtr = src + length;
+    unsigned bit = 1U << cls;
+
+    while (p < endPtr && (unsigned) *p < 0x80 && (asciiClasses[*p] & bit)) {
+	p++;
+    }
+    return p - src;
+}
 
 /*
  *----------------------------------------------------------------------
@@ -929,6 +929,10 @@ typedef struct StringClassDesc {
 } StringClassDesc;
 
 MODULE_SCOPE StringClassDesc const tclStringClassTable[];
+MODULE_SCOPE Tcl_Size	TclUniCharClassRun(const Tcl_UniChar *src,
+			    Tcl_Size length, int cls);
+MODULE_SCOPE Tcl_Size	TclUtfClassRun(const char *src, Tcl_Size length,
+			    int cls);
 
 /*
  * Compilation of some Tcl constructs such as if commands and the logical or
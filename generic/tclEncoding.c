@@ -83,8 +83,31 @@ typedef struct {
 				 * is no corresponding character the encoding,
 				 * the value in the matrix is 0x0000.
 				 * malloc'd. */
+    int asciiIdentity;		/* Nonzero if bytes 0x01-0x7F are single-byte
+				 * chars that map to and from the same code
+				 * points, so runs of them can be copied
+				 * unchanged. */
 } TableEncodingData;
 
+/*
+ * The following structure describes a single-byte table encoding that is
+ * compiled into the library, so that it can be created without reading and
+ * parsing its .enc file. The table of these is generated from the files in
+ * library/encoding by tools/encodingTables.tcl.
+ */
+
+typedef struct {
+    const char *name;		/* Name of the encoding. */
+    unsigned short fallback;	/* Character to substitute when a UTF-8
+				 * character cannot be represented. */
+    unsigned char symbol;	/* Nonzero for a symbol encoding. */
+    unsigned short toUnicode[256];
+				/* Unicode code point for each byte, or 0x0000
+				 * if the byte has no mapping. */
+} CompiledEncoding;
+
+#include "tclEncodingTables.c"
+
 /*
  * Each of the following structures is the clientData for a dynamically-loaded
  * escape-driven encoding that is itself comprised of other simpler encodings.
@@ -216,6 +239,16 @@ static const struct TclEncodingProfiles {
 #define HIGH_SURROGATE(c_)	(((c_) & ~0x3FF) == 0xD800)
 #define LOW_SURROGATE(c_)	(((c_) & ~0x3FF) == 0xDC00)
 
+/*
+ * Masks used by AsciiRunLength to examine eight bytes at a time. A word
+ * holds only bytes 0x01-0x7F when ((word | (word - LOW_BITS)) & HIGH_BITS)
+ * is zero: the first term catches bytes with the top bit set, the second
+ * catches zero bytes.
+ */
+
+#define LOW_BITS	((uint64_t) 0x0101010101010101ULL)
+#define HIGH_BITS	((uint64_t) 0x8080808080808080ULL)
+
 /*
  * The following variable is used in the sparse matrix code for a
  * TableEncoding to represent a page in the table that has no entries.
@@ -227,6 +260,8 @@ static unsigned short emptyPage[256];
  * Functions used only in this module.
  */
 
+static int			AsciiRunLength(const char *src, int length,
+				    int nulOk);
 static Tcl_EncodingConvertProc	BinaryProc;
 static Tcl_DupInternalRepProc	DupEncodingInternalRep;
 static Tcl_EncodingFreeProc	EscapeFreeProc;
@@ -235,8 +270,16 @@ static Tcl_EncodingConvertProc	EscapeToUtfProc;
 static void			FillEncodingFileMap(void);
 static void			FreeEncoding(Tcl_Encoding encoding);
 static Tcl_FreeInternalRepProc	FreeEncodingInternalRep;
+static Tcl_Encoding		CreateTableEncoding(const char *name, int type,
+				    TableEncodingData *dataPtr);
 static Encoding *		GetTableEncoding(EscapeEncodingData *dataPtr,
 				    int state);
+static void			InvertTableEncoding(TableEncodingData *dataPtr,
+				    int type, int symbol);
+static const CompiledEncoding *	FindCompiledEncoding(const char *name);
+static int			IsLibraryEncodingDir(Tcl_Obj *dirPtr);
+static Tcl_Encoding		LoadCompiledEncoding(
+				    const CompiledEncoding *tablePtr);
 static Tcl_Encoding		LoadEncodingFile(Tcl_Interp *interp,
 				    const char *name);
 static Tcl_Encoding		LoadTableEncoding(const char *name, int type,
@@ -244,7 +287,7 @@ static Tcl_Encoding		LoadTableEncoding(const char *name, int type,
 static Tcl_Encoding		LoadEscapeEncoding(const char *name,
 				    Tcl_Channel chan);
 static Tcl_Channel		OpenEncodingFileChannel(Tcl_Interp *interp,
-				    const char *name);
+				    const char *name, int skipLibrary);
 static Tcl_EncodingFreeProc	TableFreeProc;
 static Tcl_EncodingConvertProc	TableFromUtfProc;
 static Tcl_EncodingConvertProc	TableToUtfProc;
@@ -644,6 +687,7 @@ TclInitEncodingSubsystem(void)
 	dataPtr->toUnicode[0][i] = i;
 	dataPtr->fromUnicode[0][i] = i;
     }
+    dataPtr->asciiIdentity = 1;
 
     type.encodingName	= "iso8859-1";
     type.toUtfProc	= Iso88591ToUtfProc;
@@ -857,8 +901,8 @@ Tcl_GetEncodingName(
  *
  * Tcl_GetEncodingNames --
  *
- *	Get the list of all known encodings, including the ones stored as
- *	files on disk in the encoding path.
+ *	Get the list of all known encodings, including the ones compiled into
+ *	the library and the ones stored as files on disk in the encoding path.
  *
  * Results:
  *	Modifies interp's result object to hold a list of all the available
@@ -880,6 +924,7 @@ Tcl_GetEncodingNames(
     Tcl_Obj *map, *name, *result;
     Tcl_DictSearch mapSearch;
     int dummy, done = 0;
+    size_t i;
 
     TclNewObj(result);
     Tcl_InitObjHashTable(&table);
@@ -898,6 +943,13 @@ Tcl_GetEncodingNames(
     }
     Tcl_MutexUnlock(&encodingMutex);
 
+    for (i = 0; i < sizeof(compiledEncodings)/sizeof(compiledEncodings[0]);
+	    i++) {
+	Tcl_CreateHashEntry(&table,
+		Tcl_NewStringObj(compiledEncodings[i].name, TCL_INDEX_NONE),
+		&dummy);
+    }
+
     FillEncodingFileMap();
     map = TclGetProcessGlobalValue(&encodingFileMap);
 
@@ -1725,7 +1777,9 @@ Tcl_FindExecutable(
  *
  * OpenEncodingFileChannel --
  *
- *	Open the file believed to hold data for the encoding, "name".
+ *	Open the file believed to hold data for the encoding, "name". If
+ *	skipLibrary is set, the library's own encoding directories are not
+ *	searched (see IsLibraryEncodingDir).
  *
  * Results:
  *	Returns the readable Tcl_Channel from opening the file, or NULL if the
@@ -1742,8 +1796,10 @@ Tcl_FindExecutable(
 static Tcl_Channel
 OpenEncodingFileChannel(
     Tcl_Interp *interp,		/* Interp for error reporting, if not NULL. */
-    const char *name)		/* The name of the encoding file on disk and
+    const char *name,		/* The name of the encoding file on disk and
 				 * also the name for new encoding. */
+    int skipLibrary)		/* Whether to leave out the library's own
+				 * encoding directories. */
 {
     Tcl_Obj *fileNameObj = Tcl_ObjPrintf("%s.enc", name);
     Tcl_Obj *searchPath = Tcl_DuplicateObj(Tcl_GetEncodingSearchPath());
@@ -1789,6 +1845,11 @@ OpenEncodingFileChannel(
 	}
     }
 
+    if ((NULL != directory) && skipLibrary
+	    && IsLibraryEncodingDir(directory)) {
+	directory = NULL;
+    }
+
     if (NULL != directory) {
 	/*
 	 * Got a directory from the cache. Try to use it first.
@@ -1807,6 +1868,9 @@ OpenEncodingFileChannel(
      */
 
     for (i=0; i<numDirs && (chan == NULL); i++) {
+	if (skipLibrary && IsLibraryEncodingDir(dir[i])) {
+	    continue;
+	}
 	path = Tcl_FSJoinToPath(dir[i], 1, &fileNameObj);
 	Tcl_IncrRefCount(path);
 	chan = Tcl_FSOpenFileChannel(NULL, path, "r", 0);
@@ -1833,6 +1897,53 @@ OpenEncodingFileChannel(
 
     return chan;
 }
+
+/*
+ *---------------------------------------------------------------------------
+ *
+ * IsLibraryEncodingDir --
+ *
+ *	Tells whether a directory on the encoding search path is the
+ *	"encoding" subdirectory of one of the directories in the library path,
+ *	which is where the default encoding search path comes from.
+ *
+ * Results:
+ *	1 if dirPtr is such a directory, 0 otherwise.
+ *
+ * Side effects:
+ *	Paths may be normalized.
+ *
+ *---------------------------------------------------------------------------
+ */
+
+static int
+IsLibraryEncodingDir(
+    Tcl_Obj *dirPtr)		/* Directory from the encoding search
+				 * path. */
+{
+    Tcl_Obj *libPathObj, *encodingObj, **libDirs;
+    Tcl_Size i, numDirs;
+    int result = 0;
+
+    TclNewLiteralStringObj(encodingObj, "encoding");
+    Tcl_IncrRefCount(encodingObj);
+    libPathObj = TclGetProcessGlobalValue(&libraryPath);
+    Tcl_IncrRefCount(libPathObj);
+    TclListObjGetElements(NULL, libPathObj, &numDirs, &libDirs);
+
+    for (i = 0; i < numDirs && !result; i++) {
+	Tcl_Obj *pathObj = Tcl_FSJoinToPath(libDirs[i], 1, &encodingObj);
+
+	Tcl_IncrRefCount(pathObj);
+	result = Tcl_FSEqualPaths(pathObj, dirPtr);
+	Tcl_DecrRefCount(pathObj);
+    }
+
+    Tcl_DecrRefCount(libPathObj);
+    Tcl_DecrRefCount(encodingObj);
+    return result;
+}
+
 
 /*
  *---------------------------------------------------------------------------
@@ -1842,6 +1953,11 @@ OpenEncodingFileChannel(
  *	Read a file that describes an encoding and create a new Encoding from
  *	the data.
  *
+ *	The single-byte encodings shipped with Tcl are created from the tables
+ *	compiled into the library instead of from the files in the library's
+ *	encoding directory. Only a file of the same name in another directory
+ *	on the encoding search path takes precedence over a compiled table.
+ *
  * Results:
  *	The return value is the newly loaded Tcl_Encoding or NULL if the file
  *	didn't exist or could not be processed. If NULL is returned and interp
@@ -1860,13 +1976,23 @@ LoadEncodingFile(
     const char *name)		/* The name of both the encoding file
 				 * and the new encoding. */
 {
+    const CompiledEncoding *tablePtr = FindCompiledEncoding(name);
     Tcl_Channel chan = NULL;
     Tcl_Encoding encoding = NULL;
     int ch;
 
-    chan = OpenEncodingFileChannel(interp, name);
+    chan = OpenEncodingFileChannel(NULL, name, tablePtr != NULL);
     if (chan == NULL) {
-	return NULL;
+	if (tablePtr != NULL) {
+	    encoding = LoadCompiledEncoding(tablePtr);
+	}
+	if ((encoding == NULL) && (interp != NULL)) {
+	    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		    "unknown encoding \"%s\"", name));
+	    Tcl_SetErrorCode(interp, "TCL", "LOOKUP", "ENCODING", name,
+		    (void *)NULL);
+	}
+	return encoding;
     }
 
     Tcl_SetChannelOption(NULL, chan, "-encoding", "utf-8");
@@ -1941,11 +2067,9 @@ LoadTableEncoding(
     Tcl_Obj *objPtr;
     char *line;
     int i, hi, lo, numPages, symbol, fallback, len;
-    unsigned char used[256];
     unsigned size;
     TableEncodingData *dataPtr;
-    unsigned short *pageMemPtr, *page;
-    Tcl_EncodingType encType;
+    unsigned short *pageMemPtr;
 
     /*
      * Speed over memory. Use a full 256 character table to decode hex
@@ -1988,8 +2112,6 @@ LoadTableEncoding(
 	numPages = 256;
     }
 
-    memset(used, 0, sizeof(used));
-
 #undef PAGESIZE
 #define PAGESIZE    (256 * sizeof(unsigned short))
 
@@ -2029,9 +2151,6 @@ LoadTableEncoding(
 	    }
 	    ch = (staticHex[UCHAR(p[0])] << 12) + (staticHex[UCHAR(p[1])] << 8)
 		    + (staticHex[UCHAR(p[2])] << 4) + staticHex[UCHAR(p[3])];
-	    if (ch != 0) {
-		used[ch >> 8] = 1;
-	    }
 	    *pageMemPtr = (unsigned short) ch;
 	    pageMemPtr++;
 	    p += 4;
@@ -2039,6 +2158,107 @@ LoadTableEncoding(
     }
     TclDecrRefCount(objPtr);
 
+    InvertTableEncoding(dataPtr, type, symbol);
+
+    /*
+     * For trailing 'R'everse encoding, see [Patch 689341]
+     */
+
+    Tcl_DStringInit(&lineString);
+
+    /*
+     * Skip leading empty lines.
+     */
+
+    while ((len = Tcl_Gets(chan, &lineString)) == 0) {
+	/* empty body */
+    }
+    if (len < 0) {
+	goto doneParse;
+    }
+
+    /*
+     * Require that it starts with an 'R'.
+     */
+
+    line = Tcl_DStringValue(&lineString);
+    if (line[0] != 'R') {
+	goto doneParse;
+    }
+
+    /*
+     * Read lines until EOF.
+     */
+
+    for (TclDStringClear(&lineString);
+	    (len = Tcl_Gets(chan, &lineString)) != -1;
+	    TclDStringClear(&lineString)) {
+	const unsigned char *p;
+	int to, from;
+
+	/*
+	 * Skip short lines.
+	 */
+
+	if (len < 5) {
+	    continue;
+	}
+
+	/*
+	 * Parse the line as a sequence of hex digits.
+	 */
+
+	p = (const unsigned char *) Tcl_DStringValue(&lineString);
+	to = (staticHex[p[0]] << 12) + (staticHex[p[1]] << 8)
+		+ (staticHex[p[2]] << 4) + staticHex[p[3]];
+	if (to == 0) {
+	    continue;
+	}
+	for (p += 5, len -= 5; len >= 0 && *p; p += 5, len -= 5) {
+	    from = (staticHex[p[0]] << 12) + (staticHex[p[1]] << 8)
+		    + (staticHex[p[2]] << 4) + staticHex[p[3]];
+	    if (from == 0) {
+		continue;
+	    }
+	    dataPtr->fromUnicode[from >> 8][from & 0xFF] = to;
+	}
+    }
+  doneParse:
+    Tcl_DStringFree(&lineString);
+
+    return CreateTableEncoding(name, type, dataPtr);
+}
+
+/*
+ *-------------------------------------------------------------------------
+ *
+ * InvertTableEncoding --
+ *
+ *	Helper function for LoadTableEncoding() and LoadCompiledEncoding().
+ *	Given the toUnicode array of a table encoding, fills in its prefix
+ *	bytes and builds the fromUnicode array that maps the other way.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Allocates dataPtr->fromUnicode and replaces missing pages in both
+ *	arrays with emptyPage.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static void
+InvertTableEncoding(
+    TableEncodingData *dataPtr,	/* Encoding whose toUnicode array is set. */
+    int type,			/* Type of encoding (ENCODING_?????). */
+    int symbol)			/* Nonzero for a symbol encoding. */
+{
+    int hi, lo, numPages;
+    unsigned char used[256];
+    unsigned size;
+    unsigned short *pageMemPtr, *page;
+
     if (type == ENCODING_DOUBLEBYTE) {
 	memset(dataPtr->prefixBytes, 1, sizeof(dataPtr->prefixBytes));
     } else {
@@ -2052,13 +2272,20 @@ LoadTableEncoding(
     /*
      * Invert the toUnicode array to produce the fromUnicode array. Performs a
      * single malloc to get the memory for the array and all the pages needed
-     * by the array. While reading in the toUnicode array remember what
-     * pages are needed for the fromUnicode array.
+     * by the array. First find out which pages the fromUnicode array needs.
      */
 
-    if (symbol) {
-	used[0] = 1;
+    memset(used, 0, sizeof(used));
+    for (hi = 0; hi < 256; hi++) {
+	if (dataPtr->toUnicode[hi] != NULL) {
+	    for (lo = 0; lo < 256; lo++) {
+		if (dataPtr->toUnicode[hi][lo] != 0) {
+		    used[dataPtr->toUnicode[hi][lo] >> 8] = 1;
+		}
+	    }
+	}
     }
+    used[0] |= symbol;
     numPages = 0;
     for (hi = 0; hi < 256; hi++) {
 	if (used[hi]) {
@@ -2130,72 +2357,42 @@ LoadTableEncoding(
 	    dataPtr->fromUnicode[hi] = emptyPage;
 	}
     }
+}
+
+/*
+ *-------------------------------------------------------------------------
+ *
+ * CreateTableEncoding --
+ *
+ *	Helper function for LoadTableEncoding() and LoadCompiledEncoding().
+ *	Packages a completed TableEncodingData into a new encoding.
+ *
+ * Results:
+ *	Returns the new Tcl_Encoding.
+ *
+ * Side effects:
+ *	See Tcl_CreateEncoding().
+ *
+ *-------------------------------------------------------------------------
+ */
 
-    /*
-     * For trailing 'R'everse encoding, see [Patch 689341]
-     */
-
-    Tcl_DStringInit(&lineString);
-
-    /*
-     * Skip leading empty lines.
-     */
-
-    while ((len = Tcl_Gets(chan, &lineString)) == 0) {
-	/* empty body */
-    }
-    if (len < 0) {
-	goto doneParse;
-    }
-
-    /*
-     * Require that it starts with an 'R'.
-     */
-
-    line = Tcl_DStringValue(&lineString);
-    if (line[0] != 'R') {
-	goto doneParse;
-    }
-
-    /*
-     * Read lines until EOF.
-     */
-
-    for (TclDStringClear(&lineString);
-	    (len = Tcl_Gets(chan, &lineString)) != -1;
-	    TclDStringClear(&lineString)) {
-	const unsigned char *p;
-	int to, from;
-
-	/*
-	 * Skip short lines.
-	 */
-
-	if (len < 5) {
-	    continue;
-	}
-
-	/*
-	 * Parse the line as a sequence of hex digits.
-	 */
+static Tcl_Encoding
+CreateTableEncoding(
+    const char *name,		/* Name of the new encoding. */
+    int type,			/* Type of encoding (ENCODING_?????). */
+    TableEncodingData *dataPtr)	/* Tables of the new encoding. */
+{
+    Tcl_EncodingType encType;
+    int lo;
 
-	p = (const unsigned char *) Tcl_DStringValue(&lineString);
-	to = (staticHex[p[0]] << 12) + (staticHex[p[1]] << 8)
-		+ (staticHex[p[2]] << 4) + staticHex[p[3]];
-	if (to == 0) {
-	    continue;
-	}
-	for (p += 5, len -= 5; len >= 0 && *p; p += 5, len -= 5) {
-	    from = (staticHex[p[0]] << 12) + (staticHex[p[1]] << 8)
-		    + (staticHex[p[2]] << 4) + staticHex[p[3]];
-	    if (from == 0) {
-		continue;
-	    }
-	    dataPtr->fromUnicode[from >> 8][from & 0xFF] = to;
+    dataPtr->asciiIdentity = !dataPtr->prefixBytes[0];
+    for (lo = 1; lo < 0x80; lo++) {
+	if (dataPtr->prefixBytes[lo] || (dataPtr->toUnicode[0][lo] != lo)
+		|| (dataPtr->fromUnicode[0][lo] != lo)) {
+	    dataPtr->asciiIdentity = 0;
+	    break;
 	}
     }
-  doneParse:
-    Tcl_DStringFree(&lineString);
 
     /*
      * Package everything into an encoding structure.
@@ -2211,6 +2408,75 @@ LoadTableEncoding(
     return Tcl_CreateEncoding(&encType);
 }
 
+/*
+ *-------------------------------------------------------------------------
+ *
+ * FindCompiledEncoding --
+ *
+ *	Looks up one of the single-byte table encodings that are compiled into
+ *	the library (see tclEncodingTables.c).
+ *
+ * Results:
+ *	Returns the table for the encoding, or NULL if no encoding called name
+ *	is compiled in.
+ *
+ * Side effects:
+ *	None.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static const CompiledEncoding *
+FindCompiledEncoding(
+    const char *name)		/* Name of the encoding. */
+{
+    size_t i, numTables = sizeof(compiledEncodings)/sizeof(compiledEncodings[0]);
+
+    for (i = 0; i < numTables; i++) {
+	if (strcmp(compiledEncodings[i].name, name) == 0) {
+	    return &compiledEncodings[i];
+	}
+    }
+    return NULL;
+}
+
+/*
+ *-------------------------------------------------------------------------
+ *
+ * LoadCompiledEncoding --
+ *
+ *	Creates one of the single-byte table encodings that are compiled into
+ *	the library. Its byte to Unicode page is used in place, so only the
+ *	reverse mapping is built.
+ *
+ * Results:
+ *	Returns the new Tcl_Encoding.
+ *
+ * Side effects:
+ *	See Tcl_CreateEncoding().
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static Tcl_Encoding
+LoadCompiledEncoding(
+    const CompiledEncoding *tablePtr)
+				/* Table found by FindCompiledEncoding. */
+{
+    TableEncodingData *dataPtr;
+
+    dataPtr = (TableEncodingData *)Tcl_Alloc(sizeof(TableEncodingData));
+    memset(dataPtr, 0, sizeof(TableEncodingData));
+    dataPtr->fallback = tablePtr->fallback;
+    dataPtr->toUnicode = (unsigned short **)
+	    Tcl_Alloc(256 * sizeof(unsigned short *));
+    memset(dataPtr->toUnicode, 0, 256 * sizeof(unsigned short *));
+    dataPtr->toUnicode[0] = (unsigned short *) tablePtr->toUnicode;
+
+    InvertTableEncoding(dataPtr, ENCODING_SINGLEBYTE, tablePtr->symbol);
+    return CreateTableEncoding(tablePtr->name, ENCODING_SINGLEBYTE, dataPtr);
+}
+
 /*
  *-------------------------------------------------------------------------
  *
@@ -2340,6 +2606,47 @@ LoadEscapeEncoding(
     return Tcl_CreateEncoding(&type);
 }
 
+/*
+ *-------------------------------------------------------------------------
+ *
+ * AsciiRunLength --
+ *
+ *	Measure the run of 7-bit chars at the start of a buffer, eight bytes
+ *	at a time. Such chars are encoded the same way in UTF-8 and in every
+ *	encoding whose converters call this, so those converters can copy a
+ *	whole run at once instead of going through their per-char logic.
+ *
+ * Results:
+ *	The number of leading bytes, at most length, in the range 0x01-0x7F,
+ *	or 0x00-0x7F when nulOk is nonzero.
+ *
+ * Side effects:
+ *	None.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static int
+AsciiRunLength(
+    const char *src,		/* Bytes to examine. */
+    int length,			/* Maximum number of bytes to examine. */
+    int nulOk)			/* Whether 0x00 may be part of the run. */
+{
+    int i = 0;
+    uint64_t word;
+
+    for ( ; i + 8 <= length; i += 8) {
+	memcpy(&word, src + i, sizeof(word));
+	if ((nulOk ? word : (word | (word - LOW_BITS))) & HIGH_BITS) {
+	    break;
+	}
+    }
+    while ((i < length) && (UCHAR(src[i]) < 0x80) && (nulOk || src[i])) {
+	i++;
+    }
+    return i;
+}
+
 /*
  *-------------------------------------------------------------------------
  *
@@ -2483,9 +2790,23 @@ UtfToUtfProc(
 		&& !((UCHAR(*src) == 0) && (flags & ENCODING_INPUT))) {
 	    /*
 	     * Copy 7bit characters, but skip null-bytes when we are in input
-	     * mode, so that they get converted to \xC0\x80.
+	     * mode, so that they get converted to \xC0\x80. Whole runs are
+	     * copied at once, within the limits the loop checks per char.
 	     */
-	    *dst++ = *src++;
+
+	    int run = srcEnd - src;
+
+	    if (run > dstEnd - dst + 1) {
+		run = dstEnd - dst + 1;
+	    }
+	    if (run - 1 > charLimit - numChars) {
+		run = charLimit - numChars + 1;
+	    }
+	    run = AsciiRunLength(src, run, !(flags & ENCODING_INPUT));
+	    memcpy(dst, src, run);
+	    src += run;
+	    dst += run;
+	    numChars += run - 1;
 	} else if ((UCHAR(*src) == 0xC0) && (src + 1 < srcEnd) &&
 		 (UCHAR(src[1]) == 0x80) &&
 		 (!(flags & ENCODING_INPUT) || !PROFILE_TCL8(profile))) {
@@ -2652,11 +2973,42 @@ Utf32ToUtfProc(
     dstEnd = dst + dstLen - TCL_UTF_MAX;
 
     for (numChars = 0; src < srcEnd && numChars <= charLimit; numChars++) {
+	int run, limit, lo;
+
 	if (dst > dstEnd) {
 	    result = TCL_CONVERT_NOSPACE;
 	    break;
 	}
 
+	/*
+	 * Copy a run of 7-bit code units straight through.
+	 */
+
+	limit = (srcEnd - src) / 4;
+	if (limit > dstEnd - dst + 1) {
+	    limit = dstEnd - dst + 1;
+	}
+	if (limit - 1 > charLimit - numChars) {
+	    limit = charLimit - numChars + 1;
+	}
+	lo = (flags & TCL_ENCODING_LE) ? 0 : 3;
+	for (run = 0; run < limit; run++) {
+	    const char *unit = src + 4 * run;
+	    const char *high = unit + (lo ? 0 : 1);
+
+	    if ((high[0] | high[1] | high[2])
+		    || ((unsigned) UCHAR(unit[lo]) - 1 >= 0x7F)) {
+		break;
+	    }
+	    dst[run] = unit[lo];
+	}
+	if (run > 0) {
+	    src += 4 * run;
+	    dst += run;
+	    numChars += run - 1;
+	    continue;
+	}
+
 	if (flags & TCL_ENCODING_LE) {
 	    ch = (unsigned int)(src[3] & 0xFF) << 24 | (src[2] & 0xFF) << 16
 		    | (src[1] & 0xFF) << 8 | (src[0] & 0xFF);
@@ -2786,6 +3138,26 @@ UtfToUtf32Proc(
 	    result = TCL_CONVERT_NOSPACE;
 	    break;
 	}
+	if (UCHAR(*src) < 0x80) {
+	    /*
+	     * Widen a run of 7-bit chars without decoding them one by one.
+	     */
+
+	    int i, run = srcEnd - src;
+
+	    if (run > (dstEnd - dst) / 4 + 1) {
+		run = (dstEnd - dst) / 4 + 1;
+	    }
+	    run = AsciiRunLength(src, run, 1);
+	    memset(dst, 0, 4 * run);
+	    for (i = 0; i < run; i++) {
+		dst[4*i + ((flags & TCL_ENCODING_LE) ? 0 : 3)] = src[i];
+	    }
+	    src += run;
+	    dst += 4 * run;
+	    numChars += run - 1;
+	    continue;
+	}
 	len = TclUtfToUniChar(src, &ch);
 	if (SURROGATE(ch)) {
 	    if (PROFILE_STRICT(flags)) {
@@ -2899,6 +3271,34 @@ Utf16ToUtfProc(
 	    break;
 	}
 
+	/*
+	 * Copy a run of 7-bit code units straight through, unless the
+	 * previous unit was a high surrogate that still needs its partner.
+	 */
+
+	if (!HIGH_SURROGATE(ch)) {
+	    int run, limit = (srcEnd - src) / 2;
+	    int lo = (flags & TCL_ENCODING_LE) ? 0 : 1;
+
+	    if (limit > dstEnd - dst + 1) {
+		limit = dstEnd - dst + 1;
+	    }
+	    if (limit - 1 > charLimit - numChars) {
+		limit = charLimit - numChars + 1;
+	    }
+	    for (run = 0; (run < limit) && !src[2*run + 1 - lo]
+		    && ((unsigned) UCHAR(src[2*run + lo]) - 1 < 0x7F); run++) {
+		dst[run] = src[2*run + lo];
+	    }
+	    if (run > 0) {
+		ch = UCHAR(dst[run - 1]);
+		src += 2 * (run - 1);
+		dst += run;
+		numChars += run - 1;
+		continue;
+	    }
+	}
+
 	unsigned short prev = ch;
 	if (flags & TCL_ENCODING_LE) {
 	    ch = (src[1] & 0xFF) << 8 | (src[0] & 0xFF);
@@ -3067,6 +3467,26 @@ UtfToUtf16Proc(
 	    result = TCL_CONVERT_NOSPACE;
 	    break;
 	}
+	if (UCHAR(*src) < 0x80) {
+	    /*
+	     * Widen a run of 7-bit chars without decoding them one by one.
+	     */
+
+	    int i, run = srcEnd - src;
+
+	    if (run > (dstEnd - dst) / 2 + 1) {
+		run = (dstEnd - dst) / 2 + 1;
+	    }
+	    run = AsciiRunLength(src, run, 1);
+	    memset(dst, 0, 2 * run);
+	    for (i = 0; i < run; i++) {
+		dst[2*i + ((flags & TCL_ENCODING_LE) ? 0 : 1)] = src[i];
+	    }
+	    src += run;
+	    dst += 2 * run;
+	    numChars += run - 1;
+	    continue;
+	}
 	len = TclUtfToUniChar(src, &ch);
 	if (SURROGATE(ch)) {
 	    if (PROFILE_STRICT(flags)) {
@@ -3277,6 +3697,22 @@ TableToUtfProc(
 	    result = TCL_CONVERT_NOSPACE;
 	    break;
 	}
+	if (dataPtr->asciiIdentity && ((unsigned) UCHAR(*src) - 1 < 0x7F)) {
+	    int run = srcEnd - src;
+
+	    if (run > dstEnd - dst + 1) {
+		run = dstEnd - dst + 1;
+	    }
+	    if (run - 1 > charLimit - numChars) {
+		run = charLimit - numChars + 1;
+	    }
+	    run = AsciiRunLength(src, run, 0);
+	    memcpy(dst, src, run);
+	    src += run;
+	    dst += run;
+	    numChars += run - 1;
+	    continue;
+	}
 	byte = *((unsigned char *) src);
 	if (prefixBytes[byte]) {
 	    if (src >= srcEnd-1) {
@@ -3411,6 +3847,20 @@ TableFromUtfProc(
 	    result = TCL_CONVERT_MULTIBYTE;
 	    break;
 	}
+	if (dataPtr->asciiIdentity && ((unsigned) UCHAR(*src) - 1 < 0x7F)
+		&& (dst <= dstEnd)) {
+	    int run = srcEnd - src;
+
+	    if (run > dstEnd - dst + 1) {
+		run = dstEnd - dst + 1;
+	    }
+	    run = AsciiRunLength(src, run, 0);
+	    memcpy(dst, src, run);
+	    src += run;
+	    dst += run;
+	    numChars += run - 1;
+	    continue;
+	}
 	len = TclUtfToUniChar(src, &ch);
 
 	/* Unicode chars > +U0FFFF cannot be represented in any table encoding */
@@ -3515,11 +3965,23 @@ Iso88591ToUtfProc(
 	ch = *((unsigned char *) src);
 
 	/*
-	 * Special case for 1-byte utf chars for speed.
+	 * Special case for 1-byte utf chars for speed: copy the whole run.
 	 */
 
 	if ((unsigned)ch - 1 < 0x7F) {
-	    *dst++ = (char) ch;
+	    int run = srcEnd - src;
+
+	    if (run > dstEnd - dst + 1) {
+		run = dstEnd - dst + 1;
+	    }
+	    if (run - 1 > charLimit - numChars) {
+		run = charLimit - numChars + 1;
+	    }
+	    run = AsciiRunLength(src, run, 0);
+	    memcpy(dst, src, run);
+	    dst += run;
+	    src += run - 1;
+	    numChars += run - 1;
 	} else {
 	    dst += Tcl_UniCharToUtf(ch, dst);
 	}
@@ -3598,6 +4060,19 @@ Iso88591FromUtfProc(
 	    result = TCL_CONVERT_MULTIBYTE;
 	    break;
 	}
+	if ((UCHAR(*src) < 0x80) && (dst <= dstEnd)) {
+	    int run = srcEnd - src;
+
+	    if (run > dstEnd - dst + 1) {
+		run = dstEnd - dst + 1;
+	    }
+	    run = AsciiRunLength(src, run, 1);
+	    memcpy(dst, src, run);
+	    src += run;
+	    dst += run;
+	    numChars += run - 1;
+	    continue;
+	}
 	len = TclUtfToUniChar(src, &ch);
 
 	/*
@@ -5432,7 +5432,7 @@ TEBCresume(
 	if (toIdx == TCL_INDEX_NONE) {
 	    TclNewObj(objResultPtr);
 	} else {
-	    objResultPtr = Tcl_GetRange(OBJ_AT_DEPTH(2), fromIdx, toIdx);
+	    objResultPtr = TclGetSharedRange(OBJ_AT_DEPTH(2), fromIdx, toIdx);
 	}
 	TRACE_APPEND(("\"%.30s\"\n", O2S(objResultPtr)));
 	NEXT_INST_V(1, 3, 1);
@@ -5457,7 +5457,7 @@ TEBCresume(
 	if (toIdx == TCL_INDEX_NONE) {
 	    TclNewObj(objResultPtr);
 	} else {
-	    objResultPtr = Tcl_GetRange(valuePtr, fromIdx, toIdx);
+	    objResultPtr = TclGetSharedRange(valuePtr, fromIdx, toIdx);
 	}
 	TRACE_APPEND(("%.30s\n", O2S(objResultPtr)));
 	NEXT_INST_F(9, 1, 1);
@@ -5603,13 +5603,40 @@ TEBCresume(
 	valuePtr = OBJ_AT_TOS;
 	TRACE(("%s \"%.30s\" => ", tclStringClassTable[opnd].name,
 		O2S(valuePtr)));
-	ustring1 = Tcl_GetUnicodeFromObj(valuePtr, &slength);
 	match = 1;
-	if (slength > 0) {
-	    int ch;
+
+	/*
+	 * Runs of ASCII are classified by table, and the characters after
+	 * them passed to the comparator. Work on the Tcl_UniChars when the
+	 * value has them, so as not to generate its string rep, and on the
+	 * UTF-8 otherwise, so as not to convert it.
+	 */
+
+	if (TclHasInternalRep(valuePtr, &tclStringType)) {
+	    ustring1 = Tcl_GetUnicodeFromObj(valuePtr, &slength);
 	    end = ustring1 + slength;
-	    for (p=ustring1 ; p<end ; ) {
-		ch = *p++;
+	    for (p=ustring1 ; ; p++) {
+		p += TclUniCharClassRun(p, end - p, opnd);
+		if (p >= end) {
+		    break;
+		}
+		if (!tclStringClassTable[opnd].comparator(*p)) {
+		    match = 0;
+		    break;
+		}
+	    }
+	} else {
+	    const char *bytes, *bytesEnd;
+	    int ch;
+
+	    bytes = TclGetStringFromObj(valuePtr, &slength);
+	    bytesEnd = bytes + slength;
+	    while (bytes < bytesEnd) {
+		bytes += TclUtfClassRun(bytes, bytesEnd - bytes, opnd);
+		if (bytes >= bytesEnd) {
+		    break;
+		}
+		bytes += TclUtfToUniChar(bytes, &ch);
 		if (!tclStringClassTable[opnd].comparator(ch)) {
 		    match = 0;
 		    break;
@@ -105,10 +105,21 @@ typedef struct CopyState {
     Tcl_Interp *interp;		/* Interp that started the copy. */
     Tcl_Obj *cmdPtr;		/* Command to be invoked at completion. */
     Tcl_Size bufSize;		/* Size of appended buffer. */
+    int useSendfile;		/* Whether the kernel may move the bytes
+				 * directly, see MBSendfile. */
     char buffer[TCLFLEXARRAY];	/* Copy buffer, this must be the last
 				 * field. */
 } CopyState;
 
+/*
+ * Released channel buffers whose size is CHANNELBUFFER_DEFAULT_SIZE doubled
+ * up to BUFFER_POOL_CLASSES-1 times are kept for reuse by any channel of the
+ * thread, at most BUFFER_POOL_DEPTH of each size.
+ */
+
+#define BUFFER_POOL_CLASSES	5
+#define BUFFER_POOL_DEPTH	8
+
 /*
  * All static variables used in this file are collected into a single instance
  * of the following structure. For multi-threaded implementations, there is
@@ -133,6 +144,15 @@ typedef struct {
     int stdinInitialized;
     int stdoutInitialized;
     int stderrInitialized;
+    ChannelBuffer *freeBuffers[BUFFER_POOL_CLASSES];
+				/* Spare buffers shared by all channels of
+				 * this thread, one list per pooled size,
+				 * linked through their nextPtr fields. */
+    int numFreeBuffers[BUFFER_POOL_CLASSES];
+				/* Length of each list above. */
+    int bufferPoolClosed;	/* Set once the IO subsystem of this thread is
+				 * finalized; buffers are freed from then
+				 * on. */
 } ThreadSpecificData;
 
 static Tcl_ThreadDataKey dataKey;
@@ -184,6 +204,7 @@ static void		MBCallback(CopyState *csPtr, Tcl_Obj *errObj);
 static void		MBError(CopyState *csPtr, int mask, int errorCode);
 static int		MBRead(CopyState *csPtr);
 static int		MBWrite(CopyState *csPtr);
+static int		MBSendfile(CopyState *csPtr);
 static void		MBEvent(void *clientData, int mask);
 
 static void		CopyEventProc(void *clientData, int mask);
@@ -214,6 +235,8 @@ static void		PeekAhead(Channel *chanPtr, char **dstEndPtr,
 			    GetsState *gsPtr);
 static int		ReadBytes(ChannelState *statePtr, Tcl_Obj *objPtr,
 			    int charsLeft);
+static int		ReadBytesDirect(Channel *chanPtr, Tcl_Obj *objPtr,
+			    Tcl_Size bytesToRead);
 static int		ReadChars(ChannelState *statePtr, Tcl_Obj *objPtr,
 			    int charsLeft, int *factorPtr);
 static void		RecycleBuffer(ChannelState *statePtr,
@@ -364,6 +387,28 @@ static const Tcl_ObjType chanObjType = {
       (((st)->csPtrW) && ((fl) & TCL_WRITABLE)))
 
 #define MAX_CHANNEL_BUFFER_SIZE (1024*1024)
+
+/*
+ * The buffer size given to new channels, shared by all threads and changed
+ * with [::tcl::unsupported::channelbuffers].
+ */
+
+static Tcl_Size defaultBufSize = CHANNELBUFFER_DEFAULT_SIZE;
+TCL_DECLARE_MUTEX(defaultBufSizeMutex)
+
+/*
+ * Number of completely filled buffers in a row after which an adaptive
+ * channel doubles its buffer size.
+ */
+
+#define ADAPT_GROW_AFTER	4
+
+/*
+ * Number of bytes TclInputLineBuffered searches at a time for the end of a
+ * line, so that finding one never costs much more than the line itself.
+ */
+
+#define LINE_SCAN_WINDOW	256
 
 /*
  *---------------------------------------------------------------------------
@@ -525,6 +570,41 @@ ChanWrite(
     return chanPtr->typePtr->outputProc(chanPtr->instanceData, src, srcLen,
 	    errnoPtr);
 }
+
+/*
+ * ChanCanWritev tells whether the driver of a channel takes gathered output,
+ * and ChanWritev hands it up to CHANNEL_IOV_MAX buffers of an output queue,
+ * starting with bufPtr.
+ */
+
+#define CHANNEL_IOV_MAX	64
+
+static inline int
+ChanCanWritev(
+    Channel *chanPtr)
+{
+    return (Tcl_ChannelVersion(chanPtr->typePtr) == TCL_CHANNEL_VERSION_6)
+	    && (chanPtr->typePtr->outputvProc != NULL);
+}
+
+static int
+ChanWritev(
+    Channel *chanPtr,
+    ChannelBuffer *bufPtr,
+    int *errnoPtr)
+{
+    Tcl_ChannelIOVec vec[CHANNEL_IOV_MAX];
+    int count = 0;
+
+    for (; (bufPtr != NULL) && (count < CHANNEL_IOV_MAX);
+	    bufPtr = bufPtr->nextPtr) {
+	vec[count].buf = RemovePoint(bufPtr);
+	vec[count].len = BytesLeft(bufPtr);
+	count++;
+    }
+    return chanPtr->typePtr->outputvProc(chanPtr->instanceData, vec, count,
+	    errnoPtr);
+}
 
 /*
  *---------------------------------------------------------------------------
@@ -580,6 +660,7 @@ TclFinalizeIOSubsystem(void)
     ChannelState *statePtr;	/* State of channel stack */
     int active = 1;		/* Flag == 1 while there's still work to do */
     int doflushnb;
+    int i;
 
     /*
      * Fetch the pre-TIP#398 compatibility flag.
@@ -698,6 +779,22 @@ TclFinalizeIOSubsystem(void)
     FreeBinaryEncoding();
     TclpFinalizeSockets();
     TclpFinalizePipes();
+
+    /*
+     * Channels still referenced elsewhere may release buffers later. Free
+     * those directly rather than filling a pool nobody will empty.
+     */
+
+    for (i = 0; i < BUFFER_POOL_CLASSES; i++) {
+	while (tsdPtr->freeBuffers[i] != NULL) {
+	    ChannelBuffer *bufPtr = tsdPtr->freeBuffers[i];
+
+	    tsdPtr->freeBuffers[i] = bufPtr->nextPtr;
+	    Tcl_Free(bufPtr);
+	}
+	tsdPtr->numFreeBuffers[i] = 0;
+    }
+    tsdPtr->bufferPoolClosed = 1;
 }
 
 /*
@@ -1610,8 +1707,9 @@ Tcl_CreateChannel(
     if (typePtr->typeName == NULL) {
 	Tcl_Panic("channel does not have a type name");
     }
-    if (Tcl_ChannelVersion(typePtr) != TCL_CHANNEL_VERSION_5) {
-	Tcl_Panic("channel type %s must be version TCL_CHANNEL_VERSION_5", typePtr->typeName);
+    if ((Tcl_ChannelVersion(typePtr) != TCL_CHANNEL_VERSION_5)
+	    && (Tcl_ChannelVersion(typePtr) != TCL_CHANNEL_VERSION_6)) {
+	Tcl_Panic("channel type %s must be version TCL_CHANNEL_VERSION_5 or TCL_CHANNEL_VERSION_6", typePtr->typeName);
     }
     if (typePtr->close2Proc == NULL) {
 	Tcl_Panic("channel type %s must define close2Proc", typePtr->typeName);
@@ -1696,7 +1794,11 @@ Tcl_CreateChannel(
     statePtr->chPtr		= NULL;
     statePtr->interestMask	= 0;
     statePtr->scriptRecordPtr	= NULL;
-    statePtr->bufSize		= CHANNELBUFFER_DEFAULT_SIZE;
+    Tcl_MutexLock(&defaultBufSizeMutex);
+    statePtr->bufSize		= defaultBufSize;
+    Tcl_MutexUnlock(&defaultBufSizeMutex);
+    statePtr->baseBufSize	= statePtr->bufSize;
+    statePtr->fullBuffers	= 0;
     statePtr->timer		= NULL;
     statePtr->timerChanPtr	= NULL;
     statePtr->csPtrR		= NULL;
@@ -2491,15 +2593,38 @@ Tcl_RemoveChannelMode(
  *---------------------------------------------------------------------------
  */
 
+static int
+BufferPoolClass(
+    Tcl_Size length)		/* Length of a channel buffer. */
+{
+    int i;
+
+    for (i = 0; i < BUFFER_POOL_CLASSES; i++) {
+	if (length == ((Tcl_Size) CHANNELBUFFER_DEFAULT_SIZE << i)) {
+	    return i;
+	}
+    }
+    return -1;
+}
+
 static ChannelBuffer *
 AllocChannelBuffer(
     Tcl_Size length)			/* Desired length of channel buffer. */
 {
+    ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
     ChannelBuffer *bufPtr;
     Tcl_Size n;
+    int i = BufferPoolClass(length);
 
-    n = length + CHANNELBUFFER_HEADER_SIZE + BUFFER_PADDING + BUFFER_PADDING;
-    bufPtr = (ChannelBuffer *)Tcl_Alloc(n);
+    if ((i >= 0) && (tsdPtr->freeBuffers[i] != NULL)) {
+	bufPtr = tsdPtr->freeBuffers[i];
+	tsdPtr->freeBuffers[i] = bufPtr->nextPtr;
+	tsdPtr->numFreeBuffers[i]--;
+    } else {
+	n = length + CHANNELBUFFER_HEADER_SIZE + BUFFER_PADDING
+		+ BUFFER_PADDING;
+	bufPtr = (ChannelBuffer *)Tcl_Alloc(n);
+    }
     bufPtr->nextAdded	= BUFFER_PADDING;
     bufPtr->nextRemoved	= BUFFER_PADDING;
     bufPtr->bufLength	= length + BUFFER_PADDING;
@@ -2522,9 +2647,23 @@ static void
 ReleaseChannelBuffer(
     ChannelBuffer *bufPtr)
 {
+    ThreadSpecificData *tsdPtr;
+    int i;
+
     if (--bufPtr->refCount) {
 	return;
     }
+    i = BufferPoolClass(bufPtr->bufLength - BUFFER_PADDING);
+    if (i >= 0) {
+	tsdPtr = TCL_TSD_INIT(&dataKey);
+	if (!tsdPtr->bufferPoolClosed
+		&& (tsdPtr->numFreeBuffers[i] < BUFFER_POOL_DEPTH)) {
+	    bufPtr->nextPtr = tsdPtr->freeBuffers[i];
+	    tsdPtr->freeBuffers[i] = bufPtr;
+	    tsdPtr->numFreeBuffers[i]++;
+	    return;
+	}
+    }
     Tcl_Free(bufPtr);
 }
 
@@ -2535,6 +2674,54 @@ IsShared(
     return bufPtr->refCount > 1;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * AdaptBufferSize --
+ *
+ *	Called each time a read fills an input buffer or a write fills an
+ *	output buffer, partly or completely. Unless the channel's buffer size
+ *	was set explicitly, doubles it after ADAPT_GROW_AFTER full buffers in
+ *	a row, up to CHANNELBUFFER_ADAPTIVE_MAX, and halves it back towards
+ *	its starting size whenever a buffer is less than a quarter full.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	May change the size of buffers subsequently allocated for the
+ *	channel.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+AdaptBufferSize(
+    ChannelState *statePtr,	/* Channel whose traffic is measured. */
+    Tcl_Size used,		/* Bytes that went into the buffer. */
+    Tcl_Size size)		/* Size of the buffer. */
+{
+    if (GotFlag(statePtr, CHANNEL_FIXED_BUFSIZE)
+	    || (size != statePtr->bufSize)) {
+	return;
+    }
+    if (used >= size) {
+	if ((++statePtr->fullBuffers >= ADAPT_GROW_AFTER)
+		&& (size < CHANNELBUFFER_ADAPTIVE_MAX)) {
+	    statePtr->bufSize = size * 2;
+	    statePtr->fullBuffers = 0;
+	}
+    } else {
+	statePtr->fullBuffers = 0;
+	if ((used < size / 4) && (size > statePtr->baseBufSize)) {
+	    statePtr->bufSize = size / 2;
+	    if (statePtr->bufSize < statePtr->baseBufSize) {
+		statePtr->bufSize = statePtr->baseBufSize;
+	    }
+	}
+    }
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -2775,6 +2962,8 @@ FlushChannel(
 	}
 	statePtr->outQueueTail = bufPtr;
 	statePtr->curOutPtr = NULL;
+	AdaptBufferSize(statePtr, BytesLeft(bufPtr),
+		bufPtr->bufLength - BUFFER_PADDING);
     }
 
     assert(!IsBufferFull(statePtr->curOutPtr));
@@ -2798,12 +2987,18 @@ FlushChannel(
 	bufPtr = statePtr->outQueueHead;
 
 	/*
-	 * Produce the output on the channel.
+	 * Produce the output on the channel. When more than one buffer is
+	 * queued and the driver can take them all at once, it may write
+	 * beyond the end of this one.
 	 */
 
 	PreserveChannelBuffer(bufPtr);
-	written = ChanWrite(chanPtr, RemovePoint(bufPtr), BytesLeft(bufPtr),
-		&errorCode);
+	if ((bufPtr->nextPtr != NULL) && ChanCanWritev(chanPtr)) {
+	    written = ChanWritev(chanPtr, bufPtr, &errorCode);
+	} else {
+	    written = ChanWrite(chanPtr, RemovePoint(bufPtr),
+		    BytesLeft(bufPtr), &errorCode);
+	}
 
 	/*
 	 * If the write failed completely attempt to start the asynchronous
@@ -2922,8 +3117,17 @@ FlushChannel(
 	     * closing the channel from within one of its handler scripts (not
 	     * something one would expecte, but it must be considered).  Normal
 	     * operations on the buffer can proceed.
+	     *
+	     * Buffers completely written by a gathered write are recycled
+	     * here, the last one it reached is handled below.
 	     */
 
+	    while (written > BytesLeft(bufPtr)) {
+		written -= BytesLeft(bufPtr);
+		statePtr->outQueueHead = bufPtr->nextPtr;
+		RecycleBuffer(statePtr, bufPtr, 0);
+		bufPtr = statePtr->outQueueHead;
+	    }
 	    bufPtr->nextRemoved += written;
 
 	    /*
@@ -4499,10 +4703,15 @@ Write(
 	}
 
 	if (IsBufferFull(bufPtr)) {
+	    /*
+	     * Count the size of the buffer before the flush, which may change
+	     * statePtr->bufSize.
+	     */
+
+	    flushed += bufPtr->bufLength - BUFFER_PADDING;
 	    if (FlushChannel(NULL, chanPtr, 0) != 0) {
 		return -1;
 	    }
-	    flushed += statePtr->bufSize;
 
 	    /*
 	     * We just flushed.  So if we have needNlFlush set to record that
@@ -6070,7 +6279,26 @@ DoReadChars(
 		    && GotFlag(statePtr, CHANNEL_BLOCKED)) {
 		break;
 	    }
-	    result = GetInput(chanPtr);
+
+	    /*
+	     * Bulk binary reads skip the channel buffers and let the driver
+	     * write into the object directly.
+	     */
+
+	    if (binaryMode && (chanPtr->inQueueHead == NULL)
+		    && ((toRead < 0) || (toRead > statePtr->bufSize))) {
+		copiedNow = ReadBytesDirect(chanPtr, objPtr, toRead);
+		if (copiedNow >= 0) {
+		    copied += copiedNow;
+		    if (toRead != TCL_INDEX_NONE) {
+			toRead -= copiedNow;
+		    }
+		    continue;
+		}
+		result = Tcl_GetErrno();
+	    } else {
+		result = GetInput(chanPtr);
+	    }
 	    if (chanPtr != statePtr->topChanPtr) {
 		TclChannelRelease((Tcl_Channel)chanPtr);
 		chanPtr = statePtr->topChanPtr;
@@ -6187,6 +6415,73 @@ ReadBytes(
     bufPtr->nextRemoved += toRead;
     return toRead;
 }
+
+/*
+ *---------------------------------------------------------------------------
+ *
+ * ReadBytesDirect --
+ *
+ *	Reads from the driver straight into the storage of a ByteArray object,
+ *	bypassing the channel buffers. Only used for binary reads when the
+ *	input queue is empty and the request is longer than a buffer, so
+ *	that bulk reads don't copy every byte a second time.
+ *
+ *	When 'bytesToRead' is TCL_INDEX_NONE, the size of each read grows with
+ *	the data already in objPtr, up to READ_DIRECT_MAX.
+ *
+ * Results:
+ *	The number of bytes appended to the object, 0 at EOF, or -1 on error
+ *	with the error code available through Tcl_GetErrno. The EOF and
+ *	BLOCKED flags are set as for GetInput.
+ *
+ * Side effects:
+ *	The storage of bytes in objPtr can cause (re-)allocation of memory.
+ *
+ *---------------------------------------------------------------------------
+ */
+
+#define READ_DIRECT_MAX	(1024*1024)
+
+static int
+ReadBytesDirect(
+    Channel *chanPtr,		/* Channel to read input from. */
+    Tcl_Obj *objPtr,		/* Input data is appended to this ByteArray
+				 * object. */
+    Tcl_Size bytesToRead)	/* Maximum number of bytes to store, or
+				 * TCL_INDEX_NONE to read until EOF. */
+{
+    ChannelState *statePtr = chanPtr->state;
+    Tcl_Size chunk, length;
+    unsigned char *bytes;
+    int nread;
+
+    if (CheckForDeadChannel(NULL, statePtr)) {
+	Tcl_SetErrno(EINVAL);
+	return -1;
+    }
+
+    if (bytesToRead < 0) {
+	(void) Tcl_GetBytesFromObj(NULL, objPtr, &length);
+	chunk = (length > statePtr->bufSize) ? length : statePtr->bufSize;
+    } else {
+	chunk = bytesToRead;
+    }
+    if (chunk > READ_DIRECT_MAX) {
+	chunk = READ_DIRECT_MAX;
+    }
+
+    /*
+     * Reserve the space at the end of the object, let the driver fill it,
+     * then trim the object back to what was actually read.
+     */
+
+    TclAppendBytesToByteArray(objPtr, NULL, chunk);
+    bytes = Tcl_GetBytesFromObj(NULL, objPtr, &length);
+    length -= chunk;
+    nread = ChanRead(chanPtr, (char *) bytes + length, (int) chunk);
+    Tcl_SetByteArrayLength(objPtr, length + (nread > 0 ? nread : 0));
+    return nread;
+}
 
 /*
  *---------------------------------------------------------------------------
@@ -7112,6 +7407,7 @@ GetInput(
 	if (statePtr->inQueueTail != NULL) {
 	    statePtr->inQueueTail->nextAdded += nread;
 	}
+	AdaptBufferSize(statePtr, nread, toRead);
     }
 
     return result;
@@ -7659,6 +7955,89 @@ Tcl_InputBuffered(
     return bytesBuffered;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclInputLineBuffered --
+ *
+ *	Tells whether the input buffered in a channel holds the end of a
+ *	line, so that a following Tcl_GetsObj will not have to wait for the
+ *	device. Encodings with multi-byte NUL characters are never considered
+ *	to have a line buffered.
+ *
+ *	The buffered bytes are examined in windows of LINE_SCAN_WINDOW bytes,
+ *	stopping in the first window that holds a line end. As that line is
+ *	what the following Tcl_GetsObj consumes, reading a batch of lines
+ *	with alternating calls looks at each buffered byte about once, rather
+ *	than searching the whole buffer for every line.
+ *
+ * Results:
+ *	1 if a line end or the eofchar was found, 0 otherwise.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+TclInputLineBuffered(
+    Tcl_Channel chan)		/* The channel to query. */
+{
+    ChannelState *statePtr = ((Channel *) chan)->state;
+				/* State of real channel structure. */
+    ChannelBuffer *queues[2], *bufPtr;
+    int translation = statePtr->inputTranslation;
+    int eofChar = UCHAR(statePtr->inEofChar);
+    int lf = (translation != TCL_TRANSLATE_CR);
+    int cr = (translation == TCL_TRANSLATE_CR)
+	    || (translation == TCL_TRANSLATE_AUTO);
+    int i, prev = 0;
+
+    if (GotFlag(statePtr, CHANNEL_STICKY_EOF)) {
+	return 1;
+    }
+    if (Tcl_GetEncodingNulLength(statePtr->encoding) > 1) {
+	return 0;
+    }
+
+    /*
+     * Look at the topmost pushback area first, then the common buffers.
+     */
+
+    queues[0] = statePtr->topChanPtr->inQueueHead;
+    queues[1] = statePtr->inQueueHead;
+    for (i = 0; i < 2; i++) {
+	for (bufPtr = queues[i]; bufPtr != NULL; bufPtr = bufPtr->nextPtr) {
+	    const char *start = RemovePoint(bufPtr);
+	    const char *end = InsertPoint(bufPtr);
+	    const char *p, *q, *stop;
+
+	    for (p = start; p < end; p = stop) {
+		stop = (end - p > LINE_SCAN_WINDOW) ? p + LINE_SCAN_WINDOW : end;
+		q = p;
+		while (lf && ((q = (const char *)
+			memchr(q, '\n', stop - q)) != NULL)) {
+		    if ((translation != TCL_TRANSLATE_CRLF)
+			    || (((q > start) ? UCHAR(q[-1]) : prev) == '\r')) {
+			return 1;
+		    }
+		    q++;
+		}
+		if ((cr && (memchr(p, '\r', stop - p) != NULL))
+			|| ((eofChar != '\0')
+			&& (memchr(p, eofChar, stop - p) != NULL))) {
+		    return 1;
+		}
+	    }
+	    if (end > start) {
+		prev = UCHAR(end[-1]);
+	    }
+	}
+    }
+    return 0;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -7771,6 +8150,7 @@ Tcl_SetChannelBufferSize(
     }
 
     statePtr = ((Channel *) chan)->state;
+    SetFlag(statePtr, CHANNEL_FIXED_BUFSIZE);
 
     if (statePtr->bufSize == sz) {
 	return;
@@ -7821,6 +8201,77 @@ Tcl_GetChannelBufferSize(
     return statePtr->bufSize;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclChannelBuffersObjCmd --
+ *
+ *	Implements the [::tcl::unsupported::channelbuffers] command, which
+ *	reports on channel buffering and optionally changes the buffer size
+ *	given to channels opened from then on, in any thread:
+ *
+ *	    ::tcl::unsupported::channelbuffers ?size?
+ *
+ * Results:
+ *	A standard Tcl result. The interp's result is a dictionary with the
+ *	keys "default", the size new channels start with, "adaptivemax", the
+ *	size up to which channels without an explicit -buffersize grow, and
+ *	"pooled", the number of spare buffers the current thread keeps.
+ *
+ * Side effects:
+ *	May change the default buffer size.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+TclChannelBuffersObjCmd(
+    TCL_UNUSED(void *),
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
+    Tcl_WideInt size;
+    Tcl_Obj *resultObj;
+    int i, pooled = 0;
+
+    if (objc > 2) {
+	Tcl_WrongNumArgs(interp, 1, objv, "?size?");
+	return TCL_ERROR;
+    }
+    if (objc == 2) {
+	if (TclGetWideIntFromObj(interp, objv[1], &size) != TCL_OK) {
+	    return TCL_ERROR;
+	}
+	if (size < 1 || size > MAX_CHANNEL_BUFFER_SIZE) {
+	    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		    "bad size \"%s\": must be an integer between 1 and %d",
+		    TclGetString(objv[1]), MAX_CHANNEL_BUFFER_SIZE));
+	    Tcl_SetErrorCode(interp, "TCL", "VALUE", "BUFFERSIZE", (char *)NULL);
+	    return TCL_ERROR;
+	}
+	Tcl_MutexLock(&defaultBufSizeMutex);
+	defaultBufSize = (Tcl_Size) size;
+	Tcl_MutexUnlock(&defaultBufSizeMutex);
+    }
+
+    Tcl_MutexLock(&defaultBufSizeMutex);
+    size = defaultBufSize;
+    Tcl_MutexUnlock(&defaultBufSizeMutex);
+    for (i = 0; i < BUFFER_POOL_CLASSES; i++) {
+	pooled += tsdPtr->numFreeBuffers[i];
+    }
+
+    TclNewObj(resultObj);
+    TclDictPut(NULL, resultObj, "default", Tcl_NewWideIntObj(size));
+    TclDictPut(NULL, resultObj, "adaptivemax",
+	    Tcl_NewWideIntObj(CHANNELBUFFER_ADAPTIVE_MAX));
+    TclDictPut(NULL, resultObj, "pooled", Tcl_NewWideIntObj(pooled));
+    Tcl_SetObjResult(interp, resultObj);
+    return TCL_OK;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -9380,6 +9831,9 @@ TclCopyChannel(
 	Tcl_IncrRefCount(cmdPtr);
     }
     csPtr->cmdPtr = cmdPtr;
+    csPtr->useSendfile = moveBytes && (inPtr != outPtr)
+	    && (inStatePtr->topChanPtr == inStatePtr->bottomChanPtr)
+	    && (outStatePtr->topChanPtr == outStatePtr->bottomChanPtr);
 
     TclChannelPreserve(inChan);
     TclChannelPreserve(outChan);
@@ -9489,7 +9943,18 @@ MBEvent(
     Tcl_Channel outChan = (Tcl_Channel) csPtr->writePtr;
     ChannelState *inStatePtr = csPtr->readPtr->state;
 
-    if (mask & TCL_WRITABLE) {
+    if ((mask & TCL_WRITABLE) && csPtr->useSendfile) {
+	switch (MBSendfile(csPtr)) {
+	case TCL_OK:
+	    Tcl_DeleteChannelHandler(outChan, MBEvent, csPtr);
+	    MBCallback(csPtr, NULL);
+	    break;
+	case TCL_BREAK:
+	    Tcl_DeleteChannelHandler(outChan, MBEvent, csPtr);
+	    Tcl_CreateChannelHandler(inChan, TCL_READABLE, MBEvent, csPtr);
+	    break;
+	}
+    } else if (mask & TCL_WRITABLE) {
 	Tcl_DeleteChannelHandler(inChan, MBEvent, csPtr);
 	Tcl_DeleteChannelHandler(outChan, MBEvent, csPtr);
 	switch (MBWrite(csPtr)) {
@@ -9610,6 +10075,66 @@ MBWrite(
     return TCL_CONTINUE;
 }
 
+/*
+ * The most bytes handed to the kernel at once, so that a background copy
+ * from a fast disk to a fast sink still returns to the event loop.
+ */
+
+#define SENDFILE_CHUNK	(1 << 20)
+
+static int
+MBSendfile(
+    CopyState *csPtr)
+{
+    ChannelState *inStatePtr = csPtr->readPtr->state;
+    long long toCopy = SENDFILE_CHUNK;
+    long long moved;
+    int errorCode;
+
+    if (csPtr->toRead == 0) {
+	return TCL_OK;
+    }
+    if ((csPtr->toRead != -1) && (csPtr->toRead < toCopy)) {
+	toCopy = csPtr->toRead;
+    }
+    moved = TclpChannelSendfile((Tcl_Channel) csPtr->readPtr,
+	    (Tcl_Channel) csPtr->writePtr, toCopy, &errorCode);
+    if (moved < 0) {
+	if (errorCode == EAGAIN) {
+	    return TCL_CONTINUE;
+	}
+
+	/*
+	 * Not possible for these channels, or a real error. Either way the
+	 * buffered path takes over, and reports the error if it persists.
+	 */
+
+	csPtr->useSendfile = 0;
+	return TCL_BREAK;
+    }
+
+    /*
+     * Set the EOF state the way a read through ChanRead would have.
+     */
+
+    if (GotFlag(inStatePtr, CHANNEL_EOF)) {
+	inStatePtr->inputEncodingFlags |= TCL_ENCODING_START;
+    }
+    ResetFlag(inStatePtr, CHANNEL_BLOCKED | CHANNEL_EOF);
+    inStatePtr->inputEncodingFlags &= ~TCL_ENCODING_END;
+    if (moved == 0) {
+	SetFlag(inStatePtr, CHANNEL_EOF);
+	inStatePtr->inputEncodingFlags |= TCL_ENCODING_END;
+	return TCL_OK;
+    }
+
+    if (csPtr->toRead != -1) {
+	csPtr->toRead -= moved;
+    }
+    csPtr->total += moved;
+    return (csPtr->toRead == 0) ? TCL_OK : TCL_CONTINUE;
+}
+
 static int
 MoveBytes(
     CopyState *csPtr)		/* State of copy operation. */
@@ -9629,12 +10154,41 @@ MoveBytes(
 	}
     }
 
+    /*
+     * The kernel can only move the bytes itself when nothing is waiting in
+     * either channel's buffers.
+     */
+
+    if (csPtr->useSendfile
+	    && (Tcl_InputBuffered((Tcl_Channel) csPtr->readPtr)
+		|| Tcl_OutputBuffered((Tcl_Channel) csPtr->readPtr)
+		|| Tcl_InputBuffered((Tcl_Channel) csPtr->writePtr)
+		|| Tcl_OutputBuffered((Tcl_Channel) csPtr->writePtr))) {
+	csPtr->useSendfile = 0;
+    }
+
     if (csPtr->cmdPtr) {
-	Tcl_Channel inChan = (Tcl_Channel) csPtr->readPtr;
-	Tcl_CreateChannelHandler(inChan, TCL_READABLE, MBEvent, csPtr);
+	if (csPtr->useSendfile) {
+	    Tcl_Channel outChan = (Tcl_Channel) csPtr->writePtr;
+	    Tcl_CreateChannelHandler(outChan, TCL_WRITABLE, MBEvent, csPtr);
+	} else {
+	    Tcl_Channel inChan = (Tcl_Channel) csPtr->readPtr;
+	    Tcl_CreateChannelHandler(inChan, TCL_READABLE, MBEvent, csPtr);
+	}
 	return TCL_OK;
     }
 
+    while (csPtr->useSendfile) {
+	int code = MBSendfile(csPtr);
+
+	if (code == TCL_OK) {
+	    Tcl_SetObjResult(csPtr->interp, Tcl_NewWideIntObj(csPtr->total));
+	    StopCopy(csPtr);
+	    return TCL_OK;
+	}
+	/* TCL_CONTINUE --> more to move; TCL_BREAK --> buffered loop below */
+    }
+
     while (1) {
 	int code;
 
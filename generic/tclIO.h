@@ -66,6 +66,13 @@ typedef struct ChannelBuffer {
 
 #define CHANNELBUFFER_DEFAULT_SIZE	(1024 * 4)
 
+/*
+ * Channels whose buffer size was never set explicitly double it, up to this
+ * limit, when their reads or writes keep filling whole buffers.
+ */
+
+#define CHANNELBUFFER_ADAPTIVE_MAX	(1024 * 64)
+
 /*
  * The following structure describes the information saved from a call to
  * "fileevent". This is used later when the event being waited for to invoke
@@ -190,6 +197,11 @@ typedef struct ChannelState {
 				/* Chain of all scripts registered for event
 				 * handlers ("fileevent") on this channel. */
     Tcl_Size bufSize;		/* What size buffers to allocate? */
+    Tcl_Size baseBufSize;	/* Size the channel started with, which an
+				 * adaptively grown bufSize shrinks back to
+				 * when the traffic slows down. */
+    int fullBuffers;		/* How many buffers in a row were filled
+				 * completely by reads or writes. */
     Tcl_TimerToken timer;	/* Handle to wakeup timer for this channel. */
     Channel *timerChanPtr;	/* Needed in order to decrement the refCount of
 				 * the right channel when the timer is
@@ -289,6 +301,9 @@ typedef struct ChannelState {
 #define CHANNEL_CLOSEDWRITE	(1<<21)	/* Channel write side has been closed.
 					 * No further Tcl-level write IO on
 					 * the channel is allowed. */
+#define CHANNEL_FIXED_BUFSIZE	(1<<22)	/* The buffer size was set explicitly
+					 * and must not be adapted to the
+					 * traffic. */
 
 /*
  * The length of time to wait between synthetic timer events. Must be zero or
@@ -40,6 +40,7 @@ static Tcl_ThreadDataKey dataKey;
 
 static Tcl_ExitProc		FinalizeIOCmdTSD;
 static Tcl_TcpAcceptProc	AcceptCallbackProc;
+static Tcl_ObjCmdProc		ChanLinesObjCmd;
 static Tcl_ObjCmdProc		ChanPendingObjCmd;
 static Tcl_ObjCmdProc		ChanTruncateObjCmd;
 static void		RegisterTcpServerInterpCleanup(
@@ -1776,6 +1777,110 @@ Tcl_FcopyObjCmd(
     return TclCopyChannel(interp, inChan, outChan, toRead, cmdPtr);
 }
 
+/*
+ *---------------------------------------------------------------------------
+ *
+ * ChanLinesObjCmd --
+ *
+ *	This function is invoked to process the Tcl "chan lines" command.
+ *	See the user documentation for details on what it does.
+ *
+ * Results:
+ *	A standard Tcl result.
+ *
+ * Side effects:
+ *	Reads lines from the channel and sets interp's result to a list of
+ *	them. Without a count, one line is read as by [gets] and then as many
+ *	more as are already complete in the channel's buffers.
+ *
+ *---------------------------------------------------------------------------
+ */
+
+static int
+ChanLinesObjCmd(
+    TCL_UNUSED(void *),
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    Tcl_Channel chan;		/* The channel to read from. */
+    Tcl_WideInt count = -1;	/* How many lines to read, or -1 for those
+				 * buffered. */
+    int mode;			/* Mode in which channel is opened. */
+    Tcl_Size numLines = 0;	/* How many lines were read so far. */
+    Tcl_Obj *listPtr, *linePtr, *chanObjPtr;
+
+    if ((objc != 2) && (objc != 3)) {
+	Tcl_WrongNumArgs(interp, 1, objv, "channel ?count?");
+	return TCL_ERROR;
+    }
+    chanObjPtr = objv[1];
+    if (TclGetChannelFromObj(interp, chanObjPtr, &chan, &mode, 0) != TCL_OK) {
+	return TCL_ERROR;
+    }
+    if (!(mode & TCL_READABLE)) {
+	Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		"channel \"%s\" wasn't opened for reading",
+		TclGetString(chanObjPtr)));
+	return TCL_ERROR;
+    }
+    if (objc == 3) {
+	if ((TclGetWideIntFromObj(NULL, objv[2], &count) != TCL_OK)
+		|| (count < 0)) {
+	    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		    "expected non-negative integer but got \"%s\"",
+		    TclGetString(objv[2])));
+	    Tcl_SetErrorCode(interp, "TCL", "VALUE", "NUMBER", (char *)NULL);
+	    return TCL_ERROR;
+	}
+    }
+
+    TclChannelPreserve(chan);
+    listPtr = Tcl_NewListObj(0, NULL);
+    while (count != 0) {
+	if ((count < 0) && (numLines > 0) && !TclInputLineBuffered(chan)) {
+	    break;
+	}
+	TclNewObj(linePtr);
+	if (Tcl_GetsObj(chan, linePtr) == TCL_IO_FAILURE) {
+	    Tcl_DecrRefCount(linePtr);
+	    if (Tcl_Eof(chan) || Tcl_InputBlocked(chan)) {
+		break;
+	    }
+
+	    /*
+	     * As with [read], the lines already read are handed back through
+	     * the -data return option.
+	     */
+
+	    if (!TclChanCaughtErrorBypass(interp, chan)) {
+		Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+			"error reading \"%s\": %s",
+			TclGetString(chanObjPtr), Tcl_PosixError(interp)));
+	    }
+	    if (TclChannelGetBlockingMode(chan)) {
+		Tcl_Obj *returnOptsPtr = Tcl_NewDictObj();
+
+		Tcl_DictObjPut(NULL, returnOptsPtr,
+			Tcl_NewStringObj("-data", -1), listPtr);
+		Tcl_SetReturnOptions(interp, returnOptsPtr);
+	    } else {
+		Tcl_DecrRefCount(listPtr);
+	    }
+	    TclChannelRelease(chan);
+	    return TCL_ERROR;
+	}
+	Tcl_ListObjAppendElement(NULL, listPtr, linePtr);
+	numLines++;
+	if (count > 0) {
+	    count--;
+	}
+    }
+    Tcl_SetObjResult(interp, listPtr);
+    TclChannelRelease(chan);
+    return TCL_OK;
+}
+
 /*
  *---------------------------------------------------------------------------
  *
@@ -2033,6 +2138,7 @@ TclInitChanCmd(
 	{"event",	Tcl_FileEventObjCmd,	TclCompileBasic2Or3ArgCmd, NULL, NULL, 0},
 	{"flush",	Tcl_FlushObjCmd,	TclCompileBasic1ArgCmd, NULL, NULL, 0},
 	{"gets",	Tcl_GetsObjCmd,		TclCompileBasic1Or2ArgCmd, NULL, NULL, 0},
+	{"lines",	ChanLinesObjCmd,	TclCompileBasic1Or2ArgCmd, NULL, NULL, 0},
 	{"names",	TclChannelNamesCmd,	TclCompileBasic0Or1ArgCmd, NULL, NULL, 0},
 	{"pending",	ChanPendingObjCmd,	TclCompileBasic2ArgCmd, NULL, NULL, 0},		/* TIP #287 */
 	{"pipe",	ChanPipeObjCmd,		TclCompileBasic0ArgCmd, NULL, NULL, 0},		/* TIP #304 */
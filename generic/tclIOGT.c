@@ -131,7 +131,8 @@ static const Tcl_ChannelType transformChannelType = {
     TransformNotifyProc,
     TransformWideSeekProc,
     NULL,			/* Thread action proc. */
-    NULL			/* Truncate proc. */
+    NULL,			/* Truncate proc. */
+    NULL			/* Vectored output proc. */
 };
 
 /*
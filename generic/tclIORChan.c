@@ -37,6 +37,9 @@ static int		ReflectInput(void *clientData, char *buf,
 			    int toRead, int *errorCodePtr);
 static int		ReflectOutput(void *clientData, const char *buf,
 			    int toWrite, int *errorCodePtr);
+static int		ReflectOutputv(void *clientData,
+			    const Tcl_ChannelIOVec *vec, int count,
+			    int *errorCodePtr);
 static void		ReflectWatch(void *clientData, int mask);
 static int		ReflectBlock(void *clientData, int mode);
 #if TCL_THREADS
@@ -61,7 +64,7 @@ static int		ReflectTruncate(void *clientData,
 
 static const Tcl_ChannelType reflectedChannelType = {
     "tclrchannel",
-    TCL_CHANNEL_VERSION_5,
+    TCL_CHANNEL_VERSION_6,
     NULL,			/* Deprecated */
     ReflectInput,
     ReflectOutput,
@@ -80,7 +83,8 @@ static const Tcl_ChannelType reflectedChannelType = {
 #else
     NULL,			/* Thread action proc */
 #endif
-    ReflectTruncate		/* Truncate proc. */
+    ReflectTruncate,		/* Truncate proc. */
+    ReflectOutputv		/* Vectored output proc. */
 };
 
 /*
@@ -259,7 +263,8 @@ struct ForwardParamInput {
 };
 struct ForwardParamOutput {
     ForwardParamBase base;	/* "Supertype". MUST COME FIRST. */
-    const char *buf;		/* I: Where the bytes to write come from */
+    const Tcl_ChannelIOVec *vec;/* I: Where the bytes to write come from */
+    int count;			/* I: Number of buffers in vec */
     Tcl_Size toWrite;		/* I: #bytes to write,
 				 * O: #bytes actually written */
 };
@@ -445,6 +450,8 @@ static ReflectedChannelMap *	GetReflectedChannelMap(Tcl_Interp *interp);
 static Tcl_InterpDeleteProc	DeleteReflectedChannelMap;
 static int		ErrnoReturn(ReflectedChannel *rcPtr, Tcl_Obj *resObj);
 static void		MarkDead(ReflectedChannel *rcPtr);
+static Tcl_Obj *	NewByteArrayFromVec(const Tcl_ChannelIOVec *vec,
+			    int count, Tcl_Size total);
 
 /*
  * Global constant strings (messages). ==================
@@ -1388,11 +1395,50 @@ ReflectOutput(
     const char *buf,
     int toWrite,
     int *errorCodePtr)
+{
+    Tcl_ChannelIOVec vec;
+
+    vec.buf = buf;
+    vec.len = toWrite;
+    return ReflectOutputv(clientData, &vec, 1, errorCodePtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * ReflectOutputv --
+ *
+ *	This function is invoked from the generic IO level to write one or
+ *	more buffers of output, e.g. the queue of a nonblocking channel that
+ *	catches up on its backlog. The buffers are handed to the "write"
+ *	method in a single call, so that the script (and, for a channel in
+ *	another thread, the forwarding round trip) is paid once instead of
+ *	once per buffer.
+ *
+ * Results:
+ *	The number of bytes actually written.
+ *
+ * Side effects:
+ *	Allocates memory. Arbitrary, as it calls upon a script.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+ReflectOutputv(
+    void *clientData,
+    const Tcl_ChannelIOVec *vec,
+    int count,
+    int *errorCodePtr)
 {
     ReflectedChannel *rcPtr = (ReflectedChannel *)clientData;
     Tcl_Obj *bufObj;
     Tcl_Obj *resObj;		/* Result data for 'write' */
-    int written;
+    int i, written, toWrite = 0;
+
+    for (i = 0; i < count; i++) {
+	toWrite += vec[i].len;
+    }
 
     /*
      * Are we in the correct thread?
@@ -1402,7 +1448,8 @@ ReflectOutput(
     if (rcPtr->thread != Tcl_GetCurrentThread()) {
 	ForwardParam p;
 
-	p.output.buf = buf;
+	p.output.vec = vec;
+	p.output.count = count;
 	p.output.toWrite = toWrite;
 
 	ForwardOpToHandlerThread(rcPtr, ForwardedOutput, &p);
@@ -1433,7 +1480,7 @@ ReflectOutput(
     Tcl_Preserve(rcPtr);
     Tcl_Preserve(rcPtr->interp);
 
-    bufObj = Tcl_NewByteArrayObj((unsigned char *) buf, toWrite);
+    bufObj = NewByteArrayFromVec(vec, count, toWrite);
     Tcl_IncrRefCount(bufObj);
 
     if (InvokeTclMethod(rcPtr, METH_WRITE, bufObj, NULL, &resObj) != TCL_OK) {
@@ -1495,6 +1542,46 @@ ReflectOutput(
     goto stop;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * NewByteArrayFromVec --
+ *
+ *	Creates the byte array passed to the "write" method from the buffers
+ *	of a gathered write, copying each of them once.
+ *
+ * Results:
+ *	A new byte array object with a refcount of zero.
+ *
+ * Side effects:
+ *	Allocates memory.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static Tcl_Obj *
+NewByteArrayFromVec(
+    const Tcl_ChannelIOVec *vec,	/* The buffers to join. */
+    int count,			/* Number of buffers in vec. */
+    Tcl_Size total)		/* Sum of the buffer lengths. */
+{
+    Tcl_Obj *bufObj;
+    unsigned char *p;
+    int i;
+
+    if (count == 1) {
+	return Tcl_NewByteArrayObj((const unsigned char *) vec[0].buf,
+		vec[0].len);
+    }
+    bufObj = Tcl_NewByteArrayObj(NULL, 0);
+    p = Tcl_SetByteArrayLength(bufObj, total);
+    for (i = 0; i < count; i++) {
+	memcpy(p, vec[i].buf, vec[i].len);
+	p += vec[i].len;
+    }
+    return bufObj;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -3098,8 +3185,8 @@ ForwardProc(
     }
 
     case ForwardedOutput: {
-	Tcl_Obj *bufObj = Tcl_NewByteArrayObj((unsigned char *)
-		paramPtr->output.buf, paramPtr->output.toWrite);
+	Tcl_Obj *bufObj = NewByteArrayFromVec(paramPtr->output.vec,
+		paramPtr->output.count, paramPtr->output.toWrite);
 	Tcl_IncrRefCount(bufObj);
 
 	Tcl_Preserve(rcPtr);
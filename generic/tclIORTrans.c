@@ -72,7 +72,8 @@ static const Tcl_ChannelType reflectedTransformType = {
     ReflectNotify,
     ReflectSeekWide,
     NULL,			/* Thread action proc. */
-    NULL			/* Truncate proc. */
+    NULL,			/* Truncate proc. */
+    NULL			/* Vectored output proc. */
 };
 
 /*
@@ -3278,6 +3278,12 @@ MODULE_SCOPE int	TclAsyncNotifier(int sigNumber, Tcl_ThreadId threadId,
 			    void *clientData, int *flagPtr, int value);
 MODULE_SCOPE void	TclAsyncMarkFromNotifier(void);
 MODULE_SCOPE double	TclBignumToDouble(const void *bignum);
+MODULE_SCOPE Tcl_Size	TclByteArrayFind(const unsigned char *string,
+			    Tcl_Size strLen, const unsigned char *needle,
+			    Tcl_Size needleLen);
+MODULE_SCOPE Tcl_Size	TclByteArrayFindLast(const unsigned char *string,
+			    Tcl_Size strLen, const unsigned char *needle,
+			    Tcl_Size needleLen);
 MODULE_SCOPE int	TclByteArrayMatch(const unsigned char *string,
 			    Tcl_Size strLen, const unsigned char *pattern,
 			    Tcl_Size ptnLen, int flags);
@@ -3432,6 +3438,7 @@ MODULE_SCOPE void	TclInitLimitSupport(Tcl_Interp *interp);
 MODULE_SCOPE void	TclInitNamespaceSubsystem(void);
 MODULE_SCOPE void	TclInitNotifier(void);
 MODULE_SCOPE void	TclInitObjSubsystem(void);
+MODULE_SCOPE int	TclInputLineBuffered(Tcl_Channel chan);
 MODULE_SCOPE int	TclInterpReady(Tcl_Interp *interp);
 MODULE_SCOPE int	TclIsBareword(int byte);
 MODULE_SCOPE Tcl_Obj *	TclJoinPath(Tcl_Size elements, Tcl_Obj * const objv[],
@@ -3500,7 +3507,14 @@ MODULE_SCOPE Tcl_Obj *	TclNewArithSeriesObj(Tcl_Interp *interp,
 			    Tcl_Obj *stepObj, Tcl_Obj *lenObj);
 MODULE_SCOPE Tcl_Obj *	TclNewFSPathObj(Tcl_Obj *dirPtr, const char *addStrRep,
 			    Tcl_Size len);
+MODULE_SCOPE Tcl_Obj *	TclNewSubstringObj(Tcl_Obj *parentPtr, Tcl_Size offset,
+			    Tcl_Size numBytes, Tcl_Size numChars);
+MODULE_SCOPE Tcl_Obj *	TclGetSharedRange(Tcl_Obj *objPtr, Tcl_Size first,
+			    Tcl_Size last);
 MODULE_SCOPE void	TclpAlertNotifier(void *clientData);
+MODULE_SCOPE long long	TclpChannelSendfile(Tcl_Channel inChan,
+			    Tcl_Channel outChan, long long toCopy,
+			    int *errorCodePtr);
 MODULE_SCOPE void *	TclpNotifierData(void);
 MODULE_SCOPE void	TclpServiceModeHook(int mode);
 MODULE_SCOPE void	TclpSetTimer(const Tcl_Time *timePtr);
@@ -3572,6 +3586,9 @@ MODULE_SCOPE void	TclRememberCondition(Tcl_Condition *mutex);
 MODULE_SCOPE void	TclRememberJoinableThread(Tcl_ThreadId id);
 MODULE_SCOPE void	TclRememberMutex(Tcl_Mutex *mutex);
 MODULE_SCOPE void	TclRemoveScriptLimitCallbacks(Tcl_Interp *interp);
+MODULE_SCOPE int	TclRegExpExecFromObj(Tcl_Interp *interp, Tcl_RegExp re,
+			    Tcl_Obj *textObj, Tcl_Size start, Tcl_Size nmatches,
+			    int flags);
 MODULE_SCOPE int	TclReToGlob(Tcl_Interp *interp, const char *reStr,
 			    Tcl_Size reStrLen, Tcl_DString *dsPtr, int *flagsPtr,
 			    int *quantifiersFoundPtr);
@@ -3701,6 +3718,7 @@ MODULE_SCOPE Tcl_ObjCmdProc TclChanCreateObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc TclChanPostEventObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc TclChanPopObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc TclChanPushObjCmd;
+MODULE_SCOPE Tcl_ObjCmdProc TclChannelBuffersObjCmd;
 MODULE_SCOPE void	TclClockInit(Tcl_Interp *interp);
 MODULE_SCOPE Tcl_ObjCmdProc TclClockOldscanObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Tcl_CloseObjCmd;
@@ -3776,6 +3794,8 @@ MODULE_SCOPE Tcl_ObjCmdProc Tcl_PutsObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Tcl_PwdObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Tcl_ReadObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Tcl_RegexpObjCmd;
+MODULE_SCOPE Tcl_ObjCmdProc TclRegexpCacheObjCmd;
+MODULE_SCOPE Tcl_ObjCmdProc TclRegexpStreamObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Tcl_RegsubObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Tcl_RenameObjCmd;
 MODULE_SCOPE Tcl_ObjCmdProc Tcl_RepresentationCmd;
@@ -4056,6 +4076,12 @@ MODULE_SCOPE int	TclUniCharNcasecmp(const Tcl_UniChar *ucs,
 			    const Tcl_UniChar *uct, size_t numChars);
 MODULE_SCOPE int	TclUniCharCaseMatch(const Tcl_UniChar *uniStr,
 			    const Tcl_UniChar *uniPattern, int nocase);
+MODULE_SCOPE Tcl_Size	TclUniCharFind(const Tcl_UniChar *string,
+			    Tcl_Size strLen, const Tcl_UniChar *needle,
+			    Tcl_Size needleLen);
+MODULE_SCOPE Tcl_Size	TclUniCharFindLast(const Tcl_UniChar *string,
+			    Tcl_Size strLen, const Tcl_UniChar *needle,
+			    Tcl_Size needleLen);
 
 /*
  * Just for the purposes of command-type registration.
@@ -4611,10 +4637,10 @@ MODULE_SCOPE const TclFileAttrProcs	tclpFileAttrProcs[];
 
 /*
  *----------------------------------------------------------------
- * Macro counterpart of the Tcl_NumUtfChars() function. To be used in speed-
- * -sensitive points where it pays to avoid a function call in the common case
- * of counting along a string of all one-byte characters.  The ANSI C
- * "prototype" for this macro is:
+ * Macro counterpart of the Tcl_NumUtfChars() function. Short strings are
+ * counted inline when they consist of one-byte characters only; anything
+ * else goes to Tcl_NumUtfChars(), which scans long one-byte runs a word at a
+ * time. The ANSI C "prototype" for this macro is:
  *
  * MODULE_SCOPE void	TclNumUtfCharsM(Tcl_Size numChars, const char *bytes,
  *				Tcl_Size numBytes);
@@ -4626,7 +4652,9 @@ MODULE_SCOPE const TclFileAttrProcs	tclpFileAttrProcs[];
     do {								\
 	Tcl_Size _count, _i = (numBytes);				\
 	unsigned char *_str = (unsigned char *) (bytes);		\
-	while (_i > 0 && (*_str < 0xC0)) { _i--; _str++; }		\
+	if (_i <= 16) {							\
+	    while (_i > 0 && (*_str < 0xC0)) { _i--; _str++; }		\
+	}								\
 	_count = (numBytes) - _i;					\
 	if (_i) {							\
 	    _count += Tcl_NumUtfChars((bytes) + _count, _i);		\
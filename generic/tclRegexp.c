@@ -13,6 +13,7 @@
 
 #include "tclInt.h"
 #include "tclRegexp.h"
+#include "tclStringRep.h"
 #include "tclTomMath.h"
 #include <assert.h>
 
@@ -61,30 +62,62 @@
 
 /*
  * Thread local storage used to maintain a per-thread cache of compiled
- * regular expressions.
+ * regular expressions. The cache is a hash table keyed by pattern and
+ * compilation flags, whose entries are also kept on a list in order of last
+ * use so that the least recently used one can be evicted once the cache
+ * holds more than its capacity. NUM_REGEXPS is the default capacity; it can
+ * be changed per thread with [::tcl::unsupported::regexpcache].
  */
 
 #define NUM_REGEXPS 30
 
+typedef struct RegexpCacheEntry {
+    TclRegexp *regexpPtr;	/* Compiled regexp. The cache holds one
+				 * reference to it. */
+    Tcl_HashEntry *hPtr;	/* Entry for this regexp in the cache's hash
+				 * table. */
+    struct RegexpCacheEntry *prevPtr;
+				/* Next more recently used entry, or NULL. */
+    struct RegexpCacheEntry *nextPtr;
+				/* Next less recently used entry, or NULL. */
+} RegexpCacheEntry;
+
 typedef struct {
     int initialized;		/* Set to 1 when the module is initialized. */
-    char *patterns[NUM_REGEXPS];/* Strings corresponding to compiled regular
-				 * expression patterns. NULL means that this
-				 * slot isn't used. Malloc-ed. */
-    size_t patLengths[NUM_REGEXPS];/* Number of non-null characters in
-				 * corresponding entry in patterns. -1 means
-				 * entry isn't used. */
-    struct TclRegexp *regexps[NUM_REGEXPS];
-				/* Compiled forms of above strings. Also
-				 * malloc-ed, or NULL if not in use yet. */
+    Tcl_HashTable cache;	/* Maps RegexpCacheKey to RegexpCacheEntry. */
+    RegexpCacheEntry *firstPtr;	/* Most recently used entry, or NULL. */
+    RegexpCacheEntry *lastPtr;	/* Least recently used entry, or NULL. */
+    Tcl_Size capacity;		/* Maximum number of entries. */
+    Tcl_WideInt hits;		/* Lookups answered from the cache. */
+    Tcl_WideInt misses;		/* Lookups that had to compile. */
 } ThreadSpecificData;
 
+/*
+ * Key used to look up a pattern in the cache. Entries store the flags
+ * followed by the pattern string.
+ */
+
+typedef struct {
+    const char *string;		/* The pattern (UTF-8). */
+    size_t length;		/* Length of the pattern in bytes. */
+    int flags;			/* Compilation flags. */
+} RegexpCacheKey;
+
+typedef struct {
+    int flags;			/* Compilation flags. */
+    char string[TCLFLEXARRAY];	/* The pattern, NUL terminated. */
+} RegexpStoredKey;
+
 static Tcl_ThreadDataKey dataKey;
 
 /*
  * Declarations for functions used only in this file.
  */
 
+static Tcl_HashEntry *	AllocRegexpCacheEntry(Tcl_HashTable *tablePtr,
+			    void *keyPtr);
+static int		CompareRegexpCacheKeys(void *keyPtr,
+			    Tcl_HashEntry *hPtr);
 static TclRegexp *	CompileRegexp(Tcl_Interp *interp, const char *pattern,
 			    size_t length, int flags);
 static void		DupRegexpInternalRep(Tcl_Obj *srcPtr,
@@ -92,6 +125,12 @@ static void		DupRegexpInternalRep(Tcl_Obj *srcPtr,
 static void		FinalizeRegexp(void *clientData);
 static void		FreeRegexp(TclRegexp *regexpPtr);
 static void		FreeRegexpInternalRep(Tcl_Obj *objPtr);
+static int		LiteralAbsent(TclRegexp *regexpPtr,
+			    Tcl_Obj *textObj);
+static size_t		HashRegexpCacheKey(Tcl_HashTable *tablePtr,
+			    void *keyPtr);
+static void		PruneRegexpCache(ThreadSpecificData *tsdPtr,
+			    Tcl_Size capacity);
 static int		RegExpExecUniChar(Tcl_Interp *interp, Tcl_RegExp re,
 			    const Tcl_UniChar *uniString, size_t numChars,
 			    size_t nmatches, int flags);
@@ -111,6 +150,19 @@ const Tcl_ObjType tclRegexpType = {
     TCL_OBJTYPE_V0
 };
 
+/*
+ * Key type of the per-thread regexp cache.
+ */
+
+static const Tcl_HashKeyType regexpCacheKeyType = {
+    TCL_HASH_KEY_TYPE_VERSION,	/* version */
+    0,				/* flags */
+    HashRegexpCacheKey,		/* hashKeyProc */
+    CompareRegexpCacheKeys,	/* compareKeysProc */
+    AllocRegexpCacheEntry,	/* allocEntryProc */
+    NULL			/* freeEntryProc */
+};
+
 #define RegexpSetInternalRep(objPtr, rePtr) \
     do {								\
 	Tcl_ObjInternalRep ir;						\
@@ -482,6 +534,9 @@ Tcl_RegExpExecObj(
     regexpPtr->string = NULL;
     regexpPtr->objPtr = textObj;
 
+    if ((offset == 0) && LiteralAbsent(regexpPtr, textObj)) {
+	return 0;
+    }
     udata = Tcl_GetUnicodeFromObj(textObj, &length);
 
     if (offset > length) {
@@ -493,6 +548,105 @@ Tcl_RegExpExecObj(
     return RegExpExecUniChar(interp, re, udata, length, nmatches, flags);
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclRegExpExecFromObj --
+ *
+ *	Execute a precompiled regexp against the given object, starting the
+ *	search at a given character index. Unlike the offset passed to
+ *	Tcl_RegExpExecObj, the characters before that index stay visible to
+ *	the matcher as context, so that constraints such as \m and \y (and ^
+ *	with TCL_REG_NLANCH) see them. The match indices reported by
+ *	Tcl_RegExpGetInfo are relative to the start of the whole string.
+ *
+ * Results:
+ *	If an error occurs during the matching operation then -1 is returned
+ *	and the interp's result contains an error message. Otherwise the
+ *	return value is 1 if there is a match and 0 otherwise.
+ *
+ * Side effects:
+ *	Converts the object to a Unicode object.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+TclRegExpExecFromObj(
+    Tcl_Interp *interp,		/* Interpreter to use for error reporting. */
+    Tcl_RegExp re,		/* Compiled regular expression. */
+    Tcl_Obj *textObj,		/* Text against which to match re. */
+    Tcl_Size start,		/* Character index where the search begins. */
+    Tcl_Size nmatches,		/* How many subexpression matches (counting
+				 * the whole match as subexpression 0) are of
+				 * interest. -1 means all of them. */
+    int flags)			/* Regular expression execution flags. */
+{
+    TclRegexp *regexpPtr = (TclRegexp *) re;
+    Tcl_UniChar *udata;
+    Tcl_Size length;
+
+    regexpPtr->string = NULL;
+    regexpPtr->objPtr = textObj;
+    udata = Tcl_GetUnicodeFromObj(textObj, &length);
+    if (start > length) {
+	start = length;
+    }
+
+    /*
+     * REG_STARTEND takes the start of the search from the first match slot,
+     * so at least that one must be passed in.
+     */
+
+    regexpPtr->matches[0].rm_so = start;
+    return RegExpExecUniChar(interp, re, udata, length,
+	    (nmatches == 0) ? 1 : nmatches, flags | REG_STARTEND);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * LiteralAbsent --
+ *
+ *	Checks whether a string lacks the literal that every match of a
+ *	regexp contains, working on the byte array or UTF-8 rep of the string
+ *	so that a string that cannot match need not be converted to
+ *	Tcl_UniChars at all. Strings that already have a Tcl_UniChar rep are
+ *	left to the regexp engine, which makes the same check itself.
+ *
+ * Results:
+ *	1 if the string certainly does not match, 0 if it might.
+ *
+ * Side effects:
+ *	May generate the string rep of textObj.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+LiteralAbsent(
+    TclRegexp *regexpPtr,	/* Compiled regexp. */
+    Tcl_Obj *textObj)		/* String about to be matched. */
+{
+    const unsigned char *bytes;
+    Tcl_Size numBytes;
+
+    if (regexpPtr->literal == NULL) {
+	return 0;
+    }
+    if (TclIsPureByteArray(textObj)) {
+	bytes = Tcl_GetBytesFromObj(NULL, textObj, &numBytes);
+    } else if (TclHasInternalRep(textObj, &tclStringType)
+	    && GET_STRING(textObj)->hasUnicode) {
+	return 0;
+    } else {
+	bytes = (const unsigned char *) TclGetStringFromObj(textObj, &numBytes);
+    }
+    return TclByteArrayFind(bytes, numBytes,
+	    (const unsigned char *) regexpPtr->literal,
+	    regexpPtr->literalLength) < 0;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -863,12 +1017,21 @@ CompileRegexp(
 {
     TclRegexp *regexpPtr;
     const Tcl_UniChar *uniString;
-    int numChars, status, i, exact;
+    int numChars, status, exact, isNew;
     Tcl_DString stringBuf;
+    RegexpCacheKey key;
+    RegexpCacheEntry *entryPtr;
+    Tcl_HashEntry *hPtr;
     ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
 
     if (!tsdPtr->initialized) {
 	tsdPtr->initialized = 1;
+	Tcl_InitCustomHashTable(&tsdPtr->cache, TCL_CUSTOM_TYPE_KEYS,
+		&regexpCacheKeyType);
+	tsdPtr->firstPtr = tsdPtr->lastPtr = NULL;
+	if (tsdPtr->capacity < 1) {
+	    tsdPtr->capacity = NUM_REGEXPS;
+	}
 	Tcl_CreateThreadExitHandler(FinalizeRegexp, NULL);
     }
 
@@ -884,33 +1047,32 @@ CompileRegexp(
      * if it has the same pattern and the same flags.
      */
 
-    for (i = 0; (i < NUM_REGEXPS) && (tsdPtr->patterns[i] != NULL); i++) {
-	if ((length == tsdPtr->patLengths[i])
-		&& (tsdPtr->regexps[i]->flags == flags)
-		&& (strcmp(string, tsdPtr->patterns[i]) == 0)) {
-	    /*
-	     * Move the matched pattern to the first slot in the cache and
-	     * shift the other patterns down one position.
-	     */
-
-	    if (i != 0) {
-		int j;
-		char *cachedString;
-
-		cachedString = tsdPtr->patterns[i];
-		regexpPtr = tsdPtr->regexps[i];
-		for (j = i-1; j >= 0; j--) {
-		    tsdPtr->patterns[j+1] = tsdPtr->patterns[j];
-		    tsdPtr->patLengths[j+1] = tsdPtr->patLengths[j];
-		    tsdPtr->regexps[j+1] = tsdPtr->regexps[j];
-		}
-		tsdPtr->patterns[0] = cachedString;
-		tsdPtr->patLengths[0] = length;
-		tsdPtr->regexps[0] = regexpPtr;
+    key.string = string;
+    key.length = length;
+    key.flags = flags;
+    hPtr = Tcl_FindHashEntry(&tsdPtr->cache, &key);
+    if (hPtr != NULL) {
+	/*
+	 * Move the matched pattern to the front of the use list.
+	 */
+
+	entryPtr = (RegexpCacheEntry *)Tcl_GetHashValue(hPtr);
+	if (entryPtr->prevPtr != NULL) {
+	    entryPtr->prevPtr->nextPtr = entryPtr->nextPtr;
+	    if (entryPtr->nextPtr != NULL) {
+		entryPtr->nextPtr->prevPtr = entryPtr->prevPtr;
+	    } else {
+		tsdPtr->lastPtr = entryPtr->prevPtr;
 	    }
-	    return tsdPtr->regexps[0];
+	    entryPtr->prevPtr = NULL;
+	    entryPtr->nextPtr = tsdPtr->firstPtr;
+	    tsdPtr->firstPtr->prevPtr = entryPtr;
+	    tsdPtr->firstPtr = entryPtr;
 	}
+	tsdPtr->hits++;
+	return entryPtr->regexpPtr;
     }
+    tsdPtr->misses++;
 
     /*
      * This is a new expression, so compile it and add it to the cache.
@@ -965,6 +1127,38 @@ CompileRegexp(
 	regexpPtr->globObjPtr = NULL;
     }
 
+    /*
+     * Keep the longest ASCII run of a literal that every match contains, for
+     * LiteralAbsent. Any part of such a literal must also be in every match.
+     * ASCII chars have the same single byte in UTF-8 and byte array reps, and
+     * no other sequence there decodes to one of them.
+     */
+
+    regexpPtr->literal = NULL;
+    regexpPtr->literalLength = 0;
+    {
+	size_t i, run, numLiteral, best = 0, bestRun = 0;
+	const Tcl_UniChar *literal = TclReLiteral(&regexpPtr->re, &numLiteral);
+
+	for (i = 0, run = 0; i < numLiteral; i++) {
+	    if (literal[i] > 0 && literal[i] < 0x80) {
+		if (++run > bestRun) {
+		    bestRun = run;
+		    best = i + 1 - run;
+		}
+	    } else {
+		run = 0;
+	    }
+	}
+	if (bestRun > 0) {
+	    regexpPtr->literal = (char *)Tcl_Alloc(bestRun);
+	    for (i = 0; i < bestRun; i++) {
+		regexpPtr->literal[i] = (char) literal[best + i];
+	    }
+	    regexpPtr->literalLength = bestRun;
+	}
+    }
+
     /*
      * Allocate enough space for all of the subexpressions, plus one extra for
      * the entire pattern.
@@ -980,27 +1174,24 @@ CompileRegexp(
     regexpPtr->refCount = 1;
 
     /*
-     * Free the last regexp, if necessary, and make room at the head of the
-     * list for the new regexp.
+     * Add the new regexp at the head of the use list, then free the least
+     * recently used ones if the cache has grown too big.
      */
 
-    if (tsdPtr->patterns[NUM_REGEXPS-1] != NULL) {
-	TclRegexp *oldRegexpPtr = tsdPtr->regexps[NUM_REGEXPS-1];
-
-	if (oldRegexpPtr->refCount-- <= 1) {
-	    FreeRegexp(oldRegexpPtr);
-	}
-	Tcl_Free(tsdPtr->patterns[NUM_REGEXPS-1]);
-    }
-    for (i = NUM_REGEXPS - 2; i >= 0; i--) {
-	tsdPtr->patterns[i+1] = tsdPtr->patterns[i];
-	tsdPtr->patLengths[i+1] = tsdPtr->patLengths[i];
-	tsdPtr->regexps[i+1] = tsdPtr->regexps[i];
+    hPtr = Tcl_CreateHashEntry(&tsdPtr->cache, &key, &isNew);
+    entryPtr = (RegexpCacheEntry *)Tcl_Alloc(sizeof(RegexpCacheEntry));
+    entryPtr->regexpPtr = regexpPtr;
+    entryPtr->hPtr = hPtr;
+    entryPtr->prevPtr = NULL;
+    entryPtr->nextPtr = tsdPtr->firstPtr;
+    if (tsdPtr->firstPtr != NULL) {
+	tsdPtr->firstPtr->prevPtr = entryPtr;
+    } else {
+	tsdPtr->lastPtr = entryPtr;
     }
-    tsdPtr->patterns[0] = (char *)Tcl_Alloc(length + 1);
-    memcpy(tsdPtr->patterns[0], string, length + 1);
-    tsdPtr->patLengths[0] = length;
-    tsdPtr->regexps[0] = regexpPtr;
+    tsdPtr->firstPtr = entryPtr;
+    Tcl_SetHashValue(hPtr, entryPtr);
+    PruneRegexpCache(tsdPtr, tsdPtr->capacity);
 
     return regexpPtr;
 }
@@ -1029,6 +1220,9 @@ FreeRegexp(
     if (regexpPtr->globObjPtr) {
 	TclDecrRefCount(regexpPtr->globObjPtr);
     }
+    if (regexpPtr->literal) {
+	Tcl_Free(regexpPtr->literal);
+    }
     if (regexpPtr->matches) {
 	Tcl_Free(regexpPtr->matches);
     }
@@ -1055,18 +1249,10 @@ static void
 FinalizeRegexp(
     TCL_UNUSED(void *))
 {
-    int i;
-    TclRegexp *regexpPtr;
     ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
 
-    for (i = 0; (i < NUM_REGEXPS) && (tsdPtr->patterns[i] != NULL); i++) {
-	regexpPtr = tsdPtr->regexps[i];
-	if (regexpPtr->refCount-- <= 1) {
-	    FreeRegexp(regexpPtr);
-	}
-	Tcl_Free(tsdPtr->patterns[i]);
-	tsdPtr->patterns[i] = NULL;
-    }
+    PruneRegexpCache(tsdPtr, 0);
+    Tcl_DeleteHashTable(&tsdPtr->cache);
 
     /*
      * We may find ourselves reinitialized if another finalization routine
@@ -1076,6 +1262,207 @@ FinalizeRegexp(
     tsdPtr->initialized = 0;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * PruneRegexpCache --
+ *
+ *	Drop the least recently used regexps from the per-thread cache until
+ *	it holds no more than capacity of them.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Compiled regexps no longer referenced by any object are freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+PruneRegexpCache(
+    ThreadSpecificData *tsdPtr,	/* Cache to prune. */
+    Tcl_Size capacity)		/* Number of entries to keep. */
+{
+    while (tsdPtr->lastPtr != NULL
+	    && tsdPtr->cache.numEntries > capacity) {
+	RegexpCacheEntry *entryPtr = tsdPtr->lastPtr;
+
+	tsdPtr->lastPtr = entryPtr->prevPtr;
+	if (tsdPtr->lastPtr != NULL) {
+	    tsdPtr->lastPtr->nextPtr = NULL;
+	} else {
+	    tsdPtr->firstPtr = NULL;
+	}
+	if (entryPtr->regexpPtr->refCount-- <= 1) {
+	    FreeRegexp(entryPtr->regexpPtr);
+	}
+	Tcl_DeleteHashEntry(entryPtr->hPtr);
+	Tcl_Free(entryPtr);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * HashRegexpCacheKey, CompareRegexpCacheKeys, AllocRegexpCacheEntry --
+ *
+ *	Hash key procedures for the per-thread regexp cache, whose keys are a
+ *	pattern together with the flags it was compiled with.
+ *
+ * Results:
+ *	HashRegexpCacheKey returns the hash value of a key,
+ *	CompareRegexpCacheKeys returns 1 if a key matches an entry and 0
+ *	otherwise, and AllocRegexpCacheEntry returns a new entry holding a
+ *	copy of a key.
+ *
+ * Side effects:
+ *	AllocRegexpCacheEntry allocates memory.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static size_t
+HashRegexpCacheKey(
+    TCL_UNUSED(Tcl_HashTable *),
+    void *keyPtr)		/* Key from which to compute hash value. */
+{
+    const RegexpCacheKey *key = (const RegexpCacheKey *)keyPtr;
+    size_t i, result = (size_t) key->flags;
+
+    for (i = 0; i < key->length; i++) {
+	result += (result << 3) + UCHAR(key->string[i]);
+    }
+    return result;
+}
+
+static int
+CompareRegexpCacheKeys(
+    void *keyPtr,		/* New key to compare. */
+    Tcl_HashEntry *hPtr)	/* Existing key to compare. */
+{
+    const RegexpCacheKey *key = (const RegexpCacheKey *)keyPtr;
+    const RegexpStoredKey *stored = (const RegexpStoredKey *) &hPtr->key;
+
+    return (key->flags == stored->flags)
+	    && (memcmp(key->string, stored->string, key->length) == 0)
+	    && (stored->string[key->length] == '\0');
+}
+
+static Tcl_HashEntry *
+AllocRegexpCacheEntry(
+    TCL_UNUSED(Tcl_HashTable *),
+    void *keyPtr)		/* Key to store in the hash table entry. */
+{
+    const RegexpCacheKey *key = (const RegexpCacheKey *)keyPtr;
+    Tcl_HashEntry *hPtr;
+    RegexpStoredKey *stored;
+    size_t size = offsetof(RegexpStoredKey, string) + key->length + 1;
+
+    if (size < sizeof(hPtr->key)) {
+	size = sizeof(hPtr->key);
+    }
+    hPtr = (Tcl_HashEntry *)Tcl_Alloc(offsetof(Tcl_HashEntry, key) + size);
+    stored = (RegexpStoredKey *) &hPtr->key;
+    stored->flags = key->flags;
+    memcpy(stored->string, key->string, key->length);
+    stored->string[key->length] = '\0';
+    Tcl_SetHashValue(hPtr, NULL);
+    return hPtr;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclRegexpCacheObjCmd --
+ *
+ *	Implements the [::tcl::unsupported::regexpcache] command, which
+ *	reports on the current thread's cache of compiled regexps and
+ *	optionally changes how many regexps it may hold:
+ *
+ *	    ::tcl::unsupported::regexpcache ?capacity?
+ *
+ * Results:
+ *	A standard Tcl result. The interp's result is a dictionary with the
+ *	keys "capacity", "size", "hits" and "misses", plus "dfabuilds",
+ *	"dfareuses" and "dfastates", which total how many DFAs the regexps
+ *	now in the cache have built, how many times they found a DFA kept
+ *	from an earlier match, and how many DFA states they have computed.
+ *
+ * Side effects:
+ *	Lowering the capacity may free cached regexps.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+TclRegexpCacheObjCmd(
+    TCL_UNUSED(void *),
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
+    Tcl_WideInt capacity;
+    Tcl_Obj *resultObj;
+    RegexpCacheEntry *entryPtr;
+    size_t stats[3], totals[3] = {0, 0, 0};
+
+    if (objc > 2) {
+	Tcl_WrongNumArgs(interp, 1, objv, "?capacity?");
+	return TCL_ERROR;
+    }
+    if (tsdPtr->capacity < 1) {
+	tsdPtr->capacity = NUM_REGEXPS;
+    }
+    if (objc == 2) {
+	if (TclGetWideIntFromObj(interp, objv[1], &capacity) != TCL_OK) {
+	    return TCL_ERROR;
+	}
+	if (capacity < 1 || capacity > TCL_SIZE_MAX) {
+	    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		    "bad capacity \"%s\": must be a positive integer",
+		    TclGetString(objv[1])));
+	    Tcl_SetErrorCode(interp, "TCL", "VALUE", "CAPACITY", (char *)NULL);
+	    return TCL_ERROR;
+	}
+	tsdPtr->capacity = (Tcl_Size) capacity;
+	if (tsdPtr->initialized) {
+	    PruneRegexpCache(tsdPtr, tsdPtr->capacity);
+	}
+    }
+
+    TclNewObj(resultObj);
+    TclDictPut(NULL, resultObj, "capacity",
+	    Tcl_NewWideIntObj(tsdPtr->capacity));
+    TclDictPut(NULL, resultObj, "size", Tcl_NewWideIntObj(
+	    tsdPtr->initialized ? tsdPtr->cache.numEntries : 0));
+    TclDictPut(NULL, resultObj, "hits", Tcl_NewWideIntObj(tsdPtr->hits));
+    TclDictPut(NULL, resultObj, "misses", Tcl_NewWideIntObj(tsdPtr->misses));
+
+    /*
+     * How well the regexps in the cache are doing at reusing their DFAs.
+     */
+
+    if (tsdPtr->initialized) {
+	for (entryPtr = tsdPtr->firstPtr; entryPtr != NULL;
+		entryPtr = entryPtr->nextPtr) {
+	    TclReDFAStats(&entryPtr->regexpPtr->re, stats);
+	    totals[0] += stats[0];
+	    totals[1] += stats[1];
+	    totals[2] += stats[2];
+	}
+    }
+    TclDictPut(NULL, resultObj, "dfabuilds",
+	    Tcl_NewWideIntObj((Tcl_WideInt) totals[0]));
+    TclDictPut(NULL, resultObj, "dfareuses",
+	    Tcl_NewWideIntObj((Tcl_WideInt) totals[1]));
+    TclDictPut(NULL, resultObj, "dfastates",
+	    Tcl_NewWideIntObj((Tcl_WideInt) totals[2]));
+    Tcl_SetObjResult(interp, resultObj);
+    return TCL_OK;
+}
+
 /*
  * Local Variables:
  * mode: c
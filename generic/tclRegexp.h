@@ -31,6 +31,11 @@ typedef struct TclRegexp {
     const char *string;		/* Last string passed to Tcl_RegExpExec. */
     Tcl_Obj *objPtr;		/* Last object passed to Tcl_RegExpExecObj. */
     Tcl_Obj *globObjPtr;	/* Glob pattern rep of RE or NULL if none. */
+    char *literal;		/* ASCII string that every match contains, or
+				 * NULL if none is known. Lets a string be
+				 * rejected from its UTF-8 or byte array rep
+				 * without converting it to Tcl_UniChars. */
+    Tcl_Size literalLength;	/* Length of literal. */
     regmatch_t *matches;	/* Array of indices into the Tcl_UniChar
 				 * representation of the last string matched
 				 * with this regexp to indicate the location
@@ -291,12 +291,1318 @@ static const Tcl_WideUInt wuipow5[] = {
     (Tcl_WideUInt) 3125U*3125U*3125U*3125U*3125U*25U /* 5**27 */
 };
 
+/*
+ * Tables for the shortest conversion of doubles to decimal (Ulf Adams's
+ * "Ryu" algorithm). Each entry is a 125-bit approximation of a power of 5,
+ * stored as {low 64 bits, high 64 bits}:
+ *	pow5InvSplit[q] = floor(2**(bitlength(5**q) - 1 + 125) / 5**q) + 1
+ *	pow5Split[i] = 5**i scaled by a power of 2 to exactly 125 bits
+ * The sizes cover every exponent that a double can have.
+ */
+
+#define RYU_POW5_BITCOUNT 125
+
+static const Tcl_WideUInt pow5InvSplit[291][2] = {
+    {UINT64_C(0x0000000000000001), UINT64_C(0x2000000000000000)},
+    {UINT64_C(0x999999999999999A), UINT64_C(0x1999999999999999)},
+    {UINT64_C(0x47AE147AE147AE15), UINT64_C(0x147AE147AE147AE1)},
+    {UINT64_C(0x6C8B4395810624DE), UINT64_C(0x10624DD2F1A9FBE7)},
+    {UINT64_C(0x7A786C226809D496), UINT64_C(0x1A36E2EB1C432CA5)},
+    {UINT64_C(0x61F9F01B866E43AB), UINT64_C(0x14F8B588E368F084)},
+    {UINT64_C(0xB4C7F34938583622), UINT64_C(0x10C6F7A0B5ED8D36)},
+    {UINT64_C(0x87A6520EC08D236A), UINT64_C(0x1AD7F29ABCAF4857)},
+    {UINT64_C(0x9FB841A566D74F88), UINT64_C(0x15798EE2308C39DF)},
+    {UINT64_C(0xE62D01511F12A607), UINT64_C(0x112E0BE826D694B2)},
+    {UINT64_C(0xD6AE6881CB5109A4), UINT64_C(0x1B7CDFD9D7BDBAB7)},
+    {UINT64_C(0xDEF1ED34A2A73AEA), UINT64_C(0x15FD7FE17964955F)},
+    {UINT64_C(0x7F27F0F6E885C8BB), UINT64_C(0x119799812DEA1119)},
+    {UINT64_C(0x650CB4BE40D60DF8), UINT64_C(0x1C25C268497681C2)},
+    {UINT64_C(0xEA70909833DE7193), UINT64_C(0x16849B86A12B9B01)},
+    {UINT64_C(0x21F3A6E0297EC143), UINT64_C(0x1203AF9EE756159B)},
+    {UINT64_C(0x6985D7CD0F313537), UINT64_C(0x1CD2B297D889BC2B)},
+    {UINT64_C(0x2137DFD73F5A90F9), UINT64_C(0x170EF54646D49689)},
+    {UINT64_C(0xE75FE645CC4873FA), UINT64_C(0x12725DD1D243ABA0)},
+    {UINT64_C(0xA5663D3C7A0D865D), UINT64_C(0x1D83C94FB6D2AC34)},
+    {UINT64_C(0x511E976394D79EB1), UINT64_C(0x179CA10C9242235D)},
+    {UINT64_C(0xDA7EDF82DD794BC1), UINT64_C(0x12E3B40A0E9B4F7D)},
+    {UINT64_C(0x2A6498D1625BAC68), UINT64_C(0x1E392010175EE596)},
+    {UINT64_C(0xEEB6E0A781E2F053), UINT64_C(0x182DB34012B25144)},
+    {UINT64_C(0x58924D52CE4F26A9), UINT64_C(0x1357C299A88EA76A)},
+    {UINT64_C(0x27507BB7B07EA441), UINT64_C(0x1EF2D0F5DA7DD8AA)},
+    {UINT64_C(0x52A6C95FC0655034), UINT64_C(0x18C240C4AECB13BB)},
+    {UINT64_C(0x0EEBD44C99EAA690), UINT64_C(0x13CE9A36F23C0FC9)},
+    {UINT64_C(0xB17953ADC3110A80), UINT64_C(0x1FB0F6BE50601941)},
+    {UINT64_C(0xC12DDC8B02740867), UINT64_C(0x195A5EFEA6B34767)},
+    {UINT64_C(0x3424B06F3529A052), UINT64_C(0x14484BFEEBC29F86)},
+    {UINT64_C(0x901D59F290EE19DB), UINT64_C(0x1039D66589687F9E)},
+    {UINT64_C(0x4CFBC31DB4B0295F), UINT64_C(0x19F623D5A8A73297)},
+    {UINT64_C(0x3D9635B15D59BAB2), UINT64_C(0x14C4E977BA1F5BAC)},
+    {UINT64_C(0x97AB5E277DE16228), UINT64_C(0x109D8792FB4C4956)},
+    {UINT64_C(0xF2ABC9D8C9689D0D), UINT64_C(0x1A95A5B7F87A0EF0)},
+    {UINT64_C(0x5BBCA17A3ABA173E), UINT64_C(0x154484932D2E725A)},
+    {UINT64_C(0xAFCA1AC82EFB45CB), UINT64_C(0x11039D428A8B8EAE)},
+    {UINT64_C(0xB2DCF7A6B1920945), UINT64_C(0x1B38FB9DAA78E44A)},
+    {UINT64_C(0xF57D92EBC141A104), UINT64_C(0x15C72FB1552D836E)},
+    {UINT64_C(0xC46475896767B403), UINT64_C(0x116C262777579C58)},
+    {UINT64_C(0x6D6D88DBD8A5ECD2), UINT64_C(0x1BE03D0BF225C6F4)},
+    {UINT64_C(0x8ABE071646EB23DB), UINT64_C(0x164CFDA3281E38C3)},
+    {UINT64_C(0x6EFE6C11D255B649), UINT64_C(0x11D7314F534B609C)},
+    {UINT64_C(0xB197134FB6EF8A0E), UINT64_C(0x1C8B821885456760)},
+    {UINT64_C(0x27AC0F72F8BFA1A5), UINT64_C(0x16D601AD376AB91A)},
+    {UINT64_C(0xB95672C260994E1E), UINT64_C(0x1244CE242C5560E1)},
+    {UINT64_C(0xF5571E03CDC21695), UINT64_C(0x1D3AE36D13BBCE35)},
+    {UINT64_C(0x2AAC18030B01ABAB), UINT64_C(0x17624F8A762FD82B)},
+    {UINT64_C(0xBBBCE0026F348956), UINT64_C(0x12B50C6EC4F31355)},
+    {UINT64_C(0x92C7CCD0B1EDA889), UINT64_C(0x1DEE7A4AD4B81EEF)},
+    {UINT64_C(0xDBD30A408E57BA07), UINT64_C(0x17F1FB6F10934BF2)},
+    {UINT64_C(0x7CA8D50071DFC806), UINT64_C(0x1327FC58DA0F6FF5)},
+    {UINT64_C(0xFAA7BB33E9660CD6), UINT64_C(0x1EA6608E29B24CBB)},
+    {UINT64_C(0x9552FC298784D711), UINT64_C(0x18851A0B548EA3C9)},
+    {UINT64_C(0xAAA8C9BAD2D0AC0E), UINT64_C(0x139DAE6F76D88307)},
+    {UINT64_C(0xDDDADC5E1E1AACE3), UINT64_C(0x1F62B0B257C0D1A5)},
+    {UINT64_C(0x7E48B04B4B488A4F), UINT64_C(0x191BC08EAC9A4151)},
+    {UINT64_C(0xCB6D59D5D5D3A1D9), UINT64_C(0x141633A556E1CDDA)},
+    {UINT64_C(0x3C577B1177DC817B), UINT64_C(0x1011C2EAABE7D7E2)},
+    {UINT64_C(0xC6F25E825960CF2A), UINT64_C(0x19B604AAACA62636)},
+    {UINT64_C(0x6BF518684780A5BB), UINT64_C(0x14919D5556EB51C5)},
+    {UINT64_C(0x232A79ED06008496), UINT64_C(0x10747DDDDF22A7D1)},
+    {UINT64_C(0xD1DD8FE1A3340756), UINT64_C(0x1A53FC9631D10C81)},
+    {UINT64_C(0xA7E4731AE8F66C45), UINT64_C(0x150FFD44F4A73D34)},
+    {UINT64_C(0x531D28E253F8569E), UINT64_C(0x10D9976A5D52975D)},
+    {UINT64_C(0xEB61DB03B98D5762), UINT64_C(0x1AF5BF109550F22E)},
+    {UINT64_C(0xBC4E48CFC7A445E8), UINT64_C(0x159165A6DDDA5B58)},
+    {UINT64_C(0x6371D3D96C836B20), UINT64_C(0x11411E1F17E1E2AD)},
+    {UINT64_C(0x9F1C8628AD9F11CD), UINT64_C(0x1B9B6364F3030448)},
+    {UINT64_C(0xE5B06B53BE18DB0B), UINT64_C(0x1615E91D8F359D06)},
+    {UINT64_C(0xEAF3890FCB4715A2), UINT64_C(0x11AB20E472914A6B)},
+    {UINT64_C(0x44B8DB4C7871BC37), UINT64_C(0x1C45016D841BAA46)},
+    {UINT64_C(0x03C715D6C6C1635F), UINT64_C(0x169D9ABE03495505)},
+    {UINT64_C(0x3638DE456BCDE919), UINT64_C(0x1217AEFE69077737)},
+    {UINT64_C(0x56C163A2461641C1), UINT64_C(0x1CF2B1970E725858)},
+    {UINT64_C(0xDF011C81D1AB67CE), UINT64_C(0x17288E1271F51379)},
+    {UINT64_C(0x7F3416CE4155ECA5), UINT64_C(0x1286D80EC190DC61)},
+    {UINT64_C(0x6520247D3556476E), UINT64_C(0x1DA48CE468E7C702)},
+    {UINT64_C(0xEA801D30F7783925), UINT64_C(0x17B6D71D20B96C01)},
+    {UINT64_C(0xBB99B0F3F92CFA84), UINT64_C(0x12F8AC174D612334)},
+    {UINT64_C(0x5F5C4E532847F739), UINT64_C(0x1E5AACF215683854)},
+    {UINT64_C(0x7F7D0B75B9D32C2E), UINT64_C(0x18488A5B44536043)},
+    {UINT64_C(0x9930D5F7C7DC2358), UINT64_C(0x136D3B7C36A919CF)},
+    {UINT64_C(0x8EB4898C72F9D226), UINT64_C(0x1F152BF9F10E8FB2)},
+    {UINT64_C(0x722A07A38F2E41B8), UINT64_C(0x18DDBCC7F40BA628)},
+    {UINT64_C(0xC1BB394FA5BE9AFA), UINT64_C(0x13E497065CD61E86)},
+    {UINT64_C(0x9C5EC2190930F7F6), UINT64_C(0x1FD424D6FAF030D7)},
+    {UINT64_C(0x49E56814075A5FF8), UINT64_C(0x197683DF2F268D79)},
+    {UINT64_C(0x6E51201005E1E660), UINT64_C(0x145ECFE5BF520AC7)},
+    {UINT64_C(0xF1DA800CD181851A), UINT64_C(0x104BD984990E6F05)},
+    {UINT64_C(0x4FC400148268D4F5), UINT64_C(0x1A12F5A0F4E3E4D6)},
+    {UINT64_C(0xD96999AA01ED772B), UINT64_C(0x14DBF7B3F71CB711)},
+    {UINT64_C(0xADEE1488018AC5BC), UINT64_C(0x10AFF95CC5B09274)},
+    {UINT64_C(0x497CEDA668DE092C), UINT64_C(0x1AB328946F80EA54)},
+    {UINT64_C(0x3ACA57B853E4D424), UINT64_C(0x155C2076BF9A5510)},
+    {UINT64_C(0x623B7960431D7683), UINT64_C(0x1116805EFFAEAA73)},
+    {UINT64_C(0x9D2BF566D1C8BD9E), UINT64_C(0x1B5733CB32B110B8)},
+    {UINT64_C(0x7DBCC452416D647F), UINT64_C(0x15DF5CA28EF40D60)},
+    {UINT64_C(0xCAFD69DB678AB6CC), UINT64_C(0x117F7D4ED8C33DE6)},
+    {UINT64_C(0xAB2F0FC572778ADF), UINT64_C(0x1BFF2EE48E052FD7)},
+    {UINT64_C(0x88F273045B92D580), UINT64_C(0x1665BF1D3E6A8CAC)},
+    {UINT64_C(0xD3F528D049424466), UINT64_C(0x11EAFF4A98553D56)},
+    {UINT64_C(0xB988414D4203A0A3), UINT64_C(0x1CAB3210F3BB9557)},
+    {UINT64_C(0x6139CDD76802E6E9), UINT64_C(0x16EF5B40C2FC7779)},
+    {UINT64_C(0xE761717920025254), UINT64_C(0x125915CD68C9F92D)},
+    {UINT64_C(0xA568B58E999D5086), UINT64_C(0x1D5B561574765B7C)},
+    {UINT64_C(0x5120913EE14AA6D2), UINT64_C(0x177C44DDF6C515FD)},
+    {UINT64_C(0xA74D40FF1AA21F0E), UINT64_C(0x12C9D0B1923744CA)},
+    {UINT64_C(0x0BAECE64F769CB4A), UINT64_C(0x1E0FB44F50586E11)},
+    {UINT64_C(0x3C8BD850C5EE3C3B), UINT64_C(0x180C903F7379F1A7)},
+    {UINT64_C(0xCA0979DA37F1C9C9), UINT64_C(0x133D4032C2C7F485)},
+    {UINT64_C(0xA9A8C2F6BFE942DB), UINT64_C(0x1EC866B79E0CBA6F)},
+    {UINT64_C(0x2153CF2BCCBA9BE3), UINT64_C(0x18A0522C7E709526)},
+    {UINT64_C(0x1AA9728970954982), UINT64_C(0x13B374F06526DDB8)},
+    {UINT64_C(0xF775840F1A88759D), UINT64_C(0x1F8587E7083E2F8C)},
+    {UINT64_C(0x5F9136727BA05E17), UINT64_C(0x19379FEC0698260A)},
+    {UINT64_C(0x1940F85B9619E4DF), UINT64_C(0x142C7FF0054684D5)},
+    {UINT64_C(0xE100C6AFAB47EA4C), UINT64_C(0x1023998CD1053710)},
+    {UINT64_C(0xCE67A44C453FDD47), UINT64_C(0x19D28F47B4D524E7)},
+    {UINT64_C(0xD852E9D69DCCB106), UINT64_C(0x14A8729FC3DDB71F)},
+    {UINT64_C(0x79DBEE454B0A2738), UINT64_C(0x1086C219697E2C19)},
+    {UINT64_C(0x295FE3A211A9D859), UINT64_C(0x1A71368F0F30468F)},
+    {UINT64_C(0xBAB31C81A7BB137A), UINT64_C(0x15275ED8D8F36BA5)},
+    {UINT64_C(0x6228E39AEC95A92F), UINT64_C(0x10EC4BE0AD8F8951)},
+    {UINT64_C(0x9D0E38F7E0EF7517), UINT64_C(0x1B13AC9AAF4C0EE8)},
+    {UINT64_C(0xB0D82D931A592A79), UINT64_C(0x15A956E225D67253)},
+    {UINT64_C(0x8D79BE0F4847552E), UINT64_C(0x11544581B7DEC1DC)},
+    {UINT64_C(0x158F967EDA0BBB7C), UINT64_C(0x1BBA08CF8C979C94)},
+    {UINT64_C(0x77A611FF14D62F97), UINT64_C(0x162E6D72D6DFB076)},
+    {UINT64_C(0xF951A7FF43DE8C79), UINT64_C(0x11BEBDF578B2F391)},
+    {UINT64_C(0xC21C3FFED2FDAD8E), UINT64_C(0x1C6463225AB7EC1C)},
+    {UINT64_C(0x01B0333242648AD8), UINT64_C(0x16B6B5B5155FF017)},
+    {UINT64_C(0x0159C28E9B83A246), UINT64_C(0x122BC490DDE659AC)},
+    {UINT64_C(0xCEF604175F3903A3), UINT64_C(0x1D12D41AFCA3C2AC)},
+    {UINT64_C(0x725E69AC4C2D9C83), UINT64_C(0x17424348CA1C9BBD)},
+    {UINT64_C(0xF5185489D68AE39C), UINT64_C(0x129B69070816E2FD)},
+    {UINT64_C(0xEE8D540FBDAB05C6), UINT64_C(0x1DC574D80CF16B2F)},
+    {UINT64_C(0xBED77672FE226B05), UINT64_C(0x17D12A4670C1228C)},
+    {UINT64_C(0xFF12C528CB4EBC04), UINT64_C(0x130DBB6B8D674ED6)},
+    {UINT64_C(0xCB513B74787DF9A0), UINT64_C(0x1E7C5F127BD87E24)},
+    {UINT64_C(0x090DC929F9FE614D), UINT64_C(0x18637F41FCAD31B7)},
+    {UINT64_C(0xA0D7D42194CB810A), UINT64_C(0x1382CC34CA2427C5)},
+    {UINT64_C(0x67BFB9CF5478CE77), UINT64_C(0x1F37AD21436D0C6F)},
+    {UINT64_C(0x1FCC94A5DD2D71F9), UINT64_C(0x18F9574DCF8A7059)},
+    {UINT64_C(0x7FD6DD517DBDF4C7), UINT64_C(0x13FAAC3E3FA1F37A)},
+    {UINT64_C(0xFFBE2EE8C92FEE0B), UINT64_C(0x1FF779FD329CB8C3)},
+    {UINT64_C(0x6631BF20A0F324D6), UINT64_C(0x1992C7FDC216FA36)},
+    {UINT64_C(0xB827CC1A1A5C1D78), UINT64_C(0x14756CCB01ABFB5E)},
+    {UINT64_C(0x935309AE7B7CE460), UINT64_C(0x105DF0A267BCC918)},
+    {UINT64_C(0x1EEB42B0C594A099), UINT64_C(0x1A2FE76A3F9474F4)},
+    {UINT64_C(0xE58902270476E6E1), UINT64_C(0x14F31F8832DD2A5C)},
+    {UINT64_C(0xB7A0CE859D2BEBE7), UINT64_C(0x10C27FA028B0EEB0)},
+    {UINT64_C(0x59014A6F61DFDFD8), UINT64_C(0x1AD0CC33744E4AB4)},
+    {UINT64_C(0xE0CDD525E7E64CAD), UINT64_C(0x1573D68F903EA229)},
+    {UINT64_C(0x4D7177518651D6F1), UINT64_C(0x11297872D9CBB4EE)},
+    {UINT64_C(0x7BE8BEE8D6E957E8), UINT64_C(0x1B758D848FAC54B0)},
+    {UINT64_C(0xFCBA3253DF211320), UINT64_C(0x15F7A46A0C89DD59)},
+    {UINT64_C(0x63C8284318E74280), UINT64_C(0x1192E9EE706E4AAE)},
+    {UINT64_C(0x060D0D3827D86A66), UINT64_C(0x1C1E43171A4A1117)},
+    {UINT64_C(0x6B3DA42CECAD21EB), UINT64_C(0x167E9C127B6E7412)},
+    {UINT64_C(0x88FE1CF0BD574E56), UINT64_C(0x11FEE341FC585CDB)},
+    {UINT64_C(0x419694B462254A23), UINT64_C(0x1CCB0536608D615F)},
+    {UINT64_C(0x67ABAA29E81DD4E9), UINT64_C(0x1708D0F84D3DE77F)},
+    {UINT64_C(0xB95621BB2017DD87), UINT64_C(0x126D73F9D764B932)},
+    {UINT64_C(0xC223692B668C95A5), UINT64_C(0x1D7BECC2F23AC1EA)},
+    {UINT64_C(0xCE82BA891ED6DE1D), UINT64_C(0x179657025B6234BB)},
+    {UINT64_C(0xA53562074BDF1818), UINT64_C(0x12DEAC01E2B4F6FC)},
+    {UINT64_C(0x3B889CD87964F359), UINT64_C(0x1E3113363787F194)},
+    {UINT64_C(0xFC6D4A46C783F5E1), UINT64_C(0x18274291C6065ADC)},
+    {UINT64_C(0x30576E9F06032B1A), UINT64_C(0x13529BA7D19EAF17)},
+    {UINT64_C(0x1A257DCB3CD1DE90), UINT64_C(0x1EEA92A61C311825)},
+    {UINT64_C(0x481DFE3C30A7E540), UINT64_C(0x18BBA884E35A79B7)},
+    {UINT64_C(0xD34B31C9C0865100), UINT64_C(0x13C9539D82AEC7C5)},
+    {UINT64_C(0x5211E942CDA3B4CD), UINT64_C(0x1FA885C8D117A609)},
+    {UINT64_C(0x74DB21023E1C90A4), UINT64_C(0x19539E3A40DFB807)},
+    {UINT64_C(0xF715B401CB4A0D50), UINT64_C(0x1442E4FB67196005)},
+    {UINT64_C(0xF8DE299B09080AA7), UINT64_C(0x103583FC527AB337)},
+    {UINT64_C(0x8E304291A80CDDD7), UINT64_C(0x19EF3993B72AB859)},
+    {UINT64_C(0x3E8D020E200A4B13), UINT64_C(0x14BF6142F8EEF9E1)},
+    {UINT64_C(0x653D9B3E80083C0F), UINT64_C(0x10991A9BFA58C7E7)},
+    {UINT64_C(0x6EC8F864000D2CE4), UINT64_C(0x1A8E90F9908E0CA5)},
+    {UINT64_C(0x8BD3F9E999A423EA), UINT64_C(0x153EDA614071A3B7)},
+    {UINT64_C(0x3CA994BAE1501CBB), UINT64_C(0x10FF151A99F482F9)},
+    {UINT64_C(0xC775BAC49BB3612B), UINT64_C(0x1B31BB5DC320D18E)},
+    {UINT64_C(0xD2C4956A16291A89), UINT64_C(0x15C162B168E70E0B)},
+    {UINT64_C(0xDBD0778811BA7BA1), UINT64_C(0x11678227871F3E6F)},
+    {UINT64_C(0x2C80BF401C5D929B), UINT64_C(0x1BD8D03F3E9863E6)},
+    {UINT64_C(0xBD33CC3349E47549), UINT64_C(0x16470CFF6546B651)},
+    {UINT64_C(0xCA8FD68F6E505DD4), UINT64_C(0x11D270CC51055EA7)},
+    {UINT64_C(0x4419574BE3B3C953), UINT64_C(0x1C83E7AD4E6EFDD9)},
+    {UINT64_C(0x0347790982F63AA9), UINT64_C(0x16CFEC8AA52597E1)},
+    {UINT64_C(0xCF6C60D468C4FBBA), UINT64_C(0x123FF06EEA847980)},
+    {UINT64_C(0xE57A34870E07F92A), UINT64_C(0x1D331A4B10D3F59A)},
+    {UINT64_C(0x512E906C0B399422), UINT64_C(0x175C1508DA432AE2)},
+    {UINT64_C(0xDA8BA6BCD5C7A9B5), UINT64_C(0x12B010D3E1CF5581)},
+    {UINT64_C(0x90DF712E22D90F87), UINT64_C(0x1DE6815302E5559C)},
+    {UINT64_C(0xDA4C5A8B4F140C6C), UINT64_C(0x17EB9AA8CF1DDE16)},
+    {UINT64_C(0xAEA37BA2A5A9A38A), UINT64_C(0x1322E220A5B17E78)},
+    {UINT64_C(0x7DD25F6AA2A905A9), UINT64_C(0x1E9E369AA2B59727)},
+    {UINT64_C(0x97DB7F888220D154), UINT64_C(0x187E92154EF7AC1F)},
+    {UINT64_C(0x797C6606CE80A777), UINT64_C(0x139874DDD8C6234C)},
+    {UINT64_C(0x8F2D700AE4010BF1), UINT64_C(0x1F5A549627A36BAD)},
+    {UINT64_C(0x0C2459A25000D65A), UINT64_C(0x191510781FB5EFBE)},
+    {UINT64_C(0x701D1481D99A4515), UINT64_C(0x1410D9F9B2F7F2FE)},
+    {UINT64_C(0xC017439B147B6A77), UINT64_C(0x100D7B2E28C65BFE)},
+    {UINT64_C(0xCCF205C4ED9243F2), UINT64_C(0x19AF2B7D0E0A2CCA)},
+    {UINT64_C(0x0A5B37D0BE0E9CC2), UINT64_C(0x148C22CA71A1BD6F)},
+    {UINT64_C(0x0848F973CB3EE3CE), UINT64_C(0x10701BD527B4978C)},
+    {UINT64_C(0xDA0E5BEC78649FB0), UINT64_C(0x1A4CF9550C5425AC)},
+    {UINT64_C(0x7B3EAFF060507FC0), UINT64_C(0x150A6110D6A9B7BD)},
+    {UINT64_C(0x95CBBFF380406633), UINT64_C(0x10D51A73DEEE2C97)},
+    {UINT64_C(0xEFAC665266CD7052), UINT64_C(0x1AEE90B964B04758)},
+    {UINT64_C(0x2623850EB8A459DB), UINT64_C(0x158BA6FAB6F36C47)},
+    {UINT64_C(0x1E82D0D893B6AE49), UINT64_C(0x113C85955F29236C)},
+    {UINT64_C(0xFD9E1AF41F8AB075), UINT64_C(0x1B9408EEFEA838AC)},
+    {UINT64_C(0x97B1AF29B2D559F7), UINT64_C(0x16100725988693BD)},
+    {UINT64_C(0xAC8E25BAF5777B2C), UINT64_C(0x11A66C1E139EDC97)},
+    {UINT64_C(0x7A7D092B2258C513), UINT64_C(0x1C3D79C9B8FE2DBF)},
+    {UINT64_C(0x61FDA0EF4EAD6A76), UINT64_C(0x169794A160CB57CC)},
+    {UINT64_C(0xE7FE1A590BBDEEC5), UINT64_C(0x1212DD4DE7091309)},
+    {UINT64_C(0xA6635D5B45FCB13A), UINT64_C(0x1CEAFBAFD80E84DC)},
+    {UINT64_C(0x851C4AAF6B308DC8), UINT64_C(0x172262F3133ED0B0)},
+    {UINT64_C(0xD0E36EF2BC26D7D4), UINT64_C(0x1281E8C275CBDA26)},
+    {UINT64_C(0xB49F17EAC6A48C86), UINT64_C(0x1D9CA79D894629D7)},
+    {UINT64_C(0x2A18DFEF0550706B), UINT64_C(0x17B08617A104EE46)},
+    {UINT64_C(0x54E0B3259DD9F389), UINT64_C(0x12F39E794D9D8B6B)},
+    {UINT64_C(0x87CDEB6F62F65274), UINT64_C(0x1E5297287C2F4578)},
+    {UINT64_C(0xD30B22BF825EA85D), UINT64_C(0x18421286C9BF6AC6)},
+    {UINT64_C(0x0F3C1BCC684BB9E4), UINT64_C(0x13680ED23AFF889F)},
+    {UINT64_C(0x18602C7A4079296D), UINT64_C(0x1F0CE4839198DA98)},
+    {UINT64_C(0x46B356C833942124), UINT64_C(0x18D71D360E13E213)},
+    {UINT64_C(0x388F78A029434DB6), UINT64_C(0x13DF4A91A4DCB4DC)},
+    {UINT64_C(0x5A7F2766A86BAF8A), UINT64_C(0x1FCBAA82A1612160)},
+    {UINT64_C(0x153285EBB9EFBFA2), UINT64_C(0x196FBB9BB44DB44D)},
+    {UINT64_C(0xAA8ED189618C994E), UINT64_C(0x145962E2F6A4903D)},
+    {UINT64_C(0xEED8A7A11AD6E10C), UINT64_C(0x1047824F2BB6D9CA)},
+    {UINT64_C(0x7E27729B5E249B45), UINT64_C(0x1A0C03B1DF8AF611)},
+    {UINT64_C(0xFE85F549181D4904), UINT64_C(0x14D6695B193BF80D)},
+    {UINT64_C(0xCB9E5DD4134AA0D0), UINT64_C(0x10AB877C142FF9A4)},
+    {UINT64_C(0xDF63C9535211014D), UINT64_C(0x1AAC0BF9B9E65C3A)},
+    {UINT64_C(0x191CA10F74DA6771), UINT64_C(0x15566FFAFB1EB02F)},
+    {UINT64_C(0xADB080D92A4852C1), UINT64_C(0x1111F32F2F4BC025)},
+    {UINT64_C(0x15E7348EAA0D5134), UINT64_C(0x1B4FEB7EB212CD09)},
+    {UINT64_C(0xAB1F5D3EEE710DC4), UINT64_C(0x15D98932280F0A6D)},
+    {UINT64_C(0xBC1917658B8DA49D), UINT64_C(0x117AD428200C0857)},
+    {UINT64_C(0x2CF4F23C127C3A94), UINT64_C(0x1BF7B9D9CCE00D59)},
+    {UINT64_C(0xF0C3F4FCDB969543), UINT64_C(0x165FC7E170B33DE0)},
+    {UINT64_C(0x5A365D9716121103), UINT64_C(0x11E6398126F5CB1A)},
+    {UINT64_C(0x9056FC24F01CE804), UINT64_C(0x1CA38F350B22DE90)},
+    {UINT64_C(0xD9DF301D8CE3ECD0), UINT64_C(0x16E93F5DA2824BA6)},
+    {UINT64_C(0xE17F59B13D8323DA), UINT64_C(0x125432B14ECEA2EB)},
+    {UINT64_C(0x68CBC2B52F38395C), UINT64_C(0x1D53844EE47DD179)},
+    {UINT64_C(0x53D6355DBF602DE3), UINT64_C(0x177603725064A794)},
+    {UINT64_C(0xA9782AB165E68B1C), UINT64_C(0x12C4CF8EA6B6EC76)},
+    {UINT64_C(0x0F26AAB56FD744FA), UINT64_C(0x1E07B27DD78B13F1)},
+    {UINT64_C(0x3F52222ABFDF6A62), UINT64_C(0x18062864AC6F4327)},
+    {UINT64_C(0x65DB4E88997F884E), UINT64_C(0x1338205089F29C1F)},
+    {UINT64_C(0x6FC54A7428CC0D4A), UINT64_C(0x1EC033B40FEA9365)},
+    {UINT64_C(0x596AA1F68709A43B), UINT64_C(0x1899C2F673220F84)},
+    {UINT64_C(0xADEEE7F86C07B696), UINT64_C(0x13AE3591F5B4D936)},
+    {UINT64_C(0x497E3FF3E00C5756), UINT64_C(0x1F7D228322BAF524)},
+    {UINT64_C(0xD464FFF64CD6AC45), UINT64_C(0x1930E868E89590E9)},
+    {UINT64_C(0x4383FFF83D7889D1), UINT64_C(0x14272053ED4473EE)},
+    {UINT64_C(0xCF9CCCC69793A174), UINT64_C(0x101F4D0FF1038FF1)},
+    {UINT64_C(0x7F6147A425B90252), UINT64_C(0x19CBAE7FE805B31C)},
+    {UINT64_C(0xCC4DD2E9B7C7350F), UINT64_C(0x14A2F1FFECD15C16)},
+    {UINT64_C(0x3D0B0F215FD290D9), UINT64_C(0x10825B3323DAB012)},
+    {UINT64_C(0x61AB4B689950E7C1), UINT64_C(0x1A6A2B85062AB350)},
+    {UINT64_C(0x4E22A2BA1440B967), UINT64_C(0x1521BC6A6B555C40)},
+    {UINT64_C(0x0B4EE894DD009453), UINT64_C(0x10E7C9EEBC4449CD)},
+    {UINT64_C(0x1217DA87C800ED51), UINT64_C(0x1B0C764AC6D3A948)},
+    {UINT64_C(0xDB46486CA000BDDA), UINT64_C(0x15A391D56BDC876C)},
+    {UINT64_C(0x490506BD4CCD64AF), UINT64_C(0x114FA7DDEFE39F8A)},
+    {UINT64_C(0xA8080AC87AE23AB1), UINT64_C(0x1BB2A62FE638FF43)},
+    {UINT64_C(0x5339A239FBE82EF4), UINT64_C(0x162884F31E93FF69)},
+    {UINT64_C(0x75C7B4FB2FECF25D), UINT64_C(0x11BA03F5B20FFF87)},
+    {UINT64_C(0x22D92191E647EA2E), UINT64_C(0x1C5CD322B67FFF3F)},
+    {UINT64_C(0xB57A8141850654F2), UINT64_C(0x16B0A8E891FFFF65)},
+    {UINT64_C(0xC4620101373843F5), UINT64_C(0x1226ED86DB3332B7)},
+    {UINT64_C(0x3A366801F1F39FEE), UINT64_C(0x1D0B15A491EB8459)},
+    {UINT64_C(0xFB5EB99B27F6198B), UINT64_C(0x173C115074BC69E0)},
+    {UINT64_C(0x2F7EFAE2865E7AD6), UINT64_C(0x129674405D6387E7)},
+    {UINT64_C(0xE597F7D0D6FD9156), UINT64_C(0x1DBD86CD6238D971)},
+    {UINT64_C(0x8479930D78CADAAB), UINT64_C(0x17CAD23DE82D7AC1)},
+    {UINT64_C(0xD06142712D6F1556), UINT64_C(0x1308A831868AC89A)},
+    {UINT64_C(0x4D686A4EAF182222), UINT64_C(0x1E74404F3DAADA91)},
+    {UINT64_C(0xA453883EF279B4E8), UINT64_C(0x185D003F6488AEDA)},
+    {UINT64_C(0xE9DC6CFF28615D87), UINT64_C(0x137D99CC506D58AE)},
+    {UINT64_C(0xA960AE650D6895A4), UINT64_C(0x1F2F5C7A1A488DE4)},
+    {UINT64_C(0xBAB3BEB73DED4483), UINT64_C(0x18F2B061AEA07183)}
+};
+
+static const Tcl_WideUInt pow5Split[326][2] = {
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1000000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1400000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1900000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1F40000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1388000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x186A000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1E84800000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1312D00000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x17D7840000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1DCD650000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x12A05F2000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x174876E800000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1D1A94A200000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x12309CE540000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x16BCC41E90000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1C6BF52634000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x11C37937E0800000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x16345785D8A00000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1BC16D674EC80000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1158E460913D0000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x15AF1D78B58C4000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1B1AE4D6E2EF5000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x10F0CF064DD59200)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x152D02C7E14AF680)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x1A784379D99DB420)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x108B2A2C28029094)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x14ADF4B7320334B9)},
+    {UINT64_C(0x4000000000000000), UINT64_C(0x19D971E4FE8401E7)},
+    {UINT64_C(0x8800000000000000), UINT64_C(0x1027E72F1F128130)},
+    {UINT64_C(0xAA00000000000000), UINT64_C(0x1431E0FAE6D7217C)},
+    {UINT64_C(0xD480000000000000), UINT64_C(0x193E5939A08CE9DB)},
+    {UINT64_C(0xC9A0000000000000), UINT64_C(0x1F8DEF8808B02452)},
+    {UINT64_C(0xBE04000000000000), UINT64_C(0x13B8B5B5056E16B3)},
+    {UINT64_C(0xAD85000000000000), UINT64_C(0x18A6E32246C99C60)},
+    {UINT64_C(0xD8E6400000000000), UINT64_C(0x1ED09BEAD87C0378)},
+    {UINT64_C(0x878FE80000000000), UINT64_C(0x13426172C74D822B)},
+    {UINT64_C(0x6973E20000000000), UINT64_C(0x1812F9CF7920E2B6)},
+    {UINT64_C(0x03D0DA8000000000), UINT64_C(0x1E17B84357691B64)},
+    {UINT64_C(0x8262889000000000), UINT64_C(0x12CED32A16A1B11E)},
+    {UINT64_C(0x22FB2AB400000000), UINT64_C(0x178287F49C4A1D66)},
+    {UINT64_C(0xABB9F56100000000), UINT64_C(0x1D6329F1C35CA4BF)},
+    {UINT64_C(0xCB54395CA0000000), UINT64_C(0x125DFA371A19E6F7)},
+    {UINT64_C(0xBE2947B3C8000000), UINT64_C(0x16F578C4E0A060B5)},
+    {UINT64_C(0x2DB399A0BA000000), UINT64_C(0x1CB2D6F618C878E3)},
+    {UINT64_C(0xFC90400474400000), UINT64_C(0x11EFC659CF7D4B8D)},
+    {UINT64_C(0x7BB4500591500000), UINT64_C(0x166BB7F0435C9E71)},
+    {UINT64_C(0xDAA16406F5A40000), UINT64_C(0x1C06A5EC5433C60D)},
+    {UINT64_C(0xA8A4DE8459868000), UINT64_C(0x118427B3B4A05BC8)},
+    {UINT64_C(0xD2CE16256FE82000), UINT64_C(0x15E531A0A1C872BA)},
+    {UINT64_C(0x87819BAECBE22800), UINT64_C(0x1B5E7E08CA3A8F69)},
+    {UINT64_C(0xF4B1014D3F6D5900), UINT64_C(0x111B0EC57E6499A1)},
+    {UINT64_C(0x71DD41A08F48AF40), UINT64_C(0x1561D276DDFDC00A)},
+    {UINT64_C(0x0E549208B31ADB10), UINT64_C(0x1ABA4714957D300D)},
+    {UINT64_C(0x28F4DB456FF0C8EA), UINT64_C(0x10B46C6CDD6E3E08)},
+    {UINT64_C(0x33321216CBECFB24), UINT64_C(0x14E1878814C9CD8A)},
+    {UINT64_C(0xBFFE969C7EE839ED), UINT64_C(0x1A19E96A19FC40EC)},
+    {UINT64_C(0xF7FF1E21CF512434), UINT64_C(0x105031E2503DA893)},
+    {UINT64_C(0xF5FEE5AA43256D41), UINT64_C(0x14643E5AE44D12B8)},
+    {UINT64_C(0x337E9F14D3EEC892), UINT64_C(0x197D4DF19D605767)},
+    {UINT64_C(0x005E46DA08EA7AB6), UINT64_C(0x1FDCA16E04B86D41)},
+    {UINT64_C(0xA03AEC4845928CB2), UINT64_C(0x13E9E4E4C2F34448)},
+    {UINT64_C(0xC849A75A56F72FDE), UINT64_C(0x18E45E1DF3B0155A)},
+    {UINT64_C(0x7A5C1130ECB4FBD6), UINT64_C(0x1F1D75A5709C1AB1)},
+    {UINT64_C(0xEC798ABE93F11D65), UINT64_C(0x13726987666190AE)},
+    {UINT64_C(0xA797ED6E38ED64BF), UINT64_C(0x184F03E93FF9F4DA)},
+    {UINT64_C(0x517DE8C9C728BDEF), UINT64_C(0x1E62C4E38FF87211)},
+    {UINT64_C(0xD2EEB17E1C7976B5), UINT64_C(0x12FDBB0E39FB474A)},
+    {UINT64_C(0x87AA5DDDA397D462), UINT64_C(0x17BD29D1C87A191D)},
+    {UINT64_C(0xE994F5550C7DC97B), UINT64_C(0x1DAC74463A989F64)},
+    {UINT64_C(0x11FD195527CE9DED), UINT64_C(0x128BC8ABE49F639F)},
+    {UINT64_C(0xD67C5FAA71C24568), UINT64_C(0x172EBAD6DDC73C86)},
+    {UINT64_C(0x8C1B77950E32D6C2), UINT64_C(0x1CFA698C95390BA8)},
+    {UINT64_C(0x57912ABD28DFC639), UINT64_C(0x121C81F7DD43A749)},
+    {UINT64_C(0xAD75756C7317B7C8), UINT64_C(0x16A3A275D494911B)},
+    {UINT64_C(0x98D2D2C78FDDA5BA), UINT64_C(0x1C4C8B1349B9B562)},
+    {UINT64_C(0x9F83C3BCB9EA8794), UINT64_C(0x11AFD6EC0E14115D)},
+    {UINT64_C(0x0764B4ABE8652979), UINT64_C(0x161BCCA7119915B5)},
+    {UINT64_C(0x493DE1D6E27E73D7), UINT64_C(0x1BA2BFD0D5FF5B22)},
+    {UINT64_C(0x6DC6AD264D8F0866), UINT64_C(0x1145B7E285BF98F5)},
+    {UINT64_C(0xC938586FE0F2CA80), UINT64_C(0x159725DB272F7F32)},
+    {UINT64_C(0x7B866E8BD92F7D20), UINT64_C(0x1AFCEF51F0FB5EFF)},
+    {UINT64_C(0xAD34051767BDAE34), UINT64_C(0x10DE1593369D1B5F)},
+    {UINT64_C(0x9881065D41AD19C1), UINT64_C(0x15159AF804446237)},
+    {UINT64_C(0x7EA147F492186032), UINT64_C(0x1A5B01B605557AC5)},
+    {UINT64_C(0x6F24CCF8DB4F3C1F), UINT64_C(0x1078E111C3556CBB)},
+    {UINT64_C(0x4AEE003712230B27), UINT64_C(0x14971956342AC7EA)},
+    {UINT64_C(0xDDA98044D6ABCDF0), UINT64_C(0x19BCDFABC13579E4)},
+    {UINT64_C(0x0A89F02B062B60B6), UINT64_C(0x10160BCB58C16C2F)},
+    {UINT64_C(0xCD2C6C35C7B638E4), UINT64_C(0x141B8EBE2EF1C73A)},
+    {UINT64_C(0x8077874339A3C71D), UINT64_C(0x1922726DBAAE3909)},
+    {UINT64_C(0xE0956914080CB8E4), UINT64_C(0x1F6B0F092959C74B)},
+    {UINT64_C(0x6C5D61AC8507F38E), UINT64_C(0x13A2E965B9D81C8F)},
+    {UINT64_C(0x4774BA17A649F072), UINT64_C(0x188BA3BF284E23B3)},
+    {UINT64_C(0x1951E89D8FDC6C8F), UINT64_C(0x1EAE8CAEF261ACA0)},
+    {UINT64_C(0x0FD3316279E9C3D9), UINT64_C(0x132D17ED577D0BE4)},
+    {UINT64_C(0x13C7FDBB186434CF), UINT64_C(0x17F85DE8AD5C4EDD)},
+    {UINT64_C(0x58B9FD29DE7D4203), UINT64_C(0x1DF67562D8B36294)},
+    {UINT64_C(0xB7743E3A2B0E4942), UINT64_C(0x12BA095DC7701D9C)},
+    {UINT64_C(0xE5514DC8B5D1DB92), UINT64_C(0x17688BB5394C2503)},
+    {UINT64_C(0xDEA5A13AE3465277), UINT64_C(0x1D42AEA2879F2E44)},
+    {UINT64_C(0x0B2784C4CE0BF38A), UINT64_C(0x1249AD2594C37CEB)},
+    {UINT64_C(0xCDF165F6018EF06D), UINT64_C(0x16DC186EF9F45C25)},
+    {UINT64_C(0x416DBF7381F2AC88), UINT64_C(0x1C931E8AB871732F)},
+    {UINT64_C(0x88E497A83137ABD5), UINT64_C(0x11DBF316B346E7FD)},
+    {UINT64_C(0xEB1DBD923D8596CA), UINT64_C(0x1652EFDC6018A1FC)},
+    {UINT64_C(0x25E52CF6CCE6FC7D), UINT64_C(0x1BE7ABD3781ECA7C)},
+    {UINT64_C(0x97AF3C1A40105DCE), UINT64_C(0x1170CB642B133E8D)},
+    {UINT64_C(0xFD9B0B20D0147542), UINT64_C(0x15CCFE3D35D80E30)},
+    {UINT64_C(0x3D01CDE904199292), UINT64_C(0x1B403DCC834E11BD)},
+    {UINT64_C(0x462120B1A28FFB9B), UINT64_C(0x1108269FD210CB16)},
+    {UINT64_C(0xD7A968DE0B33FA82), UINT64_C(0x154A3047C694FDDB)},
+    {UINT64_C(0xCD93C3158E00F923), UINT64_C(0x1A9CBC59B83A3D52)},
+    {UINT64_C(0xC07C59ED78C09BB6), UINT64_C(0x10A1F5B813246653)},
+    {UINT64_C(0xB09B7068D6F0C2A3), UINT64_C(0x14CA732617ED7FE8)},
+    {UINT64_C(0xDCC24C830CACF34C), UINT64_C(0x19FD0FEF9DE8DFE2)},
+    {UINT64_C(0xC9F96FD1E7EC180F), UINT64_C(0x103E29F5C2B18BED)},
+    {UINT64_C(0x3C77CBC661E71E13), UINT64_C(0x144DB473335DEEE9)},
+    {UINT64_C(0x8B95BEB7FA60E598), UINT64_C(0x1961219000356AA3)},
+    {UINT64_C(0x6E7B2E65F8F91EFE), UINT64_C(0x1FB969F40042C54C)},
+    {UINT64_C(0xC50CFCFFBB9BB35F), UINT64_C(0x13D3E2388029BB4F)},
+    {UINT64_C(0xB6503C3FAA82A037), UINT64_C(0x18C8DAC6A0342A23)},
+    {UINT64_C(0xA3E44B4F95234844), UINT64_C(0x1EFB1178484134AC)},
+    {UINT64_C(0xE66EAF11BD360D2B), UINT64_C(0x135CEAEB2D28C0EB)},
+    {UINT64_C(0xE00A5AD62C839075), UINT64_C(0x183425A5F872F126)},
+    {UINT64_C(0x980CF18BB7A47493), UINT64_C(0x1E412F0F768FAD70)},
+    {UINT64_C(0x5F0816F752C6C8DC), UINT64_C(0x12E8BD69AA19CC66)},
+    {UINT64_C(0xF6CA1CB527787B13), UINT64_C(0x17A2ECC414A03F7F)},
+    {UINT64_C(0xF47CA3E2715699D7), UINT64_C(0x1D8BA7F519C84F5F)},
+    {UINT64_C(0xF8CDE66D86D62026), UINT64_C(0x127748F9301D319B)},
+    {UINT64_C(0xF7016008E88BA830), UINT64_C(0x17151B377C247E02)},
+    {UINT64_C(0xB4C1B80B22AE923C), UINT64_C(0x1CDA62055B2D9D83)},
+    {UINT64_C(0x50F91306F5AD1B65), UINT64_C(0x12087D4358FC8272)},
+    {UINT64_C(0xE53757C8B318623F), UINT64_C(0x168A9C942F3BA30E)},
+    {UINT64_C(0x9E852DBADFDE7ACF), UINT64_C(0x1C2D43B93B0A8BD2)},
+    {UINT64_C(0xA3133C94CBEB0CC1), UINT64_C(0x119C4A53C4E69763)},
+    {UINT64_C(0x8BD80BB9FEE5CFF1), UINT64_C(0x16035CE8B6203D3C)},
+    {UINT64_C(0xAECE0EA87E9F43EE), UINT64_C(0x1B843422E3A84C8B)},
+    {UINT64_C(0x4D40C9294F238A75), UINT64_C(0x1132A095CE492FD7)},
+    {UINT64_C(0x2090FB73A2EC6D12), UINT64_C(0x157F48BB41DB7BCD)},
+    {UINT64_C(0x68B53A508BA78856), UINT64_C(0x1ADF1AEA12525AC0)},
+    {UINT64_C(0x417144725748B536), UINT64_C(0x10CB70D24B7378B8)},
+    {UINT64_C(0x51CD958EED1AE283), UINT64_C(0x14FE4D06DE5056E6)},
+    {UINT64_C(0xE640FAF2A8619B24), UINT64_C(0x1A3DE04895E46C9F)},
+    {UINT64_C(0xEFE89CD7A93D00F7), UINT64_C(0x1066AC2D5DAEC3E3)},
+    {UINT64_C(0xEBE2C40D938C4134), UINT64_C(0x14805738B51A74DC)},
+    {UINT64_C(0x26DB7510F86F5181), UINT64_C(0x19A06D06E2611214)},
+    {UINT64_C(0x9849292A9B4592F1), UINT64_C(0x100444244D7CAB4C)},
+    {UINT64_C(0xBE5B73754216F7AD), UINT64_C(0x1405552D60DBD61F)},
+    {UINT64_C(0xADF25052929CB598), UINT64_C(0x1906AA78B912CBA7)},
+    {UINT64_C(0x996EE4673743E2FF), UINT64_C(0x1F485516E7577E91)},
+    {UINT64_C(0xFFE54EC0828A6DDF), UINT64_C(0x138D352E5096AF1A)},
+    {UINT64_C(0xBFDEA270A32D0957), UINT64_C(0x18708279E4BC5AE1)},
+    {UINT64_C(0x2FD64B0CCBF84BAD), UINT64_C(0x1E8CA3185DEB719A)},
+    {UINT64_C(0x5DE5EEE7FF7B2F4C), UINT64_C(0x1317E5EF3AB32700)},
+    {UINT64_C(0x755F6AA1FF59FB1F), UINT64_C(0x17DDDF6B095FF0C0)},
+    {UINT64_C(0x92B7454A7F3079E7), UINT64_C(0x1DD55745CBB7ECF0)},
+    {UINT64_C(0x5BB28B4E8F7E4C30), UINT64_C(0x12A5568B9F52F416)},
+    {UINT64_C(0xF29F2E22335DDF3C), UINT64_C(0x174EAC2E8727B11B)},
+    {UINT64_C(0xEF46F9AAC035570B), UINT64_C(0x1D22573A28F19D62)},
+    {UINT64_C(0xD58C5C0AB8215667), UINT64_C(0x123576845997025D)},
+    {UINT64_C(0x4AEF730D6629AC01), UINT64_C(0x16C2D4256FFCC2F5)},
+    {UINT64_C(0x9DAB4FD0BFB41701), UINT64_C(0x1C73892ECBFBF3B2)},
+    {UINT64_C(0xA28B11E277D08E60), UINT64_C(0x11C835BD3F7D784F)},
+    {UINT64_C(0x8B2DD65B15C4B1F9), UINT64_C(0x163A432C8F5CD663)},
+    {UINT64_C(0x6DF94BF1DB35DE77), UINT64_C(0x1BC8D3F7B3340BFC)},
+    {UINT64_C(0xC4BBCF772901AB0A), UINT64_C(0x115D847AD000877D)},
+    {UINT64_C(0x35EAC354F34215CD), UINT64_C(0x15B4E5998400A95D)},
+    {UINT64_C(0x8365742A30129B40), UINT64_C(0x1B221EFFE500D3B4)},
+    {UINT64_C(0xD21F689A5E0BA108), UINT64_C(0x10F5535FEF208450)},
+    {UINT64_C(0x06A742C0F58E894A), UINT64_C(0x1532A837EAE8A565)},
+    {UINT64_C(0x4851137132F22B9D), UINT64_C(0x1A7F5245E5A2CEBE)},
+    {UINT64_C(0xED32AC26BFD75B42), UINT64_C(0x108F936BAF85C136)},
+    {UINT64_C(0xA87F57306FCD3212), UINT64_C(0x14B378469B673184)},
+    {UINT64_C(0xD29F2CFC8BC07E97), UINT64_C(0x19E056584240FDE5)},
+    {UINT64_C(0xA3A37C1DD7584F1E), UINT64_C(0x102C35F729689EAF)},
+    {UINT64_C(0x8C8C5B254D2E62E6), UINT64_C(0x14374374F3C2C65B)},
+    {UINT64_C(0x6FAF71EEA079FB9F), UINT64_C(0x1945145230B377F2)},
+    {UINT64_C(0x0B9B4E6A48987A87), UINT64_C(0x1F965966BCE055EF)},
+    {UINT64_C(0x674111026D5F4C94), UINT64_C(0x13BDF7E0360C35B5)},
+    {UINT64_C(0xC111554308B71FBA), UINT64_C(0x18AD75D8438F4322)},
+    {UINT64_C(0x7155AA93CAE4E7A8), UINT64_C(0x1ED8D34E547313EB)},
+    {UINT64_C(0x26D58A9C5ECF10C9), UINT64_C(0x13478410F4C7EC73)},
+    {UINT64_C(0xF08AED437682D4FB), UINT64_C(0x1819651531F9E78F)},
+    {UINT64_C(0xECADA89454238A3A), UINT64_C(0x1E1FBE5A7E786173)},
+    {UINT64_C(0x73EC895CB4963664), UINT64_C(0x12D3D6F88F0B3CE8)},
+    {UINT64_C(0x90E7ABB3E1BBC3FD), UINT64_C(0x1788CCB6B2CE0C22)},
+    {UINT64_C(0x352196A0DA2AB4FD), UINT64_C(0x1D6AFFE45F818F2B)},
+    {UINT64_C(0x0134FE24885AB11E), UINT64_C(0x1262DFEEBBB0F97B)},
+    {UINT64_C(0xC1823DADAA715D65), UINT64_C(0x16FB97EA6A9D37D9)},
+    {UINT64_C(0x31E2CD19150DB4BF), UINT64_C(0x1CBA7DE5054485D0)},
+    {UINT64_C(0x1F2DC02FAD2890F7), UINT64_C(0x11F48EAF234AD3A2)},
+    {UINT64_C(0xA6F9303B9872B535), UINT64_C(0x1671B25AEC1D888A)},
+    {UINT64_C(0x50B77C4A7E8F6282), UINT64_C(0x1C0E1EF1A724EAAD)},
+    {UINT64_C(0x5272ADAE8F199D91), UINT64_C(0x1188D357087712AC)},
+    {UINT64_C(0x670F591A32E004F6), UINT64_C(0x15EB082CCA94D757)},
+    {UINT64_C(0x40D32F60BF980633), UINT64_C(0x1B65CA37FD3A0D2D)},
+    {UINT64_C(0x4883FD9C77BF03E0), UINT64_C(0x111F9E62FE44483C)},
+    {UINT64_C(0x5AA4FD0395AEC4D8), UINT64_C(0x156785FBBDD55A4B)},
+    {UINT64_C(0x314E3C447B1A760E), UINT64_C(0x1AC1677AAD4AB0DE)},
+    {UINT64_C(0xDED0E5AACCF089C9), UINT64_C(0x10B8E0ACAC4EAE8A)},
+    {UINT64_C(0x96851F15802CAC3B), UINT64_C(0x14E718D7D7625A2D)},
+    {UINT64_C(0xFC2666DAE037D74A), UINT64_C(0x1A20DF0DCD3AF0B8)},
+    {UINT64_C(0x9D980048CC22E68E), UINT64_C(0x10548B68A044D673)},
+    {UINT64_C(0x84FE005AFF2BA032), UINT64_C(0x1469AE42C8560C10)},
+    {UINT64_C(0xA63D8071BEF6883E), UINT64_C(0x198419D37A6B8F14)},
+    {UINT64_C(0xCFCCE08E2EB42A4E), UINT64_C(0x1FE52048590672D9)},
+    {UINT64_C(0x21E00C58DD309A70), UINT64_C(0x13EF342D37A407C8)},
+    {UINT64_C(0x2A580F6F147CC10D), UINT64_C(0x18EB0138858D09BA)},
+    {UINT64_C(0xB4EE134AD99BF150), UINT64_C(0x1F25C186A6F04C28)},
+    {UINT64_C(0x7114CC0EC80176D2), UINT64_C(0x137798F428562F99)},
+    {UINT64_C(0xCD59FF127A01D486), UINT64_C(0x18557F31326BBB7F)},
+    {UINT64_C(0xC0B07ED7188249A8), UINT64_C(0x1E6ADEFD7F06AA5F)},
+    {UINT64_C(0xD86E4F466F516E09), UINT64_C(0x1302CB5E6F642A7B)},
+    {UINT64_C(0xCE89E3180B25C98B), UINT64_C(0x17C37E360B3D351A)},
+    {UINT64_C(0x822C5BDE0DEF3BEE), UINT64_C(0x1DB45DC38E0C8261)},
+    {UINT64_C(0xF15BB96AC8B58575), UINT64_C(0x1290BA9A38C7D17C)},
+    {UINT64_C(0x2DB2A7C57AE2E6D2), UINT64_C(0x1734E940C6F9C5DC)},
+    {UINT64_C(0x391F51B6D99BA086), UINT64_C(0x1D022390F8B83753)},
+    {UINT64_C(0x03B3931248014454), UINT64_C(0x1221563A9B732294)},
+    {UINT64_C(0x04A077D6DA019569), UINT64_C(0x16A9ABC9424FEB39)},
+    {UINT64_C(0x45C895CC9081FAC3), UINT64_C(0x1C5416BB92E3E607)},
+    {UINT64_C(0x8B9D5D9FDA513CBA), UINT64_C(0x11B48E353BCE6FC4)},
+    {UINT64_C(0xAE84B507D0E58BE8), UINT64_C(0x1621B1C28AC20BB5)},
+    {UINT64_C(0x1A25E249C51EEEE3), UINT64_C(0x1BAA1E332D728EA3)},
+    {UINT64_C(0xF057AD6E1B33554D), UINT64_C(0x114A52DFFC679925)},
+    {UINT64_C(0x6C6D98C9A2002AA1), UINT64_C(0x159CE797FB817F6F)},
+    {UINT64_C(0x4788FEFC0A803549), UINT64_C(0x1B04217DFA61DF4B)},
+    {UINT64_C(0x0CB59F5D8690214E), UINT64_C(0x10E294EEBC7D2B8F)},
+    {UINT64_C(0xCFE30734E83429A1), UINT64_C(0x151B3A2A6B9C7672)},
+    {UINT64_C(0x83DBC9022241340A), UINT64_C(0x1A6208B50683940F)},
+    {UINT64_C(0xB2695DA15568C086), UINT64_C(0x107D457124123C89)},
+    {UINT64_C(0x1F03B509AAC2F0A7), UINT64_C(0x149C96CD6D16CBAC)},
+    {UINT64_C(0x26C4A24C1573ACD1), UINT64_C(0x19C3BC80C85C7E97)},
+    {UINT64_C(0x783AE56F8D684C03), UINT64_C(0x101A55D07D39CF1E)},
+    {UINT64_C(0x16499ECB70C25F03), UINT64_C(0x1420EB449C8842E6)},
+    {UINT64_C(0x9BDC067E4CF2F6C4), UINT64_C(0x19292615C3AA539F)},
+    {UINT64_C(0x82D3081DE02FB476), UINT64_C(0x1F736F9B3494E887)},
+    {UINT64_C(0xB1C3E512AC1DD0C9), UINT64_C(0x13A825C100DD1154)},
+    {UINT64_C(0xDE34DE57572544FC), UINT64_C(0x18922F31411455A9)},
+    {UINT64_C(0x55C215ED2CEE963B), UINT64_C(0x1EB6BAFD91596B14)},
+    {UINT64_C(0xB5994DB43C151DE5), UINT64_C(0x133234DE7AD7E2EC)},
+    {UINT64_C(0xE2FFA1214B1A655E), UINT64_C(0x17FEC216198DDBA7)},
+    {UINT64_C(0xDBBF89699DE0FEB6), UINT64_C(0x1DFE729B9FF15291)},
+    {UINT64_C(0x2957B5E202AC9F31), UINT64_C(0x12BF07A143F6D39B)},
+    {UINT64_C(0xF3ADA35A8357C6FE), UINT64_C(0x176EC98994F48881)},
+    {UINT64_C(0x70990C31242DB8BD), UINT64_C(0x1D4A7BEBFA31AAA2)},
+    {UINT64_C(0x865FA79EB69C9376), UINT64_C(0x124E8D737C5F0AA5)},
+    {UINT64_C(0xE7F791866443B854), UINT64_C(0x16E230D05B76CD4E)},
+    {UINT64_C(0xA1F575E7FD54A669), UINT64_C(0x1C9ABD04725480A2)},
+    {UINT64_C(0xA53969B0FE54E801), UINT64_C(0x11E0B622C774D065)},
+    {UINT64_C(0x0E87C41D3DEA2202), UINT64_C(0x1658E3AB7952047F)},
+    {UINT64_C(0xD229B5248D64AA82), UINT64_C(0x1BEF1C9657A6859E)},
+    {UINT64_C(0x435A1136D85EEA91), UINT64_C(0x117571DDF6C81383)},
+    {UINT64_C(0x143095848E76A536), UINT64_C(0x15D2CE55747A1864)},
+    {UINT64_C(0x193CBAE5B2144E83), UINT64_C(0x1B4781EAD1989E7D)},
+    {UINT64_C(0x2FC5F4CF8F4CB112), UINT64_C(0x110CB132C2FF630E)},
+    {UINT64_C(0xBBB77203731FDD56), UINT64_C(0x154FDD7F73BF3BD1)},
+    {UINT64_C(0x2AA54E844FE7D4AC), UINT64_C(0x1AA3D4DF50AF0AC6)},
+    {UINT64_C(0xDAA75112B1F0E4EB), UINT64_C(0x10A6650B926D66BB)},
+    {UINT64_C(0xD15125575E6D1E26), UINT64_C(0x14CFFE4E7708C06A)},
+    {UINT64_C(0x85A56EAD360865B0), UINT64_C(0x1A03FDE214CAF085)},
+    {UINT64_C(0x7387652C41C53F8E), UINT64_C(0x10427EAD4CFED653)},
+    {UINT64_C(0x50693E7752368F71), UINT64_C(0x14531E58A03E8BE8)},
+    {UINT64_C(0x64838E1526C4334E), UINT64_C(0x1967E5EEC84E2EE2)},
+    {UINT64_C(0xFDA4719A70754022), UINT64_C(0x1FC1DF6A7A61BA9A)},
+    {UINT64_C(0xDE86C70086494815), UINT64_C(0x13D92BA28C7D14A0)},
+    {UINT64_C(0x162878C0A7DB9A1A), UINT64_C(0x18CF768B2F9C59C9)},
+    {UINT64_C(0x5BB296F0D1D280A1), UINT64_C(0x1F03542DFB83703B)},
+    {UINT64_C(0x194F9E5683239064), UINT64_C(0x1362149CBD322625)},
+    {UINT64_C(0x5FA385EC23EC747E), UINT64_C(0x183A99C3EC7EAFAE)},
+    {UINT64_C(0xF78C67672CE7919D), UINT64_C(0x1E494034E79E5B99)},
+    {UINT64_C(0x3AB7C0A07C10BB02), UINT64_C(0x12EDC82110C2F940)},
+    {UINT64_C(0x4965B0C89B14E9C3), UINT64_C(0x17A93A2954F3B790)},
+    {UINT64_C(0x5BBF1CFAC1DA2433), UINT64_C(0x1D9388B3AA30A574)},
+    {UINT64_C(0xB957721CB92856A0), UINT64_C(0x127C35704A5E6768)},
+    {UINT64_C(0xE7AD4EA3E7726C48), UINT64_C(0x171B42CC5CF60142)},
+    {UINT64_C(0xA198A24CE14F075A), UINT64_C(0x1CE2137F74338193)},
+    {UINT64_C(0x44FF65700CD16498), UINT64_C(0x120D4C2FA8A030FC)},
+    {UINT64_C(0x563F3ECC1005BDBE), UINT64_C(0x16909F3B92C83D3B)},
+    {UINT64_C(0x2BCF0E7F14072D2E), UINT64_C(0x1C34C70A777A4C8A)},
+    {UINT64_C(0x5B61690F6C847C3D), UINT64_C(0x11A0FC668AAC6FD6)},
+    {UINT64_C(0xF239C35347A59B4C), UINT64_C(0x16093B802D578BCB)},
+    {UINT64_C(0xEEC83428198F021F), UINT64_C(0x1B8B8A6038AD6EBE)},
+    {UINT64_C(0x553D20990FF96153), UINT64_C(0x1137367C236C6537)},
+    {UINT64_C(0x2A8C68BF53F7B9A8), UINT64_C(0x1585041B2C477E85)},
+    {UINT64_C(0x752F82EF28F5A812), UINT64_C(0x1AE64521F7595E26)},
+    {UINT64_C(0x093DB1D57999890B), UINT64_C(0x10CFEB353A97DAD8)},
+    {UINT64_C(0x0B8D1E4AD7FFEB4E), UINT64_C(0x1503E602893DD18E)},
+    {UINT64_C(0x8E7065DD8DFFE622), UINT64_C(0x1A44DF832B8D45F1)},
+    {UINT64_C(0xF9063FAA78BFEFD5), UINT64_C(0x106B0BB1FB384BB6)},
+    {UINT64_C(0xB747CF9516EFEBCA), UINT64_C(0x1485CE9E7A065EA4)},
+    {UINT64_C(0xE519C37A5CABE6BD), UINT64_C(0x19A742461887F64D)},
+    {UINT64_C(0xAF301A2C79EB7036), UINT64_C(0x1008896BCF54F9F0)},
+    {UINT64_C(0xDAFC20B798664C43), UINT64_C(0x140AABC6C32A386C)},
+    {UINT64_C(0x11BB28E57E7FDF54), UINT64_C(0x190D56B873F4C688)},
+    {UINT64_C(0x1629F31EDE1FD72A), UINT64_C(0x1F50AC6690F1F82A)},
+    {UINT64_C(0x4DDA37F34AD3E67A), UINT64_C(0x13926BC01A973B1A)},
+    {UINT64_C(0xE150C5F01D88E019), UINT64_C(0x187706B0213D09E0)},
+    {UINT64_C(0x19A4F76C24EB181F), UINT64_C(0x1E94C85C298C4C59)},
+    {UINT64_C(0xB0071AA39712EF13), UINT64_C(0x131CFD3999F7AFB7)},
+    {UINT64_C(0x9C08E14C7CD7AAD8), UINT64_C(0x17E43C8800759BA5)},
+    {UINT64_C(0x030B199F9C0D958E), UINT64_C(0x1DDD4BAA0093028F)},
+    {UINT64_C(0x61E6F003C1887D79), UINT64_C(0x12AA4F4A405BE199)},
+    {UINT64_C(0xBA60AC04B1EA9CD7), UINT64_C(0x1754E31CD072D9FF)},
+    {UINT64_C(0xA8F8D705DE65440D), UINT64_C(0x1D2A1BE4048F907F)},
+    {UINT64_C(0xC99B8663AAFF4A88), UINT64_C(0x123A516E82D9BA4F)},
+    {UINT64_C(0xBC0267FC95BF1D2A), UINT64_C(0x16C8E5CA239028E3)},
+    {UINT64_C(0xAB0301FBBB2EE474), UINT64_C(0x1C7B1F3CAC74331C)},
+    {UINT64_C(0xEAE1E13D54FD4EC9), UINT64_C(0x11CCF385EBC89FF1)},
+    {UINT64_C(0x659A598CAA3CA27B), UINT64_C(0x1640306766BAC7EE)},
+    {UINT64_C(0xFF00EFEFD4CBCB1A), UINT64_C(0x1BD03C81406979E9)},
+    {UINT64_C(0x3F6095F5E4FF5EF0), UINT64_C(0x116225D0C841EC32)},
+    {UINT64_C(0xCF38BB735E3F36AC), UINT64_C(0x15BAAF44FA52673E)},
+    {UINT64_C(0x8306EA5035CF0457), UINT64_C(0x1B295B1638E7010E)},
+    {UINT64_C(0x11E4527221A162B6), UINT64_C(0x10F9D8EDE39060A9)},
+    {UINT64_C(0x565D670EAA09BB64), UINT64_C(0x15384F295C7478D3)},
+    {UINT64_C(0x2BF4C0D2548C2A3D), UINT64_C(0x1A8662F3B3919708)},
+    {UINT64_C(0x1B78F88374D79A66), UINT64_C(0x1093FDD8503AFE65)},
+    {UINT64_C(0x625736A4520D8100), UINT64_C(0x14B8FD4E6449BDFE)},
+    {UINT64_C(0xFAED044D6690E140), UINT64_C(0x19E73CA1FD5C2D7D)},
+    {UINT64_C(0xBCD422B0601A8CC8), UINT64_C(0x103085E53E599C6E)},
+    {UINT64_C(0x6C092B5C78212FFA), UINT64_C(0x143CA75E8DF0038A)},
+    {UINT64_C(0x070B763396297BF8), UINT64_C(0x194BD136316C046D)},
+    {UINT64_C(0x48CE53C07BB3DAF6), UINT64_C(0x1F9EC583BDC70588)},
+    {UINT64_C(0x2D80F4584D5068DA), UINT64_C(0x13C33B72569C6375)},
+    {UINT64_C(0x78E1316E60A48310), UINT64_C(0x18B40A4EEC437C52)}
+};
+
+/*
+ * Table for the conversion of decimal strings to doubles (the Eisel-Lemire
+ * algorithm). pow10Split[q+342] holds the 128 most significant bits of
+ * 5**q, for -342 <= q <= 308, stored as {low 64 bits, high 64 bits}.
+ * Positive powers are truncated; negative ones are rounded up.
+ */
+
+#define LEMIRE_MIN_POW10 (-342)
+#define LEMIRE_MAX_POW10 308
+
+static const Tcl_WideUInt pow10Split[651][2] = {
+    {UINT64_C(0x113FAA2906A13B3F), UINT64_C(0xEEF453D6923BD65A)},
+    {UINT64_C(0x4AC7CA59A424C507), UINT64_C(0x9558B4661B6565F8)},
+    {UINT64_C(0x5D79BCF00D2DF649), UINT64_C(0xBAAEE17FA23EBF76)},
+    {UINT64_C(0xF4D82C2C107973DC), UINT64_C(0xE95A99DF8ACE6F53)},
+    {UINT64_C(0x79071B9B8A4BE869), UINT64_C(0x91D8A02BB6C10594)},
+    {UINT64_C(0x9748E2826CDEE284), UINT64_C(0xB64EC836A47146F9)},
+    {UINT64_C(0xFD1B1B2308169B25), UINT64_C(0xE3E27A444D8D98B7)},
+    {UINT64_C(0xFE30F0F5E50E20F7), UINT64_C(0x8E6D8C6AB0787F72)},
+    {UINT64_C(0xBDBD2D335E51A935), UINT64_C(0xB208EF855C969F4F)},
+    {UINT64_C(0xAD2C788035E61382), UINT64_C(0xDE8B2B66B3BC4723)},
+    {UINT64_C(0x4C3BCB5021AFCC31), UINT64_C(0x8B16FB203055AC76)},
+    {UINT64_C(0xDF4ABE242A1BBF3D), UINT64_C(0xADDCB9E83C6B1793)},
+    {UINT64_C(0xD71D6DAD34A2AF0D), UINT64_C(0xD953E8624B85DD78)},
+    {UINT64_C(0x8672648C40E5AD68), UINT64_C(0x87D4713D6F33AA6B)},
+    {UINT64_C(0x680EFDAF511F18C2), UINT64_C(0xA9C98D8CCB009506)},
+    {UINT64_C(0x0212BD1B2566DEF2), UINT64_C(0xD43BF0EFFDC0BA48)},
+    {UINT64_C(0x014BB630F7604B57), UINT64_C(0x84A57695FE98746D)},
+    {UINT64_C(0x419EA3BD35385E2D), UINT64_C(0xA5CED43B7E3E9188)},
+    {UINT64_C(0x52064CAC828675B9), UINT64_C(0xCF42894A5DCE35EA)},
+    {UINT64_C(0x7343EFEBD1940993), UINT64_C(0x818995CE7AA0E1B2)},
+    {UINT64_C(0x1014EBE6C5F90BF8), UINT64_C(0xA1EBFB4219491A1F)},
+    {UINT64_C(0xD41A26E077774EF6), UINT64_C(0xCA66FA129F9B60A6)},
+    {UINT64_C(0x8920B098955522B4), UINT64_C(0xFD00B897478238D0)},
+    {UINT64_C(0x55B46E5F5D5535B0), UINT64_C(0x9E20735E8CB16382)},
+    {UINT64_C(0xEB2189F734AA831D), UINT64_C(0xC5A890362FDDBC62)},
+    {UINT64_C(0xA5E9EC7501D523E4), UINT64_C(0xF712B443BBD52B7B)},
+    {UINT64_C(0x47B233C92125366E), UINT64_C(0x9A6BB0AA55653B2D)},
+    {UINT64_C(0x999EC0BB696E840A), UINT64_C(0xC1069CD4EABE89F8)},
+    {UINT64_C(0xC00670EA43CA250D), UINT64_C(0xF148440A256E2C76)},
+    {UINT64_C(0x380406926A5E5728), UINT64_C(0x96CD2A865764DBCA)},
+    {UINT64_C(0xC605083704F5ECF2), UINT64_C(0xBC807527ED3E12BC)},
+    {UINT64_C(0xF7864A44C633682E), UINT64_C(0xEBA09271E88D976B)},
+    {UINT64_C(0x7AB3EE6AFBE0211D), UINT64_C(0x93445B8731587EA3)},
+    {UINT64_C(0x5960EA05BAD82964), UINT64_C(0xB8157268FDAE9E4C)},
+    {UINT64_C(0x6FB92487298E33BD), UINT64_C(0xE61ACF033D1A45DF)},
+    {UINT64_C(0xA5D3B6D479F8E056), UINT64_C(0x8FD0C16206306BAB)},
+    {UINT64_C(0x8F48A4899877186C), UINT64_C(0xB3C4F1BA87BC8696)},
+    {UINT64_C(0x331ACDABFE94DE87), UINT64_C(0xE0B62E2929ABA83C)},
+    {UINT64_C(0x9FF0C08B7F1D0B14), UINT64_C(0x8C71DCD9BA0B4925)},
+    {UINT64_C(0x07ECF0AE5EE44DD9), UINT64_C(0xAF8E5410288E1B6F)},
+    {UINT64_C(0xC9E82CD9F69D6150), UINT64_C(0xDB71E91432B1A24A)},
+    {UINT64_C(0xBE311C083A225CD2), UINT64_C(0x892731AC9FAF056E)},
+    {UINT64_C(0x6DBD630A48AAF406), UINT64_C(0xAB70FE17C79AC6CA)},
+    {UINT64_C(0x092CBBCCDAD5B108), UINT64_C(0xD64D3D9DB981787D)},
+    {UINT64_C(0x25BBF56008C58EA5), UINT64_C(0x85F0468293F0EB4E)},
+    {UINT64_C(0xAF2AF2B80AF6F24E), UINT64_C(0xA76C582338ED2621)},
+    {UINT64_C(0x1AF5AF660DB4AEE1), UINT64_C(0xD1476E2C07286FAA)},
+    {UINT64_C(0x50D98D9FC890ED4D), UINT64_C(0x82CCA4DB847945CA)},
+    {UINT64_C(0xE50FF107BAB528A0), UINT64_C(0xA37FCE126597973C)},
+    {UINT64_C(0x1E53ED49A96272C8), UINT64_C(0xCC5FC196FEFD7D0C)},
+    {UINT64_C(0x25E8E89C13BB0F7A), UINT64_C(0xFF77B1FCBEBCDC4F)},
+    {UINT64_C(0x77B191618C54E9AC), UINT64_C(0x9FAACF3DF73609B1)},
+    {UINT64_C(0xD59DF5B9EF6A2417), UINT64_C(0xC795830D75038C1D)},
+    {UINT64_C(0x4B0573286B44AD1D), UINT64_C(0xF97AE3D0D2446F25)},
+    {UINT64_C(0x4EE367F9430AEC32), UINT64_C(0x9BECCE62836AC577)},
+    {UINT64_C(0x229C41F793CDA73F), UINT64_C(0xC2E801FB244576D5)},
+    {UINT64_C(0x6B43527578C1110F), UINT64_C(0xF3A20279ED56D48A)},
+    {UINT64_C(0x830A13896B78AAA9), UINT64_C(0x9845418C345644D6)},
+    {UINT64_C(0x23CC986BC656D553), UINT64_C(0xBE5691EF416BD60C)},
+    {UINT64_C(0x2CBFBE86B7EC8AA8), UINT64_C(0xEDEC366B11C6CB8F)},
+    {UINT64_C(0x7BF7D71432F3D6A9), UINT64_C(0x94B3A202EB1C3F39)},
+    {UINT64_C(0xDAF5CCD93FB0CC53), UINT64_C(0xB9E08A83A5E34F07)},
+    {UINT64_C(0xD1B3400F8F9CFF68), UINT64_C(0xE858AD248F5C22C9)},
+    {UINT64_C(0x23100809B9C21FA1), UINT64_C(0x91376C36D99995BE)},
+    {UINT64_C(0xABD40A0C2832A78A), UINT64_C(0xB58547448FFFFB2D)},
+    {UINT64_C(0x16C90C8F323F516C), UINT64_C(0xE2E69915B3FFF9F9)},
+    {UINT64_C(0xAE3DA7D97F6792E3), UINT64_C(0x8DD01FAD907FFC3B)},
+    {UINT64_C(0x99CD11CFDF41779C), UINT64_C(0xB1442798F49FFB4A)},
+    {UINT64_C(0x40405643D711D583), UINT64_C(0xDD95317F31C7FA1D)},
+    {UINT64_C(0x482835EA666B2572), UINT64_C(0x8A7D3EEF7F1CFC52)},
+    {UINT64_C(0xDA3243650005EECF), UINT64_C(0xAD1C8EAB5EE43B66)},
+    {UINT64_C(0x90BED43E40076A82), UINT64_C(0xD863B256369D4A40)},
+    {UINT64_C(0x5A7744A6E804A291), UINT64_C(0x873E4F75E2224E68)},
+    {UINT64_C(0x711515D0A205CB36), UINT64_C(0xA90DE3535AAAE202)},
+    {UINT64_C(0x0D5A5B44CA873E03), UINT64_C(0xD3515C2831559A83)},
+    {UINT64_C(0xE858790AFE9486C2), UINT64_C(0x8412D9991ED58091)},
+    {UINT64_C(0x626E974DBE39A872), UINT64_C(0xA5178FFF668AE0B6)},
+    {UINT64_C(0xFB0A3D212DC8128F), UINT64_C(0xCE5D73FF402D98E3)},
+    {UINT64_C(0x7CE66634BC9D0B99), UINT64_C(0x80FA687F881C7F8E)},
+    {UINT64_C(0x1C1FFFC1EBC44E80), UINT64_C(0xA139029F6A239F72)},
+    {UINT64_C(0xA327FFB266B56220), UINT64_C(0xC987434744AC874E)},
+    {UINT64_C(0x4BF1FF9F0062BAA8), UINT64_C(0xFBE9141915D7A922)},
+    {UINT64_C(0x6F773FC3603DB4A9), UINT64_C(0x9D71AC8FADA6C9B5)},
+    {UINT64_C(0xCB550FB4384D21D3), UINT64_C(0xC4CE17B399107C22)},
+    {UINT64_C(0x7E2A53A146606A48), UINT64_C(0xF6019DA07F549B2B)},
+    {UINT64_C(0x2EDA7444CBFC426D), UINT64_C(0x99C102844F94E0FB)},
+    {UINT64_C(0xFA911155FEFB5308), UINT64_C(0xC0314325637A1939)},
+    {UINT64_C(0x793555AB7EBA27CA), UINT64_C(0xF03D93EEBC589F88)},
+    {UINT64_C(0x4BC1558B2F3458DE), UINT64_C(0x96267C7535B763B5)},
+    {UINT64_C(0x9EB1AAEDFB016F16), UINT64_C(0xBBB01B9283253CA2)},
+    {UINT64_C(0x465E15A979C1CADC), UINT64_C(0xEA9C227723EE8BCB)},
+    {UINT64_C(0x0BFACD89EC191EC9), UINT64_C(0x92A1958A7675175F)},
+    {UINT64_C(0xCEF980EC671F667B), UINT64_C(0xB749FAED14125D36)},
+    {UINT64_C(0x82B7E12780E7401A), UINT64_C(0xE51C79A85916F484)},
+    {UINT64_C(0xD1B2ECB8B0908810), UINT64_C(0x8F31CC0937AE58D2)},
+    {UINT64_C(0x861FA7E6DCB4AA15), UINT64_C(0xB2FE3F0B8599EF07)},
+    {UINT64_C(0x67A791E093E1D49A), UINT64_C(0xDFBDCECE67006AC9)},
+    {UINT64_C(0xE0C8BB2C5C6D24E0), UINT64_C(0x8BD6A141006042BD)},
+    {UINT64_C(0x58FAE9F773886E18), UINT64_C(0xAECC49914078536D)},
+    {UINT64_C(0xAF39A475506A899E), UINT64_C(0xDA7F5BF590966848)},
+    {UINT64_C(0x6D8406C952429603), UINT64_C(0x888F99797A5E012D)},
+    {UINT64_C(0xC8E5087BA6D33B83), UINT64_C(0xAAB37FD7D8F58178)},
+    {UINT64_C(0xFB1E4A9A90880A64), UINT64_C(0xD5605FCDCF32E1D6)},
+    {UINT64_C(0x5CF2EEA09A55067F), UINT64_C(0x855C3BE0A17FCD26)},
+    {UINT64_C(0xF42FAA48C0EA481E), UINT64_C(0xA6B34AD8C9DFC06F)},
+    {UINT64_C(0xF13B94DAF124DA26), UINT64_C(0xD0601D8EFC57B08B)},
+    {UINT64_C(0x76C53D08D6B70858), UINT64_C(0x823C12795DB6CE57)},
+    {UINT64_C(0x54768C4B0C64CA6E), UINT64_C(0xA2CB1717B52481ED)},
+    {UINT64_C(0xA9942F5DCF7DFD09), UINT64_C(0xCB7DDCDDA26DA268)},
+    {UINT64_C(0xD3F93B35435D7C4C), UINT64_C(0xFE5D54150B090B02)},
+    {UINT64_C(0xC47BC5014A1A6DAF), UINT64_C(0x9EFA548D26E5A6E1)},
+    {UINT64_C(0x359AB6419CA1091B), UINT64_C(0xC6B8E9B0709F109A)},
+    {UINT64_C(0xC30163D203C94B62), UINT64_C(0xF867241C8CC6D4C0)},
+    {UINT64_C(0x79E0DE63425DCF1D), UINT64_C(0x9B407691D7FC44F8)},
+    {UINT64_C(0x985915FC12F542E4), UINT64_C(0xC21094364DFB5636)},
+    {UINT64_C(0x3E6F5B7B17B2939D), UINT64_C(0xF294B943E17A2BC4)},
+    {UINT64_C(0xA705992CEECF9C42), UINT64_C(0x979CF3CA6CEC5B5A)},
+    {UINT64_C(0x50C6FF782A838353), UINT64_C(0xBD8430BD08277231)},
+    {UINT64_C(0xA4F8BF5635246428), UINT64_C(0xECE53CEC4A314EBD)},
+    {UINT64_C(0x871B7795E136BE99), UINT64_C(0x940F4613AE5ED136)},
+    {UINT64_C(0x28E2557B59846E3F), UINT64_C(0xB913179899F68584)},
+    {UINT64_C(0x331AEADA2FE589CF), UINT64_C(0xE757DD7EC07426E5)},
+    {UINT64_C(0x3FF0D2C85DEF7621), UINT64_C(0x9096EA6F3848984F)},
+    {UINT64_C(0x0FED077A756B53A9), UINT64_C(0xB4BCA50B065ABE63)},
+    {UINT64_C(0xD3E8495912C62894), UINT64_C(0xE1EBCE4DC7F16DFB)},
+    {UINT64_C(0x64712DD7ABBBD95C), UINT64_C(0x8D3360F09CF6E4BD)},
+    {UINT64_C(0xBD8D794D96AACFB3), UINT64_C(0xB080392CC4349DEC)},
+    {UINT64_C(0xECF0D7A0FC5583A0), UINT64_C(0xDCA04777F541C567)},
+    {UINT64_C(0xF41686C49DB57244), UINT64_C(0x89E42CAAF9491B60)},
+    {UINT64_C(0x311C2875C522CED5), UINT64_C(0xAC5D37D5B79B6239)},
+    {UINT64_C(0x7D633293366B828B), UINT64_C(0xD77485CB25823AC7)},
+    {UINT64_C(0xAE5DFF9C02033197), UINT64_C(0x86A8D39EF77164BC)},
+    {UINT64_C(0xD9F57F830283FDFC), UINT64_C(0xA8530886B54DBDEB)},
+    {UINT64_C(0xD072DF63C324FD7B), UINT64_C(0xD267CAA862A12D66)},
+    {UINT64_C(0x4247CB9E59F71E6D), UINT64_C(0x8380DEA93DA4BC60)},
+    {UINT64_C(0x52D9BE85F074E608), UINT64_C(0xA46116538D0DEB78)},
+    {UINT64_C(0x67902E276C921F8B), UINT64_C(0xCD795BE870516656)},
+    {UINT64_C(0x00BA1CD8A3DB53B6), UINT64_C(0x806BD9714632DFF6)},
+    {UINT64_C(0x80E8A40ECCD228A4), UINT64_C(0xA086CFCD97BF97F3)},
+    {UINT64_C(0x6122CD128006B2CD), UINT64_C(0xC8A883C0FDAF7DF0)},
+    {UINT64_C(0x796B805720085F81), UINT64_C(0xFAD2A4B13D1B5D6C)},
+    {UINT64_C(0xCBE3303674053BB0), UINT64_C(0x9CC3A6EEC6311A63)},
+    {UINT64_C(0xBEDBFC4411068A9C), UINT64_C(0xC3F490AA77BD60FC)},
+    {UINT64_C(0xEE92FB5515482D44), UINT64_C(0xF4F1B4D515ACB93B)},
+    {UINT64_C(0x751BDD152D4D1C4A), UINT64_C(0x991711052D8BF3C5)},
+    {UINT64_C(0xD262D45A78A0635D), UINT64_C(0xBF5CD54678EEF0B6)},
+    {UINT64_C(0x86FB897116C87C34), UINT64_C(0xEF340A98172AACE4)},
+    {UINT64_C(0xD45D35E6AE3D4DA0), UINT64_C(0x9580869F0E7AAC0E)},
+    {UINT64_C(0x8974836059CCA109), UINT64_C(0xBAE0A846D2195712)},
+    {UINT64_C(0x2BD1A438703FC94B), UINT64_C(0xE998D258869FACD7)},
+    {UINT64_C(0x7B6306A34627DDCF), UINT64_C(0x91FF83775423CC06)},
+    {UINT64_C(0x1A3BC84C17B1D542), UINT64_C(0xB67F6455292CBF08)},
+    {UINT64_C(0x20CABA5F1D9E4A93), UINT64_C(0xE41F3D6A7377EECA)},
+    {UINT64_C(0x547EB47B7282EE9C), UINT64_C(0x8E938662882AF53E)},
+    {UINT64_C(0xE99E619A4F23AA43), UINT64_C(0xB23867FB2A35B28D)},
+    {UINT64_C(0x6405FA00E2EC94D4), UINT64_C(0xDEC681F9F4C31F31)},
+    {UINT64_C(0xDE83BC408DD3DD04), UINT64_C(0x8B3C113C38F9F37E)},
+    {UINT64_C(0x9624AB50B148D445), UINT64_C(0xAE0B158B4738705E)},
+    {UINT64_C(0x3BADD624DD9B0957), UINT64_C(0xD98DDAEE19068C76)},
+    {UINT64_C(0xE54CA5D70A80E5D6), UINT64_C(0x87F8A8D4CFA417C9)},
+    {UINT64_C(0x5E9FCF4CCD211F4C), UINT64_C(0xA9F6D30A038D1DBC)},
+    {UINT64_C(0x7647C3200069671F), UINT64_C(0xD47487CC8470652B)},
+    {UINT64_C(0x29ECD9F40041E073), UINT64_C(0x84C8D4DFD2C63F3B)},
+    {UINT64_C(0xF468107100525890), UINT64_C(0xA5FB0A17C777CF09)},
+    {UINT64_C(0x7182148D4066EEB4), UINT64_C(0xCF79CC9DB955C2CC)},
+    {UINT64_C(0xC6F14CD848405530), UINT64_C(0x81AC1FE293D599BF)},
+    {UINT64_C(0xB8ADA00E5A506A7C), UINT64_C(0xA21727DB38CB002F)},
+    {UINT64_C(0xA6D90811F0E4851C), UINT64_C(0xCA9CF1D206FDC03B)},
+    {UINT64_C(0x908F4A166D1DA663), UINT64_C(0xFD442E4688BD304A)},
+    {UINT64_C(0x9A598E4E043287FE), UINT64_C(0x9E4A9CEC15763E2E)},
+    {UINT64_C(0x40EFF1E1853F29FD), UINT64_C(0xC5DD44271AD3CDBA)},
+    {UINT64_C(0xD12BEE59E68EF47C), UINT64_C(0xF7549530E188C128)},
+    {UINT64_C(0x82BB74F8301958CE), UINT64_C(0x9A94DD3E8CF578B9)},
+    {UINT64_C(0xE36A52363C1FAF01), UINT64_C(0xC13A148E3032D6E7)},
+    {UINT64_C(0xDC44E6C3CB279AC1), UINT64_C(0xF18899B1BC3F8CA1)},
+    {UINT64_C(0x29AB103A5EF8C0B9), UINT64_C(0x96F5600F15A7B7E5)},
+    {UINT64_C(0x7415D448F6B6F0E7), UINT64_C(0xBCB2B812DB11A5DE)},
+    {UINT64_C(0x111B495B3464AD21), UINT64_C(0xEBDF661791D60F56)},
+    {UINT64_C(0xCAB10DD900BEEC34), UINT64_C(0x936B9FCEBB25C995)},
+    {UINT64_C(0x3D5D514F40EEA742), UINT64_C(0xB84687C269EF3BFB)},
+    {UINT64_C(0x0CB4A5A3112A5112), UINT64_C(0xE65829B3046B0AFA)},
+    {UINT64_C(0x47F0E785EABA72AB), UINT64_C(0x8FF71A0FE2C2E6DC)},
+    {UINT64_C(0x59ED216765690F56), UINT64_C(0xB3F4E093DB73A093)},
+    {UINT64_C(0x306869C13EC3532C), UINT64_C(0xE0F218B8D25088B8)},
+    {UINT64_C(0x1E414218C73A13FB), UINT64_C(0x8C974F7383725573)},
+    {UINT64_C(0xE5D1929EF90898FA), UINT64_C(0xAFBD2350644EEACF)},
+    {UINT64_C(0xDF45F746B74ABF39), UINT64_C(0xDBAC6C247D62A583)},
+    {UINT64_C(0x6B8BBA8C328EB783), UINT64_C(0x894BC396CE5DA772)},
+    {UINT64_C(0x066EA92F3F326564), UINT64_C(0xAB9EB47C81F5114F)},
+    {UINT64_C(0xC80A537B0EFEFEBD), UINT64_C(0xD686619BA27255A2)},
+    {UINT64_C(0xBD06742CE95F5F36), UINT64_C(0x8613FD0145877585)},
+    {UINT64_C(0x2C48113823B73704), UINT64_C(0xA798FC4196E952E7)},
+    {UINT64_C(0xF75A15862CA504C5), UINT64_C(0xD17F3B51FCA3A7A0)},
+    {UINT64_C(0x9A984D73DBE722FB), UINT64_C(0x82EF85133DE648C4)},
+    {UINT64_C(0xC13E60D0D2E0EBBA), UINT64_C(0xA3AB66580D5FDAF5)},
+    {UINT64_C(0x318DF905079926A8), UINT64_C(0xCC963FEE10B7D1B3)},
+    {UINT64_C(0xFDF17746497F7052), UINT64_C(0xFFBBCFE994E5C61F)},
+    {UINT64_C(0xFEB6EA8BEDEFA633), UINT64_C(0x9FD561F1FD0F9BD3)},
+    {UINT64_C(0xFE64A52EE96B8FC0), UINT64_C(0xC7CABA6E7C5382C8)},
+    {UINT64_C(0x3DFDCE7AA3C673B0), UINT64_C(0xF9BD690A1B68637B)},
+    {UINT64_C(0x06BEA10CA65C084E), UINT64_C(0x9C1661A651213E2D)},
+    {UINT64_C(0x486E494FCFF30A62), UINT64_C(0xC31BFA0FE5698DB8)},
+    {UINT64_C(0x5A89DBA3C3EFCCFA), UINT64_C(0xF3E2F893DEC3F126)},
+    {UINT64_C(0xF89629465A75E01C), UINT64_C(0x986DDB5C6B3A76B7)},
+    {UINT64_C(0xF6BBB397F1135823), UINT64_C(0xBE89523386091465)},
+    {UINT64_C(0x746AA07DED582E2C), UINT64_C(0xEE2BA6C0678B597F)},
+    {UINT64_C(0xA8C2A44EB4571CDC), UINT64_C(0x94DB483840B717EF)},
+    {UINT64_C(0x92F34D62616CE413), UINT64_C(0xBA121A4650E4DDEB)},
+    {UINT64_C(0x77B020BAF9C81D17), UINT64_C(0xE896A0D7E51E1566)},
+    {UINT64_C(0x0ACE1474DC1D122E), UINT64_C(0x915E2486EF32CD60)},
+    {UINT64_C(0x0D819992132456BA), UINT64_C(0xB5B5ADA8AAFF80B8)},
+    {UINT64_C(0x10E1FFF697ED6C69), UINT64_C(0xE3231912D5BF60E6)},
+    {UINT64_C(0xCA8D3FFA1EF463C1), UINT64_C(0x8DF5EFABC5979C8F)},
+    {UINT64_C(0xBD308FF8A6B17CB2), UINT64_C(0xB1736B96B6FD83B3)},
+    {UINT64_C(0xAC7CB3F6D05DDBDE), UINT64_C(0xDDD0467C64BCE4A0)},
+    {UINT64_C(0x6BCDF07A423AA96B), UINT64_C(0x8AA22C0DBEF60EE4)},
+    {UINT64_C(0x86C16C98D2C953C6), UINT64_C(0xAD4AB7112EB3929D)},
+    {UINT64_C(0xE871C7BF077BA8B7), UINT64_C(0xD89D64D57A607744)},
+    {UINT64_C(0x11471CD764AD4972), UINT64_C(0x87625F056C7C4A8B)},
+    {UINT64_C(0xD598E40D3DD89BCF), UINT64_C(0xA93AF6C6C79B5D2D)},
+    {UINT64_C(0x4AFF1D108D4EC2C3), UINT64_C(0xD389B47879823479)},
+    {UINT64_C(0xCEDF722A585139BA), UINT64_C(0x843610CB4BF160CB)},
+    {UINT64_C(0xC2974EB4EE658828), UINT64_C(0xA54394FE1EEDB8FE)},
+    {UINT64_C(0x733D226229FEEA32), UINT64_C(0xCE947A3DA6A9273E)},
+    {UINT64_C(0x0806357D5A3F525F), UINT64_C(0x811CCC668829B887)},
+    {UINT64_C(0xCA07C2DCB0CF26F7), UINT64_C(0xA163FF802A3426A8)},
+    {UINT64_C(0xFC89B393DD02F0B5), UINT64_C(0xC9BCFF6034C13052)},
+    {UINT64_C(0xBBAC2078D443ACE2), UINT64_C(0xFC2C3F3841F17C67)},
+    {UINT64_C(0xD54B944B84AA4C0D), UINT64_C(0x9D9BA7832936EDC0)},
+    {UINT64_C(0x0A9E795E65D4DF11), UINT64_C(0xC5029163F384A931)},
+    {UINT64_C(0x4D4617B5FF4A16D5), UINT64_C(0xF64335BCF065D37D)},
+    {UINT64_C(0x504BCED1BF8E4E45), UINT64_C(0x99EA0196163FA42E)},
+    {UINT64_C(0xE45EC2862F71E1D6), UINT64_C(0xC06481FB9BCF8D39)},
+    {UINT64_C(0x5D767327BB4E5A4C), UINT64_C(0xF07DA27A82C37088)},
+    {UINT64_C(0x3A6A07F8D510F86F), UINT64_C(0x964E858C91BA2655)},
+    {UINT64_C(0x890489F70A55368B), UINT64_C(0xBBE226EFB628AFEA)},
+    {UINT64_C(0x2B45AC74CCEA842E), UINT64_C(0xEADAB0ABA3B2DBE5)},
+    {UINT64_C(0x3B0B8BC90012929D), UINT64_C(0x92C8AE6B464FC96F)},
+    {UINT64_C(0x09CE6EBB40173744), UINT64_C(0xB77ADA0617E3BBCB)},
+    {UINT64_C(0xCC420A6A101D0515), UINT64_C(0xE55990879DDCAABD)},
+    {UINT64_C(0x9FA946824A12232D), UINT64_C(0x8F57FA54C2A9EAB6)},
+    {UINT64_C(0x47939822DC96ABF9), UINT64_C(0xB32DF8E9F3546564)},
+    {UINT64_C(0x59787E2B93BC56F7), UINT64_C(0xDFF9772470297EBD)},
+    {UINT64_C(0x57EB4EDB3C55B65A), UINT64_C(0x8BFBEA76C619EF36)},
+    {UINT64_C(0xEDE622920B6B23F1), UINT64_C(0xAEFAE51477A06B03)},
+    {UINT64_C(0xE95FAB368E45ECED), UINT64_C(0xDAB99E59958885C4)},
+    {UINT64_C(0x11DBCB0218EBB414), UINT64_C(0x88B402F7FD75539B)},
+    {UINT64_C(0xD652BDC29F26A119), UINT64_C(0xAAE103B5FCD2A881)},
+    {UINT64_C(0x4BE76D3346F0495F), UINT64_C(0xD59944A37C0752A2)},
+    {UINT64_C(0x6F70A4400C562DDB), UINT64_C(0x857FCAE62D8493A5)},
+    {UINT64_C(0xCB4CCD500F6BB952), UINT64_C(0xA6DFBD9FB8E5B88E)},
+    {UINT64_C(0x7E2000A41346A7A7), UINT64_C(0xD097AD07A71F26B2)},
+    {UINT64_C(0x8ED400668C0C28C8), UINT64_C(0x825ECC24C873782F)},
+    {UINT64_C(0x728900802F0F32FA), UINT64_C(0xA2F67F2DFA90563B)},
+    {UINT64_C(0x4F2B40A03AD2FFB9), UINT64_C(0xCBB41EF979346BCA)},
+    {UINT64_C(0xE2F610C84987BFA8), UINT64_C(0xFEA126B7D78186BC)},
+    {UINT64_C(0x0DD9CA7D2DF4D7C9), UINT64_C(0x9F24B832E6B0F436)},
+    {UINT64_C(0x91503D1C79720DBB), UINT64_C(0xC6EDE63FA05D3143)},
+    {UINT64_C(0x75A44C6397CE912A), UINT64_C(0xF8A95FCF88747D94)},
+    {UINT64_C(0xC986AFBE3EE11ABA), UINT64_C(0x9B69DBE1B548CE7C)},
+    {UINT64_C(0xFBE85BADCE996168), UINT64_C(0xC24452DA229B021B)},
+    {UINT64_C(0xFAE27299423FB9C3), UINT64_C(0xF2D56790AB41C2A2)},
+    {UINT64_C(0xDCCD879FC967D41A), UINT64_C(0x97C560BA6B0919A5)},
+    {UINT64_C(0x5400E987BBC1C920), UINT64_C(0xBDB6B8E905CB600F)},
+    {UINT64_C(0x290123E9AAB23B68), UINT64_C(0xED246723473E3813)},
+    {UINT64_C(0xF9A0B6720AAF6521), UINT64_C(0x9436C0760C86E30B)},
+    {UINT64_C(0xF808E40E8D5B3E69), UINT64_C(0xB94470938FA89BCE)},
+    {UINT64_C(0xB60B1D1230B20E04), UINT64_C(0xE7958CB87392C2C2)},
+    {UINT64_C(0xB1C6F22B5E6F48C2), UINT64_C(0x90BD77F3483BB9B9)},
+    {UINT64_C(0x1E38AEB6360B1AF3), UINT64_C(0xB4ECD5F01A4AA828)},
+    {UINT64_C(0x25C6DA63C38DE1B0), UINT64_C(0xE2280B6C20DD5232)},
+    {UINT64_C(0x579C487E5A38AD0E), UINT64_C(0x8D590723948A535F)},
+    {UINT64_C(0x2D835A9DF0C6D851), UINT64_C(0xB0AF48EC79ACE837)},
+    {UINT64_C(0xF8E431456CF88E65), UINT64_C(0xDCDB1B2798182244)},
+    {UINT64_C(0x1B8E9ECB641B58FF), UINT64_C(0x8A08F0F8BF0F156B)},
+    {UINT64_C(0xE272467E3D222F3F), UINT64_C(0xAC8B2D36EED2DAC5)},
+    {UINT64_C(0x5B0ED81DCC6ABB0F), UINT64_C(0xD7ADF884AA879177)},
+    {UINT64_C(0x98E947129FC2B4E9), UINT64_C(0x86CCBB52EA94BAEA)},
+    {UINT64_C(0x3F2398D747B36224), UINT64_C(0xA87FEA27A539E9A5)},
+    {UINT64_C(0x8EEC7F0D19A03AAD), UINT64_C(0xD29FE4B18E88640E)},
+    {UINT64_C(0x1953CF68300424AC), UINT64_C(0x83A3EEEEF9153E89)},
+    {UINT64_C(0x5FA8C3423C052DD7), UINT64_C(0xA48CEAAAB75A8E2B)},
+    {UINT64_C(0x3792F412CB06794D), UINT64_C(0xCDB02555653131B6)},
+    {UINT64_C(0xE2BBD88BBEE40BD0), UINT64_C(0x808E17555F3EBF11)},
+    {UINT64_C(0x5B6ACEAEAE9D0EC4), UINT64_C(0xA0B19D2AB70E6ED6)},
+    {UINT64_C(0xF245825A5A445275), UINT64_C(0xC8DE047564D20A8B)},
+    {UINT64_C(0xEED6E2F0F0D56712), UINT64_C(0xFB158592BE068D2E)},
+    {UINT64_C(0x55464DD69685606B), UINT64_C(0x9CED737BB6C4183D)},
+    {UINT64_C(0xAA97E14C3C26B886), UINT64_C(0xC428D05AA4751E4C)},
+    {UINT64_C(0xD53DD99F4B3066A8), UINT64_C(0xF53304714D9265DF)},
+    {UINT64_C(0xE546A8038EFE4029), UINT64_C(0x993FE2C6D07B7FAB)},
+    {UINT64_C(0xDE98520472BDD033), UINT64_C(0xBF8FDB78849A5F96)},
+    {UINT64_C(0x963E66858F6D4440), UINT64_C(0xEF73D256A5C0F77C)},
+    {UINT64_C(0xDDE7001379A44AA8), UINT64_C(0x95A8637627989AAD)},
+    {UINT64_C(0x5560C018580D5D52), UINT64_C(0xBB127C53B17EC159)},
+    {UINT64_C(0xAAB8F01E6E10B4A6), UINT64_C(0xE9D71B689DDE71AF)},
+    {UINT64_C(0xCAB3961304CA70E8), UINT64_C(0x9226712162AB070D)},
+    {UINT64_C(0x3D607B97C5FD0D22), UINT64_C(0xB6B00D69BB55C8D1)},
+    {UINT64_C(0x8CB89A7DB77C506A), UINT64_C(0xE45C10C42A2B3B05)},
+    {UINT64_C(0x77F3608E92ADB242), UINT64_C(0x8EB98A7A9A5B04E3)},
+    {UINT64_C(0x55F038B237591ED3), UINT64_C(0xB267ED1940F1C61C)},
+    {UINT64_C(0x6B6C46DEC52F6688), UINT64_C(0xDF01E85F912E37A3)},
+    {UINT64_C(0x2323AC4B3B3DA015), UINT64_C(0x8B61313BBABCE2C6)},
+    {UINT64_C(0xABEC975E0A0D081A), UINT64_C(0xAE397D8AA96C1B77)},
+    {UINT64_C(0x96E7BD358C904A21), UINT64_C(0xD9C7DCED53C72255)},
+    {UINT64_C(0x7E50D64177DA2E54), UINT64_C(0x881CEA14545C7575)},
+    {UINT64_C(0xDDE50BD1D5D0B9E9), UINT64_C(0xAA242499697392D2)},
+    {UINT64_C(0x955E4EC64B44E864), UINT64_C(0xD4AD2DBFC3D07787)},
+    {UINT64_C(0xBD5AF13BEF0B113E), UINT64_C(0x84EC3C97DA624AB4)},
+    {UINT64_C(0xECB1AD8AEACDD58E), UINT64_C(0xA6274BBDD0FADD61)},
+    {UINT64_C(0x67DE18EDA5814AF2), UINT64_C(0xCFB11EAD453994BA)},
+    {UINT64_C(0x80EACF948770CED7), UINT64_C(0x81CEB32C4B43FCF4)},
+    {UINT64_C(0xA1258379A94D028D), UINT64_C(0xA2425FF75E14FC31)},
+    {UINT64_C(0x096EE45813A04330), UINT64_C(0xCAD2F7F5359A3B3E)},
+    {UINT64_C(0x8BCA9D6E188853FC), UINT64_C(0xFD87B5F28300CA0D)},
+    {UINT64_C(0x775EA264CF55347E), UINT64_C(0x9E74D1B791E07E48)},
+    {UINT64_C(0x95364AFE032A819E), UINT64_C(0xC612062576589DDA)},
+    {UINT64_C(0x3A83DDBD83F52205), UINT64_C(0xF79687AED3EEC551)},
+    {UINT64_C(0xC4926A9672793543), UINT64_C(0x9ABE14CD44753B52)},
+    {UINT64_C(0x75B7053C0F178294), UINT64_C(0xC16D9A0095928A27)},
+    {UINT64_C(0x5324C68B12DD6339), UINT64_C(0xF1C90080BAF72CB1)},
+    {UINT64_C(0xD3F6FC16EBCA5E04), UINT64_C(0x971DA05074DA7BEE)},
+    {UINT64_C(0x88F4BB1CA6BCF585), UINT64_C(0xBCE5086492111AEA)},
+    {UINT64_C(0x2B31E9E3D06C32E6), UINT64_C(0xEC1E4A7DB69561A5)},
+    {UINT64_C(0x3AFF322E62439FD0), UINT64_C(0x9392EE8E921D5D07)},
+    {UINT64_C(0x09BEFEB9FAD487C3), UINT64_C(0xB877AA3236A4B449)},
+    {UINT64_C(0x4C2EBE687989A9B4), UINT64_C(0xE69594BEC44DE15B)},
+    {UINT64_C(0x0F9D37014BF60A11), UINT64_C(0x901D7CF73AB0ACD9)},
+    {UINT64_C(0x538484C19EF38C95), UINT64_C(0xB424DC35095CD80F)},
+    {UINT64_C(0x2865A5F206B06FBA), UINT64_C(0xE12E13424BB40E13)},
+    {UINT64_C(0xF93F87B7442E45D4), UINT64_C(0x8CBCCC096F5088CB)},
+    {UINT64_C(0xF78F69A51539D749), UINT64_C(0xAFEBFF0BCB24AAFE)},
+    {UINT64_C(0xB573440E5A884D1C), UINT64_C(0xDBE6FECEBDEDD5BE)},
+    {UINT64_C(0x31680A88F8953031), UINT64_C(0x89705F4136B4A597)},
+    {UINT64_C(0xFDC20D2B36BA7C3E), UINT64_C(0xABCC77118461CEFC)},
+    {UINT64_C(0x3D32907604691B4D), UINT64_C(0xD6BF94D5E57A42BC)},
+    {UINT64_C(0xA63F9A49C2C1B110), UINT64_C(0x8637BD05AF6C69B5)},
+    {UINT64_C(0x0FCF80DC33721D54), UINT64_C(0xA7C5AC471B478423)},
+    {UINT64_C(0xD3C36113404EA4A9), UINT64_C(0xD1B71758E219652B)},
+    {UINT64_C(0x645A1CAC083126EA), UINT64_C(0x83126E978D4FDF3B)},
+    {UINT64_C(0x3D70A3D70A3D70A4), UINT64_C(0xA3D70A3D70A3D70A)},
+    {UINT64_C(0xCCCCCCCCCCCCCCCD), UINT64_C(0xCCCCCCCCCCCCCCCC)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x8000000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xA000000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xC800000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xFA00000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x9C40000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xC350000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xF424000000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x9896800000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xBEBC200000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xEE6B280000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x9502F90000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xBA43B74000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xE8D4A51000000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x9184E72A00000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xB5E620F480000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xE35FA931A0000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x8E1BC9BF04000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xB1A2BC2EC5000000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xDE0B6B3A76400000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x8AC7230489E80000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xAD78EBC5AC620000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xD8D726B7177A8000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x878678326EAC9000)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xA968163F0A57B400)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xD3C21BCECCEDA100)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0x84595161401484A0)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xA56FA5B99019A5C8)},
+    {UINT64_C(0x0000000000000000), UINT64_C(0xCECB8F27F4200F3A)},
+    {UINT64_C(0x4000000000000000), UINT64_C(0x813F3978F8940984)},
+    {UINT64_C(0x5000000000000000), UINT64_C(0xA18F07D736B90BE5)},
+    {UINT64_C(0xA400000000000000), UINT64_C(0xC9F2C9CD04674EDE)},
+    {UINT64_C(0x4D00000000000000), UINT64_C(0xFC6F7C4045812296)},
+    {UINT64_C(0xF020000000000000), UINT64_C(0x9DC5ADA82B70B59D)},
+    {UINT64_C(0x6C28000000000000), UINT64_C(0xC5371912364CE305)},
+    {UINT64_C(0xC732000000000000), UINT64_C(0xF684DF56C3E01BC6)},
+    {UINT64_C(0x3C7F400000000000), UINT64_C(0x9A130B963A6C115C)},
+    {UINT64_C(0x4B9F100000000000), UINT64_C(0xC097CE7BC90715B3)},
+    {UINT64_C(0x1E86D40000000000), UINT64_C(0xF0BDC21ABB48DB20)},
+    {UINT64_C(0x1314448000000000), UINT64_C(0x96769950B50D88F4)},
+    {UINT64_C(0x17D955A000000000), UINT64_C(0xBC143FA4E250EB31)},
+    {UINT64_C(0x5DCFAB0800000000), UINT64_C(0xEB194F8E1AE525FD)},
+    {UINT64_C(0x5AA1CAE500000000), UINT64_C(0x92EFD1B8D0CF37BE)},
+    {UINT64_C(0xF14A3D9E40000000), UINT64_C(0xB7ABC627050305AD)},
+    {UINT64_C(0x6D9CCD05D0000000), UINT64_C(0xE596B7B0C643C719)},
+    {UINT64_C(0xE4820023A2000000), UINT64_C(0x8F7E32CE7BEA5C6F)},
+    {UINT64_C(0xDDA2802C8A800000), UINT64_C(0xB35DBF821AE4F38B)},
+    {UINT64_C(0xD50B2037AD200000), UINT64_C(0xE0352F62A19E306E)},
+    {UINT64_C(0x4526F422CC340000), UINT64_C(0x8C213D9DA502DE45)},
+    {UINT64_C(0x9670B12B7F410000), UINT64_C(0xAF298D050E4395D6)},
+    {UINT64_C(0x3C0CDD765F114000), UINT64_C(0xDAF3F04651D47B4C)},
+    {UINT64_C(0xA5880A69FB6AC800), UINT64_C(0x88D8762BF324CD0F)},
+    {UINT64_C(0x8EEA0D047A457A00), UINT64_C(0xAB0E93B6EFEE0053)},
+    {UINT64_C(0x72A4904598D6D880), UINT64_C(0xD5D238A4ABE98068)},
+    {UINT64_C(0x47A6DA2B7F864750), UINT64_C(0x85A36366EB71F041)},
+    {UINT64_C(0x999090B65F67D924), UINT64_C(0xA70C3C40A64E6C51)},
+    {UINT64_C(0xFFF4B4E3F741CF6D), UINT64_C(0xD0CF4B50CFE20765)},
+    {UINT64_C(0xBFF8F10E7A8921A4), UINT64_C(0x82818F1281ED449F)},
+    {UINT64_C(0xAFF72D52192B6A0D), UINT64_C(0xA321F2D7226895C7)},
+    {UINT64_C(0x9BF4F8A69F764490), UINT64_C(0xCBEA6F8CEB02BB39)},
+    {UINT64_C(0x02F236D04753D5B4), UINT64_C(0xFEE50B7025C36A08)},
+    {UINT64_C(0x01D762422C946590), UINT64_C(0x9F4F2726179A2245)},
+    {UINT64_C(0x424D3AD2B7B97EF5), UINT64_C(0xC722F0EF9D80AAD6)},
+    {UINT64_C(0xD2E0898765A7DEB2), UINT64_C(0xF8EBAD2B84E0D58B)},
+    {UINT64_C(0x63CC55F49F88EB2F), UINT64_C(0x9B934C3B330C8577)},
+    {UINT64_C(0x3CBF6B71C76B25FB), UINT64_C(0xC2781F49FFCFA6D5)},
+    {UINT64_C(0x8BEF464E3945EF7A), UINT64_C(0xF316271C7FC3908A)},
+    {UINT64_C(0x97758BF0E3CBB5AC), UINT64_C(0x97EDD871CFDA3A56)},
+    {UINT64_C(0x3D52EEED1CBEA317), UINT64_C(0xBDE94E8E43D0C8EC)},
+    {UINT64_C(0x4CA7AAA863EE4BDD), UINT64_C(0xED63A231D4C4FB27)},
+    {UINT64_C(0x8FE8CAA93E74EF6A), UINT64_C(0x945E455F24FB1CF8)},
+    {UINT64_C(0xB3E2FD538E122B44), UINT64_C(0xB975D6B6EE39E436)},
+    {UINT64_C(0x60DBBCA87196B616), UINT64_C(0xE7D34C64A9C85D44)},
+    {UINT64_C(0xBC8955E946FE31CD), UINT64_C(0x90E40FBEEA1D3A4A)},
+    {UINT64_C(0x6BABAB6398BDBE41), UINT64_C(0xB51D13AEA4A488DD)},
+    {UINT64_C(0xC696963C7EED2DD1), UINT64_C(0xE264589A4DCDAB14)},
+    {UINT64_C(0xFC1E1DE5CF543CA2), UINT64_C(0x8D7EB76070A08AEC)},
+    {UINT64_C(0x3B25A55F43294BCB), UINT64_C(0xB0DE65388CC8ADA8)},
+    {UINT64_C(0x49EF0EB713F39EBE), UINT64_C(0xDD15FE86AFFAD912)},
+    {UINT64_C(0x6E3569326C784337), UINT64_C(0x8A2DBF142DFCC7AB)},
+    {UINT64_C(0x49C2C37F07965404), UINT64_C(0xACB92ED9397BF996)},
+    {UINT64_C(0xDC33745EC97BE906), UINT64_C(0xD7E77A8F87DAF7FB)},
+    {UINT64_C(0x69A028BB3DED71A3), UINT64_C(0x86F0AC99B4E8DAFD)},
+    {UINT64_C(0xC40832EA0D68CE0C), UINT64_C(0xA8ACD7C0222311BC)},
+    {UINT64_C(0xF50A3FA490C30190), UINT64_C(0xD2D80DB02AABD62B)},
+    {UINT64_C(0x792667C6DA79E0FA), UINT64_C(0x83C7088E1AAB65DB)},
+    {UINT64_C(0x577001B891185938), UINT64_C(0xA4B8CAB1A1563F52)},
+    {UINT64_C(0xED4C0226B55E6F86), UINT64_C(0xCDE6FD5E09ABCF26)},
+    {UINT64_C(0x544F8158315B05B4), UINT64_C(0x80B05E5AC60B6178)},
+    {UINT64_C(0x696361AE3DB1C721), UINT64_C(0xA0DC75F1778E39D6)},
+    {UINT64_C(0x03BC3A19CD1E38E9), UINT64_C(0xC913936DD571C84C)},
+    {UINT64_C(0x04AB48A04065C723), UINT64_C(0xFB5878494ACE3A5F)},
+    {UINT64_C(0x62EB0D64283F9C76), UINT64_C(0x9D174B2DCEC0E47B)},
+    {UINT64_C(0x3BA5D0BD324F8394), UINT64_C(0xC45D1DF942711D9A)},
+    {UINT64_C(0xCA8F44EC7EE36479), UINT64_C(0xF5746577930D6500)},
+    {UINT64_C(0x7E998B13CF4E1ECB), UINT64_C(0x9968BF6ABBE85F20)},
+    {UINT64_C(0x9E3FEDD8C321A67E), UINT64_C(0xBFC2EF456AE276E8)},
+    {UINT64_C(0xC5CFE94EF3EA101E), UINT64_C(0xEFB3AB16C59B14A2)},
+    {UINT64_C(0xBBA1F1D158724A12), UINT64_C(0x95D04AEE3B80ECE5)},
+    {UINT64_C(0x2A8A6E45AE8EDC97), UINT64_C(0xBB445DA9CA61281F)},
+    {UINT64_C(0xF52D09D71A3293BD), UINT64_C(0xEA1575143CF97226)},
+    {UINT64_C(0x593C2626705F9C56), UINT64_C(0x924D692CA61BE758)},
+    {UINT64_C(0x6F8B2FB00C77836C), UINT64_C(0xB6E0C377CFA2E12E)},
+    {UINT64_C(0x0B6DFB9C0F956447), UINT64_C(0xE498F455C38B997A)},
+    {UINT64_C(0x4724BD4189BD5EAC), UINT64_C(0x8EDF98B59A373FEC)},
+    {UINT64_C(0x58EDEC91EC2CB657), UINT64_C(0xB2977EE300C50FE7)},
+    {UINT64_C(0x2F2967B66737E3ED), UINT64_C(0xDF3D5E9BC0F653E1)},
+    {UINT64_C(0xBD79E0D20082EE74), UINT64_C(0x8B865B215899F46C)},
+    {UINT64_C(0xECD8590680A3AA11), UINT64_C(0xAE67F1E9AEC07187)},
+    {UINT64_C(0xE80E6F4820CC9495), UINT64_C(0xDA01EE641A708DE9)},
+    {UINT64_C(0x3109058D147FDCDD), UINT64_C(0x884134FE908658B2)},
+    {UINT64_C(0xBD4B46F0599FD415), UINT64_C(0xAA51823E34A7EEDE)},
+    {UINT64_C(0x6C9E18AC7007C91A), UINT64_C(0xD4E5E2CDC1D1EA96)},
+    {UINT64_C(0x03E2CF6BC604DDB0), UINT64_C(0x850FADC09923329E)},
+    {UINT64_C(0x84DB8346B786151C), UINT64_C(0xA6539930BF6BFF45)},
+    {UINT64_C(0xE612641865679A63), UINT64_C(0xCFE87F7CEF46FF16)},
+    {UINT64_C(0x4FCB7E8F3F60C07E), UINT64_C(0x81F14FAE158C5F6E)},
+    {UINT64_C(0xE3BE5E330F38F09D), UINT64_C(0xA26DA3999AEF7749)},
+    {UINT64_C(0x5CADF5BFD3072CC5), UINT64_C(0xCB090C8001AB551C)},
+    {UINT64_C(0x73D9732FC7C8F7F6), UINT64_C(0xFDCB4FA002162A63)},
+    {UINT64_C(0x2867E7FDDCDD9AFA), UINT64_C(0x9E9F11C4014DDA7E)},
+    {UINT64_C(0xB281E1FD541501B8), UINT64_C(0xC646D63501A1511D)},
+    {UINT64_C(0x1F225A7CA91A4226), UINT64_C(0xF7D88BC24209A565)},
+    {UINT64_C(0x3375788DE9B06958), UINT64_C(0x9AE757596946075F)},
+    {UINT64_C(0x0052D6B1641C83AE), UINT64_C(0xC1A12D2FC3978937)},
+    {UINT64_C(0xC0678C5DBD23A49A), UINT64_C(0xF209787BB47D6B84)},
+    {UINT64_C(0xF840B7BA963646E0), UINT64_C(0x9745EB4D50CE6332)},
+    {UINT64_C(0xB650E5A93BC3D898), UINT64_C(0xBD176620A501FBFF)},
+    {UINT64_C(0xA3E51F138AB4CEBE), UINT64_C(0xEC5D3FA8CE427AFF)},
+    {UINT64_C(0xC66F336C36B10137), UINT64_C(0x93BA47C980E98CDF)},
+    {UINT64_C(0xB80B0047445D4184), UINT64_C(0xB8A8D9BBE123F017)},
+    {UINT64_C(0xA60DC059157491E5), UINT64_C(0xE6D3102AD96CEC1D)},
+    {UINT64_C(0x87C89837AD68DB2F), UINT64_C(0x9043EA1AC7E41392)},
+    {UINT64_C(0x29BABE4598C311FB), UINT64_C(0xB454E4A179DD1877)},
+    {UINT64_C(0xF4296DD6FEF3D67A), UINT64_C(0xE16A1DC9D8545E94)},
+    {UINT64_C(0x1899E4A65F58660C), UINT64_C(0x8CE2529E2734BB1D)},
+    {UINT64_C(0x5EC05DCFF72E7F8F), UINT64_C(0xB01AE745B101E9E4)},
+    {UINT64_C(0x76707543F4FA1F73), UINT64_C(0xDC21A1171D42645D)},
+    {UINT64_C(0x6A06494A791C53A8), UINT64_C(0x899504AE72497EBA)},
+    {UINT64_C(0x0487DB9D17636892), UINT64_C(0xABFA45DA0EDBDE69)},
+    {UINT64_C(0x45A9D2845D3C42B6), UINT64_C(0xD6F8D7509292D603)},
+    {UINT64_C(0x0B8A2392BA45A9B2), UINT64_C(0x865B86925B9BC5C2)},
+    {UINT64_C(0x8E6CAC7768D7141E), UINT64_C(0xA7F26836F282B732)},
+    {UINT64_C(0x3207D795430CD926), UINT64_C(0xD1EF0244AF2364FF)},
+    {UINT64_C(0x7F44E6BD49E807B8), UINT64_C(0x8335616AED761F1F)},
+    {UINT64_C(0x5F16206C9C6209A6), UINT64_C(0xA402B9C5A8D3A6E7)},
+    {UINT64_C(0x36DBA887C37A8C0F), UINT64_C(0xCD036837130890A1)},
+    {UINT64_C(0xC2494954DA2C9789), UINT64_C(0x802221226BE55A64)},
+    {UINT64_C(0xF2DB9BAA10B7BD6C), UINT64_C(0xA02AA96B06DEB0FD)},
+    {UINT64_C(0x6F92829494E5ACC7), UINT64_C(0xC83553C5C8965D3D)},
+    {UINT64_C(0xCB772339BA1F17F9), UINT64_C(0xFA42A8B73ABBF48C)},
+    {UINT64_C(0xFF2A760414536EFB), UINT64_C(0x9C69A97284B578D7)},
+    {UINT64_C(0xFEF5138519684ABA), UINT64_C(0xC38413CF25E2D70D)},
+    {UINT64_C(0x7EB258665FC25D69), UINT64_C(0xF46518C2EF5B8CD1)},
+    {UINT64_C(0xEF2F773FFBD97A61), UINT64_C(0x98BF2F79D5993802)},
+    {UINT64_C(0xAAFB550FFACFD8FA), UINT64_C(0xBEEEFB584AFF8603)},
+    {UINT64_C(0x95BA2A53F983CF38), UINT64_C(0xEEAABA2E5DBF6784)},
+    {UINT64_C(0xDD945A747BF26183), UINT64_C(0x952AB45CFA97A0B2)},
+    {UINT64_C(0x94F971119AEEF9E4), UINT64_C(0xBA756174393D88DF)},
+    {UINT64_C(0x7A37CD5601AAB85D), UINT64_C(0xE912B9D1478CEB17)},
+    {UINT64_C(0xAC62E055C10AB33A), UINT64_C(0x91ABB422CCB812EE)},
+    {UINT64_C(0x577B986B314D6009), UINT64_C(0xB616A12B7FE617AA)},
+    {UINT64_C(0xED5A7E85FDA0B80B), UINT64_C(0xE39C49765FDF9D94)},
+    {UINT64_C(0x14588F13BE847307), UINT64_C(0x8E41ADE9FBEBC27D)},
+    {UINT64_C(0x596EB2D8AE258FC8), UINT64_C(0xB1D219647AE6B31C)},
+    {UINT64_C(0x6FCA5F8ED9AEF3BB), UINT64_C(0xDE469FBD99A05FE3)},
+    {UINT64_C(0x25DE7BB9480D5854), UINT64_C(0x8AEC23D680043BEE)},
+    {UINT64_C(0xAF561AA79A10AE6A), UINT64_C(0xADA72CCC20054AE9)},
+    {UINT64_C(0x1B2BA1518094DA04), UINT64_C(0xD910F7FF28069DA4)},
+    {UINT64_C(0x90FB44D2F05D0842), UINT64_C(0x87AA9AFF79042286)},
+    {UINT64_C(0x353A1607AC744A53), UINT64_C(0xA99541BF57452B28)},
+    {UINT64_C(0x42889B8997915CE8), UINT64_C(0xD3FA922F2D1675F2)},
+    {UINT64_C(0x69956135FEBADA11), UINT64_C(0x847C9B5D7C2E09B7)},
+    {UINT64_C(0x43FAB9837E699095), UINT64_C(0xA59BC234DB398C25)},
+    {UINT64_C(0x94F967E45E03F4BB), UINT64_C(0xCF02B2C21207EF2E)},
+    {UINT64_C(0x1D1BE0EEBAC278F5), UINT64_C(0x8161AFB94B44F57D)},
+    {UINT64_C(0x6462D92A69731732), UINT64_C(0xA1BA1BA79E1632DC)},
+    {UINT64_C(0x7D7B8F7503CFDCFE), UINT64_C(0xCA28A291859BBF93)},
+    {UINT64_C(0x5CDA735244C3D43E), UINT64_C(0xFCB2CB35E702AF78)},
+    {UINT64_C(0x3A0888136AFA64A7), UINT64_C(0x9DEFBF01B061ADAB)},
+    {UINT64_C(0x088AAA1845B8FDD0), UINT64_C(0xC56BAEC21C7A1916)},
+    {UINT64_C(0x8AAD549E57273D45), UINT64_C(0xF6C69A72A3989F5B)},
+    {UINT64_C(0x36AC54E2F678864B), UINT64_C(0x9A3C2087A63F6399)},
+    {UINT64_C(0x84576A1BB416A7DD), UINT64_C(0xC0CB28A98FCF3C7F)},
+    {UINT64_C(0x656D44A2A11C51D5), UINT64_C(0xF0FDF2D3F3C30B9F)},
+    {UINT64_C(0x9F644AE5A4B1B325), UINT64_C(0x969EB7C47859E743)},
+    {UINT64_C(0x873D5D9F0DDE1FEE), UINT64_C(0xBC4665B596706114)},
+    {UINT64_C(0xA90CB506D155A7EA), UINT64_C(0xEB57FF22FC0C7959)},
+    {UINT64_C(0x09A7F12442D588F2), UINT64_C(0x9316FF75DD87CBD8)},
+    {UINT64_C(0x0C11ED6D538AEB2F), UINT64_C(0xB7DCBF5354E9BECE)},
+    {UINT64_C(0x8F1668C8A86DA5FA), UINT64_C(0xE5D3EF282A242E81)},
+    {UINT64_C(0xF96E017D694487BC), UINT64_C(0x8FA475791A569D10)},
+    {UINT64_C(0x37C981DCC395A9AC), UINT64_C(0xB38D92D760EC4455)},
+    {UINT64_C(0x85BBE253F47B1417), UINT64_C(0xE070F78D3927556A)},
+    {UINT64_C(0x93956D7478CCEC8E), UINT64_C(0x8C469AB843B89562)},
+    {UINT64_C(0x387AC8D1970027B2), UINT64_C(0xAF58416654A6BABB)},
+    {UINT64_C(0x06997B05FCC0319E), UINT64_C(0xDB2E51BFE9D0696A)},
+    {UINT64_C(0x441FECE3BDF81F03), UINT64_C(0x88FCF317F22241E2)},
+    {UINT64_C(0xD527E81CAD7626C3), UINT64_C(0xAB3C2FDDEEAAD25A)},
+    {UINT64_C(0x8A71E223D8D3B074), UINT64_C(0xD60B3BD56A5586F1)},
+    {UINT64_C(0xF6872D5667844E49), UINT64_C(0x85C7056562757456)},
+    {UINT64_C(0xB428F8AC016561DB), UINT64_C(0xA738C6BEBB12D16C)},
+    {UINT64_C(0xE13336D701BEBA52), UINT64_C(0xD106F86E69D785C7)},
+    {UINT64_C(0xECC0024661173473), UINT64_C(0x82A45B450226B39C)},
+    {UINT64_C(0x27F002D7F95D0190), UINT64_C(0xA34D721642B06084)},
+    {UINT64_C(0x31EC038DF7B441F4), UINT64_C(0xCC20CE9BD35C78A5)},
+    {UINT64_C(0x7E67047175A15271), UINT64_C(0xFF290242C83396CE)},
+    {UINT64_C(0x0F0062C6E984D386), UINT64_C(0x9F79A169BD203E41)},
+    {UINT64_C(0x52C07B78A3E60868), UINT64_C(0xC75809C42C684DD1)},
+    {UINT64_C(0xA7709A56CCDF8A82), UINT64_C(0xF92E0C3537826145)},
+    {UINT64_C(0x88A66076400BB691), UINT64_C(0x9BBCC7A142B17CCB)},
+    {UINT64_C(0x6ACFF893D00EA435), UINT64_C(0xC2ABF989935DDBFE)},
+    {UINT64_C(0x0583F6B8C4124D43), UINT64_C(0xF356F7EBF83552FE)},
+    {UINT64_C(0xC3727A337A8B704A), UINT64_C(0x98165AF37B2153DE)},
+    {UINT64_C(0x744F18C0592E4C5C), UINT64_C(0xBE1BF1B059E9A8D6)},
+    {UINT64_C(0x1162DEF06F79DF73), UINT64_C(0xEDA2EE1C7064130C)},
+    {UINT64_C(0x8ADDCB5645AC2BA8), UINT64_C(0x9485D4D1C63E8BE7)},
+    {UINT64_C(0x6D953E2BD7173692), UINT64_C(0xB9A74A0637CE2EE1)},
+    {UINT64_C(0xC8FA8DB6CCDD0437), UINT64_C(0xE8111C87C5C1BA99)},
+    {UINT64_C(0x1D9C9892400A22A2), UINT64_C(0x910AB1D4DB9914A0)},
+    {UINT64_C(0x2503BEB6D00CAB4B), UINT64_C(0xB54D5E4A127F59C8)},
+    {UINT64_C(0x2E44AE64840FD61D), UINT64_C(0xE2A0B5DC971F303A)},
+    {UINT64_C(0x5CEAECFED289E5D2), UINT64_C(0x8DA471A9DE737E24)},
+    {UINT64_C(0x7425A83E872C5F47), UINT64_C(0xB10D8E1456105DAD)},
+    {UINT64_C(0xD12F124E28F77719), UINT64_C(0xDD50F1996B947518)},
+    {UINT64_C(0x82BD6B70D99AAA6F), UINT64_C(0x8A5296FFE33CC92F)},
+    {UINT64_C(0x636CC64D1001550B), UINT64_C(0xACE73CBFDC0BFB7B)},
+    {UINT64_C(0x3C47F7E05401AA4E), UINT64_C(0xD8210BEFD30EFA5A)},
+    {UINT64_C(0x65ACFAEC34810A71), UINT64_C(0x8714A775E3E95C78)},
+    {UINT64_C(0x7F1839A741A14D0D), UINT64_C(0xA8D9D1535CE3B396)},
+    {UINT64_C(0x1EDE48111209A050), UINT64_C(0xD31045A8341CA07C)},
+    {UINT64_C(0x934AED0AAB460432), UINT64_C(0x83EA2B892091E44D)},
+    {UINT64_C(0xF81DA84D5617853F), UINT64_C(0xA4E4B66B68B65D60)},
+    {UINT64_C(0x36251260AB9D668E), UINT64_C(0xCE1DE40642E3F4B9)},
+    {UINT64_C(0xC1D72B7C6B426019), UINT64_C(0x80D2AE83E9CE78F3)},
+    {UINT64_C(0xB24CF65B8612F81F), UINT64_C(0xA1075A24E4421730)},
+    {UINT64_C(0xDEE033F26797B627), UINT64_C(0xC94930AE1D529CFC)},
+    {UINT64_C(0x169840EF017DA3B1), UINT64_C(0xFB9B7CD9A4A7443C)},
+    {UINT64_C(0x8E1F289560EE864E), UINT64_C(0x9D412E0806E88AA5)},
+    {UINT64_C(0xF1A6F2BAB92A27E2), UINT64_C(0xC491798A08A2AD4E)},
+    {UINT64_C(0xAE10AF696774B1DB), UINT64_C(0xF5B5D7EC8ACB58A2)},
+    {UINT64_C(0xACCA6DA1E0A8EF29), UINT64_C(0x9991A6F3D6BF1765)},
+    {UINT64_C(0x17FD090A58D32AF3), UINT64_C(0xBFF610B0CC6EDD3F)},
+    {UINT64_C(0xDDFC4B4CEF07F5B0), UINT64_C(0xEFF394DCFF8A948E)},
+    {UINT64_C(0x4ABDAF101564F98E), UINT64_C(0x95F83D0A1FB69CD9)},
+    {UINT64_C(0x9D6D1AD41ABE37F1), UINT64_C(0xBB764C4CA7A4440F)},
+    {UINT64_C(0x84C86189216DC5ED), UINT64_C(0xEA53DF5FD18D5513)},
+    {UINT64_C(0x32FD3CF5B4E49BB4), UINT64_C(0x92746B9BE2F8552C)},
+    {UINT64_C(0x3FBC8C33221DC2A1), UINT64_C(0xB7118682DBB66A77)},
+    {UINT64_C(0x0FABAF3FEAA5334A), UINT64_C(0xE4D5E82392A40515)},
+    {UINT64_C(0x29CB4D87F2A7400E), UINT64_C(0x8F05B1163BA6832D)},
+    {UINT64_C(0x743E20E9EF511012), UINT64_C(0xB2C71D5BCA9023F8)},
+    {UINT64_C(0x914DA9246B255416), UINT64_C(0xDF78E4B2BD342CF6)},
+    {UINT64_C(0x1AD089B6C2F7548E), UINT64_C(0x8BAB8EEFB6409C1A)},
+    {UINT64_C(0xA184AC2473B529B1), UINT64_C(0xAE9672ABA3D0C320)},
+    {UINT64_C(0xC9E5D72D90A2741E), UINT64_C(0xDA3C0F568CC4F3E8)},
+    {UINT64_C(0x7E2FA67C7A658892), UINT64_C(0x8865899617FB1871)},
+    {UINT64_C(0xDDBB901B98FEEAB7), UINT64_C(0xAA7EEBFB9DF9DE8D)},
+    {UINT64_C(0x552A74227F3EA565), UINT64_C(0xD51EA6FA85785631)},
+    {UINT64_C(0xD53A88958F87275F), UINT64_C(0x8533285C936B35DE)},
+    {UINT64_C(0x8A892ABAF368F137), UINT64_C(0xA67FF273B8460356)},
+    {UINT64_C(0x2D2B7569B0432D85), UINT64_C(0xD01FEF10A657842C)},
+    {UINT64_C(0x9C3B29620E29FC73), UINT64_C(0x8213F56A67F6B29B)},
+    {UINT64_C(0x8349F3BA91B47B8F), UINT64_C(0xA298F2C501F45F42)},
+    {UINT64_C(0x241C70A936219A73), UINT64_C(0xCB3F2F7642717713)},
+    {UINT64_C(0xED238CD383AA0110), UINT64_C(0xFE0EFB53D30DD4D7)},
+    {UINT64_C(0xF4363804324A40AA), UINT64_C(0x9EC95D1463E8A506)},
+    {UINT64_C(0xB143C6053EDCD0D5), UINT64_C(0xC67BB4597CE2CE48)},
+    {UINT64_C(0xDD94B7868E94050A), UINT64_C(0xF81AA16FDC1B81DA)},
+    {UINT64_C(0xCA7CF2B4191C8326), UINT64_C(0x9B10A4E5E9913128)},
+    {UINT64_C(0xFD1C2F611F63A3F0), UINT64_C(0xC1D4CE1F63F57D72)},
+    {UINT64_C(0xBC633B39673C8CEC), UINT64_C(0xF24A01A73CF2DCCF)},
+    {UINT64_C(0xD5BE0503E085D813), UINT64_C(0x976E41088617CA01)},
+    {UINT64_C(0x4B2D8644D8A74E18), UINT64_C(0xBD49D14AA79DBC82)},
+    {UINT64_C(0xDDF8E7D60ED1219E), UINT64_C(0xEC9C459D51852BA2)},
+    {UINT64_C(0xCABB90E5C942B503), UINT64_C(0x93E1AB8252F33B45)},
+    {UINT64_C(0x3D6A751F3B936243), UINT64_C(0xB8DA1662E7B00A17)},
+    {UINT64_C(0x0CC512670A783AD4), UINT64_C(0xE7109BFBA19C0C9D)},
+    {UINT64_C(0x27FB2B80668B24C5), UINT64_C(0x906A617D450187E2)},
+    {UINT64_C(0xB1F9F660802DEDF6), UINT64_C(0xB484F9DC9641E9DA)},
+    {UINT64_C(0x5E7873F8A0396973), UINT64_C(0xE1A63853BBD26451)},
+    {UINT64_C(0xDB0B487B6423E1E8), UINT64_C(0x8D07E33455637EB2)},
+    {UINT64_C(0x91CE1A9A3D2CDA62), UINT64_C(0xB049DC016ABC5E5F)},
+    {UINT64_C(0x7641A140CC7810FB), UINT64_C(0xDC5C5301C56B75F7)},
+    {UINT64_C(0xA9E904C87FCB0A9D), UINT64_C(0x89B9B3E11B6329BA)},
+    {UINT64_C(0x546345FA9FBDCD44), UINT64_C(0xAC2820D9623BF429)},
+    {UINT64_C(0xA97C177947AD4095), UINT64_C(0xD732290FBACAF133)},
+    {UINT64_C(0x49ED8EABCCCC485D), UINT64_C(0x867F59A9D4BED6C0)},
+    {UINT64_C(0x5C68F256BFFF5A74), UINT64_C(0xA81F301449EE8C70)},
+    {UINT64_C(0x73832EEC6FFF3111), UINT64_C(0xD226FC195C6A2F8C)},
+    {UINT64_C(0xC831FD53C5FF7EAB), UINT64_C(0x83585D8FD9C25DB7)},
+    {UINT64_C(0xBA3E7CA8B77F5E55), UINT64_C(0xA42E74F3D032F525)},
+    {UINT64_C(0x28CE1BD2E55F35EB), UINT64_C(0xCD3A1230C43FB26F)},
+    {UINT64_C(0x7980D163CF5B81B3), UINT64_C(0x80444B5E7AA7CF85)},
+    {UINT64_C(0xD7E105BCC332621F), UINT64_C(0xA0555E361951C366)},
+    {UINT64_C(0x8DD9472BF3FEFAA7), UINT64_C(0xC86AB5C39FA63440)},
+    {UINT64_C(0xB14F98F6F0FEB951), UINT64_C(0xFA856334878FC150)},
+    {UINT64_C(0x6ED1BF9A569F33D3), UINT64_C(0x9C935E00D4B9D8D2)},
+    {UINT64_C(0x0A862F80EC4700C8), UINT64_C(0xC3B8358109E84F07)},
+    {UINT64_C(0xCD27BB612758C0FA), UINT64_C(0xF4A642E14C6262C8)},
+    {UINT64_C(0x8038D51CB897789C), UINT64_C(0x98E7E9CCCFBD7DBD)},
+    {UINT64_C(0xE0470A63E6BD56C3), UINT64_C(0xBF21E44003ACDD2C)},
+    {UINT64_C(0x1858CCFCE06CAC74), UINT64_C(0xEEEA5D5004981478)},
+    {UINT64_C(0x0F37801E0C43EBC8), UINT64_C(0x95527A5202DF0CCB)},
+    {UINT64_C(0xD30560258F54E6BA), UINT64_C(0xBAA718E68396CFFD)},
+    {UINT64_C(0x47C6B82EF32A2069), UINT64_C(0xE950DF20247C83FD)},
+    {UINT64_C(0x4CDC331D57FA5441), UINT64_C(0x91D28B7416CDD27E)},
+    {UINT64_C(0xE0133FE4ADF8E952), UINT64_C(0xB6472E511C81471D)},
+    {UINT64_C(0x58180FDDD97723A6), UINT64_C(0xE3D8F9E563A198E5)},
+    {UINT64_C(0x570F09EAA7EA7648), UINT64_C(0x8E679C2F5E44FF8F)}
+};
+
 /*
  * Static functions defined in this file.
  */
 
 static int		AccumulateDecimalDigit(unsigned, int,
 			    Tcl_WideUInt *, mp_int *, int);
+static int		ParseEightDigits(const char *p,
+			    Tcl_WideUInt *valuePtr);
+static Tcl_WideUInt	WideMultiply(Tcl_WideUInt a, Tcl_WideUInt b,
+			    Tcl_WideUInt *highPtr);
+#ifdef IEEE_FLOATING_POINT
+static int		EiselLemire(Tcl_WideUInt significand, long exponent,
+			    double *numberPtr);
+#endif
 static double		MakeHighPrecisionDouble(int signum,
 			    mp_int *significand, int nSigDigs, long exponent);
 static double		MakeLowPrecisionDouble(int signum,
@@ -332,6 +1638,9 @@ static void		CastOutPowersOf2(int *, int *, int *);
 static char *		ShorteningInt64Conversion(Double *, Tcl_WideUInt,
 			    int, int, int, int, int, int, int, int, int,
 			    int, int, int *, char **);
+static Tcl_WideUInt	MulShift64(Tcl_WideUInt, const Tcl_WideUInt *, int);
+static int		Pow5Factor(Tcl_WideUInt);
+static char *		ShortestRyuConversion(Double *, int *, char **);
 static char *		StrictInt64Conversion(Tcl_WideUInt,
 			    int, int, int, int, int, int,
 			    int, int, int *, char **);
@@ -537,9 +1846,13 @@ TclParseNumber(
     char d = 0;			/* Last hexadecimal digit scanned; initialized
 				 * to avoid a compiler warning. */
     int shift = 0;		/* Amount to shift when accumulating binary */
+    Tcl_WideUInt eightDigits;	/* Value of a run of eight decimal digits. */
     mp_err err = MP_OKAY;
 
 #define MOST_BITS	(UWIDE_MAX >> 1)
+#define EIGHT_DIGITS_MAX ((UWIDE_MAX - 99999999) / 100000000)
+				/* Largest significand that a run of eight
+				 * more digits cannot overflow. */
 
     /*
      * Initialize bytes to start of the object's string rep if the caller
@@ -984,6 +2297,21 @@ TclParseNumber(
 	    acceptState = state;
 	    acceptPoint = p;
 	    acceptLen = len;
+	    if (numSigDigs > 0 && numTrailZeros == 0 && objPtr != NULL
+		    && !significandOverflow && (len < 0 || len >= 8)
+		    && significandWide <= EIGHT_DIGITS_MAX
+		    && ParseEightDigits(p, &eightDigits)) {
+		/*
+		 * Take a run of eight digits in one step.
+		 */
+
+		significandWide = significandWide * 100000000 + eightDigits;
+		numSigDigs += 8;
+		p += 7;
+		len -= 7;
+		state = DECIMAL;
+		break;
+	    }
 	    if (c == '0') {
 		numTrailZeros++;
 		state = DECIMAL;
@@ -1027,6 +2355,18 @@ TclParseNumber(
 	    /* FALLTHROUGH */
 
 	case LEADING_RADIX_POINT:
+	    if (numSigDigs > 0 && numTrailZeros == 0 && objPtr != NULL
+		    && !significandOverflow && (len < 0 || len >= 8)
+		    && significandWide <= EIGHT_DIGITS_MAX
+		    && ParseEightDigits(p, &eightDigits)) {
+		significandWide = significandWide * 100000000 + eightDigits;
+		numSigDigs += 8;
+		numDigitsAfterDp += 8;
+		p += 7;
+		len -= 7;
+		state = FRACTION;
+		break;
+	    }
 	    if (c == '0') {
 		numDigitsAfterDp++;
 		numTrailZeros++;
@@ -1548,6 +2888,52 @@ TclParseNumber(
     return status;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * ParseEightDigits --
+ *
+ *	Checks whether a string starts with eight decimal digits, and if so,
+ *	computes their value. The digits are gathered one to a byte and
+ *	combined pairwise in three word-wide steps. No byte past the first
+ *	non-digit is examined, so a terminating NUL stops the scan.
+ *
+ * Results:
+ *	Returns 1 and stores the value of the digits in '*valuePtr' if the
+ *	first eight bytes are digits, and 0 otherwise.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static inline int
+ParseEightDigits(
+    const char *p,		/* Digits to convert. */
+    Tcl_WideUInt *valuePtr)	/* OUTPUT: Value of the digits. */
+{
+    Tcl_WideUInt w = 0;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+	unsigned digit = UCHAR(p[i]) - '0';
+
+	if (digit > 9) {
+	    return 0;
+	}
+	w |= (Tcl_WideUInt) digit << (8 * i);
+    }
+
+    /*
+     * The first digit is in the low byte. Merge adjacent bytes into 2-digit
+     * values, then adjacent 16-bit fields into 4-digit values, then the two
+     * halves.
+     */
+
+    w = (w * 10 + (w >> 8)) & UINT64_C(0x00FF00FF00FF00FF);
+    w = (w * 100 + (w >> 16)) & UINT64_C(0x0000FFFF0000FFFF);
+    *valuePtr = (w * 10000 + (w >> 32)) & 0xFFFFFFFF;
+    return 1;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -1658,6 +3044,169 @@ AccumulateDecimalDigit(
     return 1;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * WideMultiply --
+ *
+ *	Forms the full 128-bit product of two 64-bit integers.
+ *
+ * Results:
+ *	Returns the low 64 bits of the product.
+ *
+ * Side effects:
+ *	Stores the high 64 bits of the product in '*highPtr'.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static inline Tcl_WideUInt
+WideMultiply(
+    Tcl_WideUInt a, Tcl_WideUInt b,
+				/* Numbers to multiply. */
+    Tcl_WideUInt *highPtr)	/* OUTPUT: High word of the product. */
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = (unsigned __int128) a * b;
+
+    *highPtr = (Tcl_WideUInt) (product >> 64);
+    return (Tcl_WideUInt) product;
+#else
+    Tcl_WideUInt aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+    Tcl_WideUInt bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+    Tcl_WideUInt ll = aLo * bLo, lh = aLo * bHi;
+    Tcl_WideUInt hl = aHi * bLo, hh = aHi * bHi;
+    Tcl_WideUInt mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+
+    *highPtr = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (ll & 0xFFFFFFFF);
+#endif
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * EiselLemire --
+ *
+ *	Makes the double precision number significand*10**exponent, using
+ *	the algorithm of Michael Eisel and Daniel Lemire ("Number Parsing at
+ *	a Gigabyte per Second", 2021). The significand, normalized to 64 bits,
+ *	is multiplied by the 128 leading bits of 5**exponent from pow10Split;
+ *	the leading 54 bits of the product, with the binary exponent
+ *	estimated from the decimal one, give the correctly rounded result
+ *	unless the truncated bits of the product are too close to a
+ *	halfway point to tell.
+ *
+ * Results:
+ *	Returns 1 and stores the (nonnegative) number in '*numberPtr' if the
+ *	conversion succeeded. Returns 0 if the caller must fall back on
+ *	exact arithmetic, which is also the case for all results that
+ *	underflow to denormals or zero or overflow to infinity, so that
+ *	MakeHighPrecisionDouble keeps its say over the ends of the range.
+ *
+ *----------------------------------------------------------------------
+ */
+
+#ifdef IEEE_FLOATING_POINT
+static inline int
+EiselLemire(
+    Tcl_WideUInt significand,	/* Nonzero significand of the number. */
+    long exponent,		/* Power of ten. */
+    double *numberPtr)		/* OUTPUT: The constructed number. */
+{
+    const Tcl_WideUInt *pow10;	/* 128 leading bits of 5**exponent. */
+    Tcl_WideUInt high, low;	/* Product of the significand and pow10. */
+    Tcl_WideUInt secondHigh;	/* Correction to 'low'. */
+    Tcl_WideUInt mantissa;	/* Significand of the result. */
+    int lz;			/* Leading zero bits of the significand. */
+    int upperBit;		/* Leading bit of the product. */
+    int shift;			/* Bits of the product below the mantissa
+				 * and its rounding bit. */
+    long power2;		/* Biased binary exponent of the result. */
+    union {
+	Tcl_WideUInt iv;
+	double dv;
+    } result;
+
+    if (exponent < LEMIRE_MIN_POW10 || exponent > LEMIRE_MAX_POW10) {
+	return 0;
+    }
+
+    lz = 64 - RequiredPrecision(significand);
+    significand <<= lz;
+    pow10 = pow10Split[exponent - LEMIRE_MIN_POW10];
+    low = WideMultiply(significand, pow10[1], &high);
+
+    /*
+     * If the bits below the mantissa's rounding bit are all ones, the low
+     * word of the power of 5 may yet carry into them.
+     */
+
+    if ((high & 0x1FF) == 0x1FF) {
+	WideMultiply(significand, pow10[0], &secondHigh);
+	low += secondHigh;
+	if (low < secondHigh) {
+	    ++high;
+	}
+	if ((high & 0x1FF) == 0x1FF && low == UWIDE_MAX) {
+	    return 0;
+	}
+    }
+
+    /*
+     * Take the top 54 bits and compute the exponent:
+     * floor(log2(10**exponent)) is (217706*exponent) >> 16.
+     */
+
+    upperBit = (int) (high >> 63);
+    shift = upperBit + 64 - (FP_PRECISION - 1) - 3;
+    mantissa = high >> shift;
+    power2 = ((217706 * exponent) >> 16) + 63 + upperBit - lz
+	    + EXPONENT_BIAS;
+
+    if (power2 <= 0) {
+	/*
+	 * Denormal results, and the underflow to zero, are left to
+	 * MakeHighPrecisionDouble.
+	 */
+
+	return 0;
+    }
+
+    /*
+     * Round half to even. The product can only be exactly halfway between
+     * two doubles if 5**exponent was exact in 128 bits and nothing but
+     * zeroes was dropped from it.
+     */
+
+    if (low <= 1 && exponent >= -4 && exponent <= 23
+	    && (mantissa & 3) == 1 && (mantissa << shift) == high) {
+	mantissa &= ~(Tcl_WideUInt) 1;
+    }
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= (HIDDEN_BIT << 1)) {
+	mantissa = HIDDEN_BIT;
+	++power2;
+    }
+    mantissa &= ~HIDDEN_BIT;
+    if (power2 >= (EXP_MASK >> EXP_SHIFT)) {
+	/*
+	 * So is overflow.
+	 */
+
+	return 0;
+    }
+
+    result.iv = ((Tcl_WideUInt) power2 << (FP_PRECISION - 1)) | mantissa;
+    if (n770_fp) {
+	result.iv = Nokia770Twiddle(result.iv);
+    }
+    *numberPtr = result.dv;
+    return 1;
+}
+#endif
+
 /*
  *----------------------------------------------------------------------
  *
@@ -1756,6 +3305,22 @@ MakeLowPrecisionDouble(
 	}
     }
 
+#ifdef IEEE_FLOATING_POINT
+    /*
+     * The significand is exact, so Eisel-Lemire almost always yields the
+     * correctly rounded result.
+     */
+
+    {
+	double number;
+
+	if (EiselLemire(significand, exponent, &number)) {
+	    retval = number;
+	    goto returnValue;
+	}
+    }
+#endif
+
     /*
      * All the easy cases have failed. Promote the significand to bignum and
      * call MakeHighPrecisionDouble to do it the hard way.
@@ -3253,6 +4818,267 @@ ShorteningInt64Conversion(
     return retval;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * MulShift64 --
+ *
+ *	Multiplies a significand of at most 55 bits by one of the 125-bit
+ *	entries of pow5Split or pow5InvSplit, and shifts the product right by
+ *	'j' bits (64 < j < 128).
+ *
+ * Results:
+ *	Returns the low 64 bits of the shifted product.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static inline Tcl_WideUInt
+MulShift64(
+    Tcl_WideUInt m,		/* Significand to scale. */
+    const Tcl_WideUInt *mul,	/* Multiplier, {low word, high word}. */
+    int j)			/* Shift count. */
+{
+    Tcl_WideUInt high0, high1, low1, sum;
+
+    WideMultiply(m, mul[0], &high0);
+    low1 = WideMultiply(m, mul[1], &high1);
+    sum = high0 + low1;
+    if (sum < high0) {
+	++high1;
+    }
+    return (high1 << (128 - j)) | (sum >> (j - 64));
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * Pow5Factor --
+ *
+ *	Counts the factors of 5 in a nonzero integer.
+ *
+ * Results:
+ *	Returns the largest 'p' such that 5**p divides the integer.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static inline int
+Pow5Factor(
+    Tcl_WideUInt w)		/* Integer to examine. */
+{
+    int p = 0;
+
+    while (w % 5 == 0) {
+	w /= 5;
+	++p;
+    }
+    return p;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * ShortestRyuConversion --
+ *
+ *	Converts a positive, finite double to the shortest string of digits
+ *	that reconverts exactly to it, choosing the closest such string and
+ *	resolving ties to even. This is Ulf Adams's "Ryu" algorithm (PLDI
+ *	2018): the bounds of the rounding interval are scaled by a power of
+ *	ten using the 125-bit tables above, so that the same digits as the
+ *	shortening Steele & White/Gay conversions are found with a couple of
+ *	64-bit multiplies instead of one division per digit.
+ *
+ *	The caller must not pass an exact power of two other than a
+ *	denormal: the rounding interval of such a number is lopsided, and the
+ *	bignum conversions are left to treat it as they always have.
+ *
+ * Results:
+ *	Returns the string of significant decimal digits, in newly allocated
+ *	memory.
+ *
+ * Side effects:
+ *	Stores the location of the decimal point in '*decpt' and the location
+ *	of the terminal null byte in '*endPtr'.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static inline char *
+ShortestRyuConversion(
+    Double *dPtr,		/* Number to convert. */
+    int *decpt,			/* OUTPUT: Position of the decimal point. */
+    char **endPtr)		/* OUTPUT: Position of the terminal '\0' at
+				 *	   the end of the returned string. */
+{
+    int de = (dPtr->w.word0 & EXP_MASK) >> EXP_SHIFT;
+    Tcl_WideUInt m2 = dPtr->q & SIG_MASK;
+				/* Significand, with the hidden bit. */
+    int e2;			/* m2 * 2**e2 == 4 * the number. */
+    int acceptBounds;		/* Flag == 1 if the bounds of the rounding
+				 * interval themselves read back as the
+				 * number (round-half-even on input). */
+    Tcl_WideUInt mv;		/* 4 * m2: the number, in quarter ulps. */
+    Tcl_WideUInt vr, vp, vm;	/* The number and the upper and lower bounds
+				 * of its rounding interval, scaled by
+				 * 10**-e10 and truncated. */
+    int e10;			/* Power of ten of vr, vp, vm. */
+    int vmIsTrailingZeros = 0;	/* Flag == 1 if the truncation of vm, and of
+				 * the digits removed from it so far, was
+				 * exact. */
+    int vrIsTrailingZeros = 0;	/* Flag == 1 if the digits removed from vr,
+				 * past the last one, are all zero. */
+    int lastRemovedDigit = 0;	/* Last digit removed from vr. */
+    Tcl_WideUInt output;	/* Digits of the result. */
+    char *retval, *s;
+    int len;
+
+    if (de == 0) {
+	e2 = 1 - EXPONENT_BIAS - (FP_PRECISION - 1) - 2;
+    } else {
+	e2 = de - EXPONENT_BIAS - (FP_PRECISION - 1) - 2;
+	m2 |= HIDDEN_BIT;
+    }
+    acceptBounds = ((m2 & 1) == 0);
+    mv = 4 * m2;
+
+    /*
+     * Compute vr, vp and vm: the number and its rounding interval
+     * [4*m2 - 2, 4*m2 + 2] * 2**e2, divided by 10**e10 for an e10 chosen
+     * so that the divisions are exact in 125-bit arithmetic, along with
+     * whether the discarded parts are all zero.
+     */
+
+    if (e2 >= 0) {
+	int q = ((e2 * 78913) >> 18) - (e2 > 3);
+				/* floor(log10(2**e2)), less one */
+	int j = -e2 + q + RYU_POW5_BITCOUNT
+		+ (((q * 1217359) >> 19) + 1) - 1;
+
+	e10 = q;
+	vr = MulShift64(mv, pow5InvSplit[q], j);
+	vp = MulShift64(mv + 2, pow5InvSplit[q], j);
+	vm = MulShift64(mv - 2, pow5InvSplit[q], j);
+	if (q <= 21) {
+	    /*
+	     * Only one of mv - 2, mv, mv + 2 can be a multiple of 5; if any
+	     * is, it may be a multiple of 5**q.
+	     */
+
+	    if (mv % 5 == 0) {
+		vrIsTrailingZeros = (Pow5Factor(mv) >= q);
+	    } else if (acceptBounds) {
+		vmIsTrailingZeros = (Pow5Factor(mv - 2) >= q);
+	    } else {
+		vp -= (Pow5Factor(mv + 2) >= q);
+	    }
+	}
+    } else {
+	int q = ((-e2 * 732923) >> 20) - (-e2 > 1);
+				/* floor(log10(5**-e2)), less one */
+	int i = -e2 - q;
+	int j = q - (((i * 1217359) >> 19) + 1) + RYU_POW5_BITCOUNT;
+
+	e10 = q + e2;
+	vr = MulShift64(mv, pow5Split[i], j);
+	vp = MulShift64(mv + 2, pow5Split[i], j);
+	vm = MulShift64(mv - 2, pow5Split[i], j);
+	if (q <= 1) {
+	    /*
+	     * mv has at least two trailing zero bits, so the number times
+	     * 10**-e10 is an integer.
+	     */
+
+	    vrIsTrailingZeros = 1;
+	    if (acceptBounds) {
+		vmIsTrailingZeros = 1;
+	    } else {
+		--vp;
+	    }
+	} else if (q < 63) {
+	    vrIsTrailingZeros = ((mv & (((Tcl_WideUInt) 1 << q) - 1)) == 0);
+	}
+    }
+
+    /*
+     * Remove digits for as long as the bounds still differ; the remaining
+     * digits of vr, rounded, are the result.
+     */
+
+    len = 0;
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+	/*
+	 * The general case, where a bound may be exactly representable or
+	 * the number may fall exactly halfway between two candidates.
+	 */
+
+	while (vp / 10 > vm / 10) {
+	    vmIsTrailingZeros &= (vm % 10 == 0);
+	    vrIsTrailingZeros &= (lastRemovedDigit == 0);
+	    lastRemovedDigit = (int) (vr % 10);
+	    vr /= 10; vp /= 10; vm /= 10;
+	    ++len;
+	}
+	if (vmIsTrailingZeros) {
+	    while (vm % 10 == 0) {
+		vrIsTrailingZeros &= (lastRemovedDigit == 0);
+		lastRemovedDigit = (int) (vr % 10);
+		vr /= 10; vp /= 10; vm /= 10;
+		++len;
+	    }
+	}
+	if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+	    lastRemovedDigit = 4;
+	}
+	output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros))
+		|| lastRemovedDigit >= 5);
+    } else {
+	/*
+	 * The common case: neither bound is exact, so only the removed digits
+	 * of vr decide the rounding.
+	 */
+
+	int roundUp = 0;
+
+	if (vp / 100 > vm / 100) {
+	    roundUp = (vr % 100 >= 50);
+	    vr /= 100; vp /= 100; vm /= 100;
+	    len += 2;
+	}
+	while (vp / 10 > vm / 10) {
+	    roundUp = (vr % 10 >= 5);
+	    vr /= 10; vp /= 10; vm /= 10;
+	    ++len;
+	}
+	output = vr + (vr == vm || roundUp);
+    }
+    e10 += len;
+
+    /*
+     * Suppress trailing zeroes, then write out the digits.
+     */
+
+    while (output % 10 == 0) {
+	output /= 10;
+	++e10;
+    }
+    for (vr = output, len = 0; vr != 0; vr /= 10) {
+	++len;
+    }
+    retval = (char *)Tcl_Alloc(len + 1);
+    s = retval + len;
+    *s = '\0';
+    if (endPtr) {
+	*endPtr = s;
+    }
+    while (s > retval) {
+	*--s = '0' + (int) (output % 10);
+	output /= 10;
+    }
+    *decpt = e10 + len - 1;
+    return retval;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -4385,6 +6211,18 @@ TclDoubleDigits(
 	return FormatZero(decpt, endPtr);
     }
 
+    /*
+     * Plain shortest conversion, which is what every double's string rep
+     * needs, goes to Ryu, except for the normalized powers of two whose
+     * lopsided rounding intervals the code below has always handled its
+     * own way.
+     */
+
+    if (flags == TCL_DD_SHORTEST && ((d.q & SIG_MASK) != 0
+	    || (d.w.word0 & EXP_MASK) == 0)) {
+	return ShortestRyuConversion(&d, decpt, endPtr);
+    }
+
     /*
      * Unpack the floating point into a wide integer and an exponent.
      * Determine the number of bits that the big integer requires, and compute
@@ -52,20 +52,30 @@ static void		AppendUtfToUtfRep(Tcl_Obj *objPtr,
 			    const char *bytes, Tcl_Size numBytes);
 static void		DupStringInternalRep(Tcl_Obj *objPtr,
 			    Tcl_Obj *copyPtr);
+static void		DupSubstringInternalRep(Tcl_Obj *objPtr,
+			    Tcl_Obj *copyPtr);
 static Tcl_Size		ExtendStringRepWithUnicode(Tcl_Obj *objPtr,
 			    const Tcl_UniChar *unicode, Tcl_Size numChars);
 static void		ExtendUnicodeRepWithString(Tcl_Obj *objPtr,
 			    const char *bytes, Tcl_Size numBytes,
 			    Tcl_Size numAppendChars);
 static void		FillUnicodeRep(Tcl_Obj *objPtr);
+static void		FreeStringIndex(String *stringPtr);
 static void		FreeStringInternalRep(Tcl_Obj *objPtr);
+static void		FreeSubstringInternalRep(Tcl_Obj *objPtr);
+static Tcl_Obj *	GetRange(Tcl_Obj *objPtr, Tcl_Size first, Tcl_Size last,
+			    int share);
 static void		GrowStringBuffer(Tcl_Obj *objPtr, Tcl_Size needed, int flag);
 static void		GrowUnicodeBuffer(Tcl_Obj *objPtr, Tcl_Size needed);
+static Tcl_Obj *	NewRangeObj(Tcl_Obj *parentPtr, Tcl_Size offset,
+			    Tcl_Size numBytes, Tcl_Size numChars, int share);
 static int		SetStringFromAny(Tcl_Interp *interp, Tcl_Obj *objPtr);
 static void		SetUnicodeObj(Tcl_Obj *objPtr,
 			    const Tcl_UniChar *unicode, Tcl_Size numChars);
 static Tcl_Size		UnicodeLength(const Tcl_UniChar *unicode);
 static void		UpdateStringOfString(Tcl_Obj *objPtr);
+static void		UpdateStringOfSubstring(Tcl_Obj *objPtr);
+static const char *	UtfAtCharIndex(Tcl_Obj *objPtr, Tcl_Size index);
 
 #define ISCONTINUATION(bytes) (\
 	((bytes)[0] & 0xC0) == 0x80)
@@ -83,6 +93,45 @@ const Tcl_ObjType tclStringType = {
     SetStringFromAny,		/* setFromAnyProc */
     TCL_OBJTYPE_V0
 };
+
+/*
+ * A substring value refers to a run of bytes in the string rep of another
+ * value instead of owning a copy. It has no string rep of its own until one
+ * is asked for; at that point the bytes are copied out and the reference to
+ * the parent is dropped. The parent is always shared while referenced (see
+ * TclNewSubstringObj), so its bytes cannot change underneath us.
+ */
+
+typedef struct {
+    Tcl_Obj *parentPtr;		/* Value holding the bytes; we own one
+				 * reference to it. */
+    Tcl_Size offset;		/* Offset of the first byte in
+				 * parentPtr->bytes. */
+    Tcl_Size numBytes;		/* Length of the substring, in bytes. */
+    Tcl_Size numChars;		/* Length of the substring, in chars, or
+				 * TCL_INDEX_NONE when not yet counted. */
+} Substring;
+
+static const Tcl_ObjType substringType = {
+    "substring",		/* name */
+    FreeSubstringInternalRep,	/* freeIntRepPro */
+    DupSubstringInternalRep,	/* dupIntRepProc */
+    UpdateStringOfSubstring,	/* updateStringProc */
+    NULL,			/* setFromAnyProc */
+    TCL_OBJTYPE_V0
+};
+
+#define GET_SUBSTRING(objPtr) \
+	((Substring *) (objPtr)->internalRep.twoPtrValue.ptr1)
+
+/*
+ * Substrings shorter than this many bytes are copied; referencing the parent
+ * would not save memory.
+ */
+
+#ifndef TCL_MIN_SUBSTRING_SHARE
+#define TCL_MIN_SUBSTRING_SHARE	64
+#endif
 
 /*
  * TCL STRING GROWTH ALGORITHM
@@ -403,6 +452,21 @@ Tcl_GetCharLength(
 	return numChars;
     }
 
+    /*
+     * A substring can count its chars in the parent's bytes without
+     * getting a string rep of its own.
+     */
+
+    if (TclHasInternalRep(objPtr, &substringType)) {
+	Substring *subPtr = GET_SUBSTRING(objPtr);
+
+	if (subPtr->numChars < 0) {
+	    TclNumUtfCharsM(subPtr->numChars,
+		    subPtr->parentPtr->bytes + subPtr->offset, subPtr->numBytes);
+	}
+	return subPtr->numChars;
+    }
+
     /*
      * OK, need to work with the object as a string.
      */
@@ -573,8 +637,14 @@ Tcl_GetUniChar(
 	if (stringPtr->numChars == objPtr->length) {
 	    return (unsigned char) objPtr->bytes[index];
 	}
-	FillUnicodeRep(objPtr);
-	stringPtr = GET_STRING(objPtr);
+
+	/*
+	 * Locate the character in the UTF-8 rep rather than converting the
+	 * whole string to a Tcl_UniChar array.
+	 */
+
+	TclUtfToUniChar(UtfAtCharIndex(objPtr, index), &ch);
+	return ch;
     }
 
     if (index >= stringPtr->numChars) {
@@ -698,7 +768,179 @@ Tcl_GetUnicodeFromObj(
 /*
  *----------------------------------------------------------------------
  *
- * Tcl_GetRange --
+ * TclNewSubstringObj --
+ *
+ *	Create a value holding numBytes bytes of the string rep of parentPtr,
+ *	starting at offset. When the run is long enough and parentPtr is
+ *	already referenced elsewhere, the new value shares the parent's bytes
+ *	rather than copying them.
+ *
+ * Results:
+ *	A new value with refCount 0.
+ *
+ * Side effects:
+ *	May add a reference to parentPtr, held until the new value is freed or
+ *	gets a string rep of its own.
+ *
+ *----------------------------------------------------------------------
+ */
+
+Tcl_Obj *
+TclNewSubstringObj(
+    Tcl_Obj *parentPtr,		/* Value with a string rep holding the
+				 * bytes. */
+    Tcl_Size offset,		/* Offset of the first byte. */
+    Tcl_Size numBytes,		/* Number of bytes. */
+    Tcl_Size numChars)		/* Number of chars in those bytes, or
+				 * TCL_INDEX_NONE if not known. */
+{
+    Tcl_Obj *objPtr;
+    Substring *subPtr;
+
+    /*
+     * A parent nobody else references could still be modified in place by
+     * whoever created it, so only share bytes of values that are about to
+     * become shared.
+     */
+
+    if ((numBytes < TCL_MIN_SUBSTRING_SHARE) || (parentPtr->refCount < 1)) {
+	return NewRangeObj(parentPtr, offset, numBytes, numChars, 0);
+    }
+
+    subPtr = (Substring *)Tcl_Alloc(sizeof(Substring));
+    subPtr->parentPtr = parentPtr;
+    subPtr->offset = offset;
+    subPtr->numBytes = numBytes;
+    subPtr->numChars = numChars;
+    Tcl_IncrRefCount(parentPtr);
+
+    TclNewObj(objPtr);
+    TclInvalidateStringRep(objPtr);
+    objPtr->internalRep.twoPtrValue.ptr1 = subPtr;
+    objPtr->internalRep.twoPtrValue.ptr2 = NULL;
+    objPtr->typePtr = &substringType;
+    return objPtr;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * DupSubstringInternalRep, FreeSubstringInternalRep --
+ *
+ *	Copy or release the internal rep of a substring value.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Adjusts the reference count of the parent value.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+DupSubstringInternalRep(
+    Tcl_Obj *srcPtr,		/* Substring to copy. */
+    Tcl_Obj *copyPtr)		/* Value with no internal rep to become a
+				 * copy of srcPtr. */
+{
+    Substring *subPtr = (Substring *)Tcl_Alloc(sizeof(Substring));
+
+    *subPtr = *GET_SUBSTRING(srcPtr);
+    Tcl_IncrRefCount(subPtr->parentPtr);
+    copyPtr->internalRep.twoPtrValue.ptr1 = subPtr;
+    copyPtr->internalRep.twoPtrValue.ptr2 = NULL;
+    copyPtr->typePtr = &substringType;
+}
+
+static void
+FreeSubstringInternalRep(
+    Tcl_Obj *objPtr)		/* Substring value to release. */
+{
+    Substring *subPtr = GET_SUBSTRING(objPtr);
+
+    TclDecrRefCount(subPtr->parentPtr);
+    Tcl_Free(subPtr);
+    objPtr->typePtr = NULL;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * UpdateStringOfSubstring --
+ *
+ *	Copy the bytes of a substring out of its parent into a string rep of
+ *	its own.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The internal rep is discarded along with the reference to the parent,
+ *	leaving a plain string value.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+UpdateStringOfSubstring(
+    Tcl_Obj *objPtr)		/* Substring value to give a string rep. */
+{
+    Substring *subPtr = GET_SUBSTRING(objPtr);
+
+    TclInitStringRep(objPtr, subPtr->parentPtr->bytes + subPtr->offset,
+	    subPtr->numBytes);
+    TclFreeInternalRep(objPtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * NewRangeObj --
+ *
+ *	Create a value holding numBytes bytes of the string rep of parentPtr,
+ *	starting at offset. If share is set and the run is more than half of
+ *	the parent, the value refers to the parent's bytes (see
+ *	TclNewSubstringObj); otherwise the bytes are copied, so that a short
+ *	range does not keep a long parent alive.
+ *
+ * Results:
+ *	A new value with refCount 0.
+ *
+ * Side effects:
+ *	May add a reference to parentPtr.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static Tcl_Obj *
+NewRangeObj(
+    Tcl_Obj *parentPtr,		/* Value with a string rep holding the
+				 * bytes. */
+    Tcl_Size offset,		/* Offset of the first byte. */
+    Tcl_Size numBytes,		/* Number of bytes. */
+    Tcl_Size numChars,		/* Number of chars in those bytes, or
+				 * TCL_INDEX_NONE if not known. */
+    int share)			/* Whether the parent's bytes may be
+				 * shared. */
+{
+    Tcl_Obj *objPtr;
+
+    if (share && (numBytes > parentPtr->length / 2)) {
+	return TclNewSubstringObj(parentPtr, offset, numBytes, numChars);
+    }
+    objPtr = Tcl_NewStringObj(parentPtr->bytes + offset, numBytes);
+    if (numChars >= 0) {
+	SetStringFromAny(NULL, objPtr);
+	GET_STRING(objPtr)->numChars = numChars;
+    }
+    return objPtr;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * Tcl_GetRange, TclGetSharedRange --
  *
  *	Create a Tcl Object that contains the chars between first and last of
  *	the object indicated by "objPtr". If the object is not already a
@@ -706,11 +948,17 @@ Tcl_GetUnicodeFromObj(
  *	returned string start at the beginning of objPtr.  If last is
  *	TCL_INDEX_NONE, the returned string ends at the end of objPtr.
  *
+ *	Tcl_GetRange always copies the chars, so the new object holds no
+ *	reference to "objPtr" and the caller may still modify it in place.
+ *	TclGetSharedRange, used by [string range], may instead make a range
+ *	covering most of "objPtr" refer to its bytes.
+ *
  * Results:
  *	Returns a new Tcl Object of the String type.
  *
  * Side effects:
  *	Changes the internal rep of "objPtr" to the String type.
+ *	TclGetSharedRange may add a reference to "objPtr".
  *
  *----------------------------------------------------------------------
  */
@@ -720,6 +968,26 @@ Tcl_GetRange(
     Tcl_Obj *objPtr,		/* The Tcl object to find the range of. */
     Tcl_Size first,		/* First index of the range. */
     Tcl_Size last)		/* Last index of the range. */
+{
+    return GetRange(objPtr, first, last, 0);
+}
+
+Tcl_Obj *
+TclGetSharedRange(
+    Tcl_Obj *objPtr,		/* The Tcl object to find the range of. */
+    Tcl_Size first,		/* First index of the range. */
+    Tcl_Size last)		/* Last index of the range. */
+{
+    return GetRange(objPtr, first, last, 1);
+}
+
+static Tcl_Obj *
+GetRange(
+    Tcl_Obj *objPtr,		/* The Tcl object to find the range of. */
+    Tcl_Size first,		/* First index of the range. */
+    Tcl_Size last,		/* Last index of the range. */
+    int share)			/* Whether the range may refer to the bytes
+				 * of objPtr. */
 {
     Tcl_Obj *newObjPtr;		/* The Tcl object to find the range of. */
     String *stringPtr;
@@ -747,6 +1015,26 @@ Tcl_GetRange(
 	return Tcl_NewByteArrayObj(bytes + first, last - first + 1);
     }
 
+    /*
+     * A range of a single-byte substring is taken from its parent's bytes,
+     * without giving the substring a string rep of its own.
+     */
+
+    if (TclHasInternalRep(objPtr, &substringType)
+	    && (Tcl_GetCharLength(objPtr) == GET_SUBSTRING(objPtr)->numBytes)) {
+	Substring *subPtr = GET_SUBSTRING(objPtr);
+
+	if (last < 0 || last >= subPtr->numChars) {
+	    last = subPtr->numChars - 1;
+	}
+	if (last < first) {
+	    TclNewObj(newObjPtr);
+	    return newObjPtr;
+	}
+	return NewRangeObj(subPtr->parentPtr, subPtr->offset + first,
+		last - first + 1, last - first + 1, share);
+    }
+
     /*
      * OK, need to work with the object as a string.
      */
@@ -770,19 +1058,29 @@ Tcl_GetRange(
 		TclNewObj(newObjPtr);
 		return newObjPtr;
 	    }
-	    newObjPtr = Tcl_NewStringObj(objPtr->bytes + first, last - first + 1);
+	    return NewRangeObj(objPtr, first, last - first + 1,
+		    last - first + 1, share);
+	} else {
+	    const char *begin, *end;
+
+	    if (last < 0 || last >= stringPtr->numChars) {
+		last = stringPtr->numChars - 1;
+	    }
+	    if (last < first) {
+		TclNewObj(newObjPtr);
+		return newObjPtr;
+	    }
 
 	    /*
-	     * Since we know the char length of the result, store it.
+	     * Copy the range straight out of the UTF-8 rep; the character
+	     * positions come from the index, so no Tcl_UniChar rep is needed.
 	     */
 
-	    SetStringFromAny(NULL, newObjPtr);
-	    stringPtr = GET_STRING(newObjPtr);
-	    stringPtr->numChars = newObjPtr->length;
-	    return newObjPtr;
+	    begin = UtfAtCharIndex(objPtr, first);
+	    end = UtfAtCharIndex(objPtr, last + 1);
+	    return NewRangeObj(objPtr, begin - objPtr->bytes,
+		    end - begin, last - first + 1, share);
 	}
-	FillUnicodeRep(objPtr);
-	stringPtr = GET_STRING(objPtr);
     }
     if (last < 0 || last >= stringPtr->numChars) {
 	last = stringPtr->numChars - 1;
@@ -963,6 +1261,7 @@ Tcl_SetObjLength(
 
 	stringPtr->numChars = TCL_INDEX_NONE;
 	stringPtr->hasUnicode = 0;
+	FreeStringIndex(stringPtr);
     } else {
 	if (length > stringPtr->maxChars) {
 	    stringPtr = stringRealloc(stringPtr, length);
@@ -1065,6 +1364,7 @@ Tcl_AttemptSetObjLength(
 
 	stringPtr->numChars = TCL_INDEX_NONE;
 	stringPtr->hasUnicode = 0;
+	FreeStringIndex(stringPtr);
     } else {
 	/*
 	 * Changing length of pure Unicode string.
@@ -1168,6 +1468,7 @@ SetUnicodeObj(
     stringPtr->unicode[numChars] = 0;
     stringPtr->numChars = numChars;
     stringPtr->hasUnicode = 1;
+    stringPtr->indexPtr = NULL;
 
     TclInvalidateStringRep(objPtr);
     stringPtr->allocated = 0;
@@ -3827,7 +4128,7 @@ TclStringFirst(
 {
     Tcl_Size lh = 0, ln = Tcl_GetCharLength(needle);
     Tcl_Size value = -1;
-    Tcl_UniChar *checkStr, *endStr, *uh, *un;
+    Tcl_UniChar *uh, *un;
     Tcl_Obj *obj;
 
     if (start < 0) {
@@ -3841,8 +4142,7 @@ TclStringFirst(
     }
 
     if (TclIsPureByteArray(needle) && TclIsPureByteArray(haystack)) {
-	unsigned char *end, *check, *bh;
-	unsigned char *bn = Tcl_GetBytesFromObj(NULL, needle, &ln);
+	unsigned char *bh, *bn = Tcl_GetBytesFromObj(NULL, needle, &ln);
 
 	/* Find bytes in bytes */
 	bh = Tcl_GetBytesFromObj(NULL, haystack, &lh);
@@ -3850,28 +4150,9 @@ TclStringFirst(
 	    /* Don't start the loop if there cannot be a valid answer */
 	    goto firstEnd;
 	}
-	end = bh + lh;
-
-	check = bh + start;
-	while (check + ln <= end) {
-	    /*
-	     * Look for the leading byte of the needle in the haystack
-	     * starting at check and stopping when there's not enough room
-	     * for the needle left.
-	     */
-	    check = (unsigned char *)memchr(check, bn[0], (end + 1 - ln) - check);
-	    if (check == NULL) {
-		/* Leading byte not found -> needle cannot be found. */
-		goto firstEnd;
-	    }
-	    /* Leading byte found, check rest of needle. */
-	    if (0 == memcmp(check+1, bn+1, ln-1)) {
-		/* Checks! Return the successful index. */
-		value = (check - bh);
-		goto firstEnd;
-	    }
-	    /* Rest of needle match failed; Iterate to continue search. */
-	    check++;
+	value = TclByteArrayFind(bh + start, lh - start, bn, ln);
+	if (value >= 0) {
+	    value += start;
 	}
 	goto firstEnd;
     }
@@ -3894,14 +4175,9 @@ TclStringFirst(
 	/* Don't start the loop if there cannot be a valid answer */
 	goto firstEnd;
     }
-    endStr = uh + lh;
-
-    for (checkStr = uh + start; checkStr + ln <= endStr; checkStr++) {
-	if ((*checkStr == *un) && (0 ==
-		memcmp(checkStr + 1, un + 1, (ln-1) * sizeof(Tcl_UniChar)))) {
-	    value =  (checkStr - uh);
-	    goto firstEnd;
-	}
+    value = TclUniCharFind(uh + start, lh - start, un, ln);
+    if (value >= 0) {
+	value += start;
     }
   firstEnd:
     TclNewIndexObj(obj, value);
@@ -3934,7 +4210,7 @@ TclStringLast(
 {
     Tcl_Size lh = 0, ln = Tcl_GetCharLength(needle);
     Tcl_Size value = -1;
-    Tcl_UniChar *checkStr, *uh, *un;
+    Tcl_UniChar *uh, *un;
     Tcl_Obj *obj;
 
     if (ln == 0) {
@@ -3948,7 +4224,7 @@ TclStringLast(
     }
 
     if (TclIsPureByteArray(needle) && TclIsPureByteArray(haystack)) {
-	unsigned char *check, *bh = Tcl_GetBytesFromObj(NULL, haystack, &lh);
+	unsigned char *bh = Tcl_GetBytesFromObj(NULL, haystack, &lh);
 	unsigned char *bn = Tcl_GetBytesFromObj(NULL, needle, &ln);
 
 	if (last >= lh) {
@@ -3958,16 +4234,7 @@ TclStringLast(
 	    /* Don't start the loop if there cannot be a valid answer */
 	    goto lastEnd;
 	}
-	check = bh + last + 1 - ln;
-
-	while (check >= bh) {
-	    if ((*check == bn[0])
-		    && (0 == memcmp(check+1, bn+1, ln-1))) {
-		value = (check - bh);
-		goto lastEnd;
-	    }
-	    check--;
-	}
+	value = TclByteArrayFindLast(bh, last + 1, bn, ln);
 	goto lastEnd;
     }
 
@@ -3981,15 +4248,7 @@ TclStringLast(
 	/* Don't start the loop if there cannot be a valid answer */
 	goto lastEnd;
     }
-    checkStr = uh + last + 1 - ln;
-    while (checkStr >= uh) {
-	if ((*checkStr == un[0])
-		&& (0 == memcmp(checkStr+1, un+1, (ln-1)*sizeof(Tcl_UniChar)))) {
-	    value = (checkStr - uh);
-	    goto lastEnd;
-	}
-	checkStr--;
-    }
+    value = TclUniCharFindLast(uh, last + 1, un, ln);
   lastEnd:
     TclNewIndexObj(obj, value);
     return obj;
@@ -4100,6 +4359,8 @@ TclStringReverse(
 	if (!inPlace || Tcl_IsShared(objPtr)) {
 	    TclNewObj(objPtr);
 	    Tcl_SetObjLength(objPtr, numBytes);
+	} else {
+	    FreeStringIndex(stringPtr);
 	}
 	to = objPtr->bytes;
 
@@ -4338,6 +4599,7 @@ ExtendUnicodeRepWithString(
     }
 
     stringPtr->hasUnicode = 1;
+    FreeStringIndex(stringPtr);
     if (bytes) {
 	stringPtr->numChars = needed;
     } else {
@@ -4416,6 +4678,7 @@ DupStringInternalRep(
     }
     copyStringPtr->hasUnicode = srcStringPtr->hasUnicode;
     copyStringPtr->numChars = srcStringPtr->numChars;
+    copyStringPtr->indexPtr = NULL;
 
     /*
      * Tricky point: the string value was copied by generic object management
@@ -4470,6 +4733,7 @@ SetStringFromAny(
 	stringPtr->allocated = objPtr->length;
 	stringPtr->maxChars = 0;
 	stringPtr->hasUnicode = 0;
+	stringPtr->indexPtr = NULL;
 	SET_STRING(objPtr, stringPtr);
 	objPtr->typePtr = &tclStringType;
     }
@@ -4601,10 +4865,121 @@ static void
 FreeStringInternalRep(
     Tcl_Obj *objPtr)		/* Object with internal rep to free. */
 {
-    Tcl_Free(GET_STRING(objPtr));
+    String *stringPtr = GET_STRING(objPtr);
+
+    FreeStringIndex(stringPtr);
+    Tcl_Free(stringPtr);
     objPtr->typePtr = NULL;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * FreeStringIndex --
+ *
+ *	Discard the character position index of a String internal rep. Must be
+ *	called whenever the UTF-8 rep changes other than by appending to it,
+ *	and when a Tcl_UniChar rep is created.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Frees memory.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+FreeStringIndex(
+    String *stringPtr)
+{
+    if (stringPtr->indexPtr != NULL) {
+	Tcl_Free(stringPtr->indexPtr);
+	stringPtr->indexPtr = NULL;
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * UtfAtCharIndex --
+ *
+ *	Locate a character in the UTF-8 rep of a String object without a
+ *	Tcl_UniChar rep. Short strings are simply walked; for longer ones the
+ *	String's index of character positions is extended as far as needed
+ *	(it is never scanned twice) and the walk starts from the nearest
+ *	recorded position at or before the character.
+ *
+ * Results:
+ *	Pointer to the first byte of character "index", which must be in the
+ *	range 0 to numChars inclusive; numChars gives the end of the string.
+ *
+ * Side effects:
+ *	May create or grow the String's index.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static const char *
+UtfAtCharIndex(
+    Tcl_Obj *objPtr,		/* String object with known numChars and no
+				 * Tcl_UniChar rep. */
+    Tcl_Size index)		/* Index of the character to locate. */
+{
+    String *stringPtr = GET_STRING(objPtr);
+    StringIndex *indexPtr = stringPtr->indexPtr;
+    const char *bytes = objPtr->bytes, *src;
+    Tcl_UniChar ch = 0;
+    Tcl_Size entry, limit;
+
+    if (stringPtr->numChars <= STRING_INDEX_INTERVAL) {
+	return Tcl_UtfAtIndex(bytes, index);
+    }
+
+    if (indexPtr == NULL || indexPtr->numBytes > objPtr->length) {
+	FreeStringIndex(stringPtr);
+	indexPtr = (StringIndex *)Tcl_Alloc(offsetof(StringIndex, offsets)
+		+ 16 * sizeof(Tcl_Size));
+	indexPtr->numBytes = 0;
+	indexPtr->numChars = 0;
+	indexPtr->numEntries = 1;
+	indexPtr->maxEntries = 16;
+	indexPtr->offsets[0] = 0;
+	stringPtr->indexPtr = indexPtr;
+    }
+
+    /*
+     * Scan forward, recording positions, until the index covers the wanted
+     * character. Only characters that start at least 4 bytes before the end
+     * are scanned, as their decoding cannot be changed by later appends.
+     */
+
+    src = bytes + indexPtr->numBytes;
+    limit = objPtr->length - 4;
+    while (indexPtr->numChars < index && src - bytes <= limit) {
+	src += TclUtfToUniChar(src, &ch);
+	if (++indexPtr->numChars % STRING_INDEX_INTERVAL == 0) {
+	    if (indexPtr->numEntries == indexPtr->maxEntries) {
+		indexPtr->maxEntries *= 2;
+		indexPtr = (StringIndex *)Tcl_Realloc(indexPtr,
+			offsetof(StringIndex, offsets)
+			+ indexPtr->maxEntries * sizeof(Tcl_Size));
+		stringPtr->indexPtr = indexPtr;
+	    }
+	    indexPtr->offsets[indexPtr->numEntries++] = src - bytes;
+	}
+    }
+    indexPtr->numBytes = src - bytes;
+
+    entry = index / STRING_INDEX_INTERVAL;
+    if (entry >= indexPtr->numEntries) {
+	entry = indexPtr->numEntries - 1;
+    }
+    return Tcl_UtfAtIndex(bytes + indexPtr->offsets[entry],
+	    index - entry * STRING_INDEX_INTERVAL);
+}
+
 /*
  * Local Variables:
  * mode: c
@@ -27,6 +27,30 @@
  * code points (independent of encoding form) once that value has been computed.
  */
 
+/*
+ * The following structure is a sparse table of character positions in the
+ * UTF-8 rep of a String object, giving the byte offset of every
+ * STRING_INDEX_INTERVAL'th character. It lets Tcl_GetUniChar and Tcl_GetRange
+ * locate characters by walking less than one interval, instead of building
+ * the (four bytes per character) Tcl_UniChar rep. It is built incrementally
+ * as far as needed and is only kept while the String has no Tcl_UniChar rep.
+ */
+
+typedef struct {
+    Tcl_Size numBytes;		/* Byte offset up to which the UTF-8 rep has
+				 * been scanned. Always a character boundary
+				 * at least 4 bytes before the end of the rep,
+				 * so appending to the rep cannot change it. */
+    Tcl_Size numChars;		/* Character index at numBytes. */
+    Tcl_Size numEntries;	/* Number of used entries in offsets. */
+    Tcl_Size maxEntries;	/* Number of allocated entries in offsets. */
+    Tcl_Size offsets[TCLFLEXARRAY];
+				/* offsets[i] is the byte offset of character
+				 * i*STRING_INDEX_INTERVAL. */
+} StringIndex;
+
+#define STRING_INDEX_INTERVAL	64
+
 typedef struct {
     Tcl_Size numChars;		/* The number of chars in the string.
 				 * TCL_INDEX_NONE means this value has not been
@@ -41,6 +65,9 @@ typedef struct {
 				 * space allocated for the Unicode array. */
     int hasUnicode;		/* Boolean determining whether the string has
 				 * a Tcl_UniChar representation. */
+    StringIndex *indexPtr;	/* Character positions in the UTF-8 rep, or
+				 * NULL if not built. Always NULL when
+				 * hasUnicode is set. */
     Tcl_UniChar unicode[TCLFLEXARRAY];	/* The array of Tcl_UniChar units.
 				 * The actual size of this field depends on
 				 * the maxChars field above. */
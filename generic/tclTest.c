@@ -679,6 +679,8 @@ Tcltest_Init(
 	    TestUtfPrevCmd, NULL, NULL);
     Tcl_CreateObjCommand(interp, "testnumutfchars",
 	    TestNumUtfCharsCmd, NULL, NULL);
+    Tcl_CreateObjCommand(interp, "testnumutf16chars",
+	    TestNumUtfCharsCmd, INT2PTR(1), NULL);
     Tcl_CreateObjCommand(interp, "testgetunichar",
 	    TestGetUniCharCmd, NULL, NULL);
     Tcl_CreateObjCommand(interp, "testfindfirst",
@@ -7577,12 +7579,13 @@ TestUtfPrevCmd(
 }
 
 /*
- * Used to check correct string-length determining in Tcl_NumUtfChars
+ * Used to check correct string-length determining in Tcl_NumUtfChars, or in
+ * TclNumUtfChars (counting UTF-16 code units) for testnumutf16chars.
  */
 
 static int
 TestNumUtfCharsCmd(
-    TCL_UNUSED(void *),
+    void *clientData,
     Tcl_Interp *interp,
     int objc,
     Tcl_Obj *const objv[])
@@ -7599,7 +7602,11 @@ TestNumUtfCharsCmd(
 		limit = numBytes + 1;
 	    }
 	}
-	len = Tcl_NumUtfChars(bytes, limit);
+	if (clientData != NULL) {
+	    len = TclNumUtfChars(bytes, limit);
+	} else {
+	    len = Tcl_NumUtfChars(bytes, limit);
+	}
 	Tcl_SetObjResult(interp, Tcl_NewWideIntObj(len));
     }
     return TCL_OK;
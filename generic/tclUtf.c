@@ -83,11 +83,34 @@ static const unsigned char complete[256] = {
     3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,4,4,4,4,4,1,1,1,1,1,1,1,1,1,1,1
 };
 
+/*
+ * Mask used to examine eight bytes of a UTF-8 string at a time. HIGH_BITS
+ * selects the top bit of every byte, so a word holds only bytes below 0xC0
+ * (ASCII or trail bytes) when (word & (word << 1) & HIGH_BITS) is zero.
+ */
+
+#define HIGH_BITS	((uint64_t) 0x8080808080808080ULL)
+#define LOW_BITS	((uint64_t) 0x0101010101010101ULL)
+
+/*
+ * Strings shorter than this many chars are searched by plain scanning in
+ * TclUniCharFind and TclUniCharFindLast; filling the shift table would cost
+ * more than it saves.
+ */
+
+#define SEARCH_SKIP_THRESHOLD	64
+
 /*
  * Functions used only in this module.
  */
 
+static Tcl_Size		AsciiToCase(char *dst, const char *src,
+			    Tcl_Size length, int first);
 static int		Invalid(const char *src);
+static Tcl_Size		SingleByteCharRun(const char *src, Tcl_Size length);
+static int		UniCharMatch(const Tcl_UniChar *string,
+			    Tcl_Size strLen, const Tcl_UniChar *pattern,
+			    Tcl_Size ptnLen, int nocase);
 
 /*
  *---------------------------------------------------------------------------
@@ -779,6 +802,47 @@ Tcl_UtfCharComplete(
     return length >= complete[UCHAR(*src)];
 }
 
+/*
+ *---------------------------------------------------------------------------
+ *
+ * SingleByteCharRun --
+ *
+ *	Returns the length of the longest prefix of the given UTF-8 bytes that
+ *	contains no lead byte of a multi-byte sequence. Every byte in that
+ *	prefix counts as one character: ASCII bytes trivially, and trail bytes
+ *	because a trail byte met where a character should start is taken as a
+ *	character of its own by Tcl_UtfToUniChar and Tcl_UtfToChar16.
+ *
+ * Results:
+ *	A value between 0 and length.
+ *
+ * Side effects:
+ *	None.
+ *
+ *---------------------------------------------------------------------------
+ */
+
+static Tcl_Size
+SingleByteCharRun(
+    const char *src,		/* The UTF-8 bytes to examine. */
+    Tcl_Size length)		/* Number of bytes at src. */
+{
+    const char *p = src, *endPtr = src + length;
+    uint64_t word;
+
+    while (endPtr - p >= (Tcl_Size) sizeof(word)) {
+	memcpy(&word, p, sizeof(word));
+	if (word & (word << 1) & HIGH_BITS) {
+	    break;
+	}
+	p += sizeof(word);
+    }
+    while (p < endPtr && UCHAR(*p) < 0xC0) {
+	p++;
+    }
+    return p - src;
+}
+
 /*
  *---------------------------------------------------------------------------
  *
@@ -827,8 +891,19 @@ Tcl_NumUtfChars(
 	 * So (endPtr - src) >= TCL_UTF_MAX, and passing that to
 	 * Tcl_UtfCharComplete we know will cause return of 1.
 	 */
-	while (src <= optPtr
-		/* && Tcl_UtfCharComplete(src, endPtr - src) */ ) {
+	while (src < endPtr) {
+	    /*
+	     * Runs without multi-byte lead bytes are counted a word at a
+	     * time; decoding is only needed where such a sequence starts.
+	     */
+
+	    Tcl_Size run = SingleByteCharRun(src, endPtr - src);
+
+	    src += run;
+	    i += run;
+	    if (src > optPtr) {
+		break;
+	    }
 	    src += TclUtfToUniChar(src, &ch);
 	    i++;
 	}
@@ -879,8 +954,24 @@ TclNumUtfChars(
 	 * So (endPtr - src) >= TCL_UTF_MAX, and passing that to
 	 * Tcl_UtfCharComplete we know will cause return of 1.
 	 */
-	while (src <= optPtr
-		/* && Tcl_UtfCharComplete(src, endPtr - src) */ ) {
+	while (src < endPtr) {
+	    /*
+	     * Runs without multi-byte lead bytes are counted a word at a
+	     * time; decoding is only needed where such a sequence starts.
+	     * After a high surrogate, Tcl_UtfToChar16 has consumed only the
+	     * lead byte, so the trail bytes must be decoded into the low
+	     * surrogate before a run can start.
+	     */
+
+	    if ((ch & 0xFC00) != 0xD800) {
+		Tcl_Size run = SingleByteCharRun(src, endPtr - src);
+
+		src += run;
+		i += run;
+	    }
+	    if (src > optPtr) {
+		break;
+	    }
 	    src += Tcl_UtfToChar16(src, &ch);
 	    i++;
 	}
@@ -1295,6 +1386,62 @@ Tcl_UtfBackslash(
     return result;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * AsciiToCase --
+ *
+ *	Copies the run of ASCII characters at the start of a UTF-8 string,
+ *	changing the letters from first to first+25 to the other case. Eight
+ *	characters at a time are done with word arithmetic: adding 0x80-first
+ *	and 0x80-(first+26) to every byte sets the top bit of the bytes at
+ *	least that large, and the letters are the bytes where only the first
+ *	sum has it.
+ *
+ * Results:
+ *	The length of the run, which is the number of bytes read from src and
+ *	written to dst.
+ *
+ * Side effects:
+ *	Writes to dst, which may be src or lie before it.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static Tcl_Size
+AsciiToCase(
+    char *dst,			/* Where to write the converted run. */
+    const char *src,		/* The UTF-8 string to convert. */
+    Tcl_Size length,		/* Number of bytes at src. */
+    int first)			/* 'a' to change to upper case, 'A' to change
+				 * to lower case. */
+{
+    const char *p = src, *endPtr = src + length;
+    uint64_t word, atLeastFirst, pastLast;
+
+    while (endPtr - p >= (Tcl_Size) sizeof(word)) {
+	memcpy(&word, p, sizeof(word));
+	if (word & HIGH_BITS) {
+	    break;
+	}
+	atLeastFirst = word + (0x80 - first) * LOW_BITS;
+	pastLast = word + (0x80 - first - 26) * LOW_BITS;
+	word ^= (atLeastFirst & ~pastLast & HIGH_BITS) >> 2;
+	memcpy(dst, &word, sizeof(word));
+	p += sizeof(word);
+	dst += sizeof(word);
+    }
+    while (p < endPtr && UCHAR(*p) < 0x80) {
+	if ((unsigned) (UCHAR(*p) - first) < 26) {
+	    *dst++ = (char) (*p ^ 0x20);
+	} else {
+	    *dst++ = *p;
+	}
+	p++;
+    }
+    return p - src;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -1318,7 +1465,7 @@ Tcl_UtfToUpper(
     char *str)			/* String to convert in place. */
 {
     int ch, upChar;
-    char *src, *dst;
+    char *src, *dst, *end;
     Tcl_Size len;
 
     /*
@@ -1326,7 +1473,14 @@ Tcl_UtfToUpper(
      */
 
     src = dst = str;
-    while (*src) {
+    end = str + strlen(str);
+    while (src < end) {
+	if (UCHAR(*src) < 0x80) {
+	    len = AsciiToCase(dst, src, end - src, 'a');
+	    src += len;
+	    dst += len;
+	    continue;
+	}
 	len = TclUtfToUniChar(src, &ch);
 	upChar = Tcl_UniCharToUpper(ch);
 
@@ -1371,7 +1525,7 @@ Tcl_UtfToLower(
     char *str)			/* String to convert in place. */
 {
     int ch, lowChar;
-    char *src, *dst;
+    char *src, *dst, *end;
     Tcl_Size len;
 
     /*
@@ -1379,7 +1533,14 @@ Tcl_UtfToLower(
      */
 
     src = dst = str;
-    while (*src) {
+    end = str + strlen(str);
+    while (src < end) {
+	if (UCHAR(*src) < 0x80) {
+	    len = AsciiToCase(dst, src, end - src, 'A');
+	    src += len;
+	    dst += len;
+	    continue;
+	}
 	len = TclUtfToUniChar(src, &ch);
 	lowChar = Tcl_UniCharToLower(ch);
 
@@ -1425,7 +1586,7 @@ Tcl_UtfToTitle(
     char *str)			/* String to convert in place. */
 {
     int ch, titleChar, lowChar;
-    char *src, *dst;
+    char *src, *dst, *end;
     Tcl_Size len;
 
     /*
@@ -1447,7 +1608,14 @@ Tcl_UtfToTitle(
 	}
 	src += len;
     }
-    while (*src) {
+    end = src + strlen(src);
+    while (src < end) {
+	if (UCHAR(*src) < 0x80) {
+	    len = AsciiToCase(dst, src, end - src, 'A');
+	    src += len;
+	    dst += len;
+	    continue;
+	}
 	len = TclUtfToUniChar(src, &ch);
 	lowChar = ch;
 	/* Special exception for Georgian Asomtavruli chars, no titlecase. */
@@ -2491,6 +2659,113 @@ TclUniCharCaseMatch(
     }
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclUniCharFind, TclUniCharFindLast --
+ *
+ *	Locate the first (last) occurrence of a needle in a counted Unicode
+ *	string. Longer searches use Boyer-Moore-Horspool skipping with a
+ *	shift table indexed by the low byte of each char; chars that collide
+ *	in the table share the smallest shift, so the search stays exact for
+ *	the whole Unicode range while the table stays small.
+ *
+ * Results:
+ *	The char index of the match, or -1 if needle does not occur in
+ *	string. The needle must be at least one char long.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+Tcl_Size
+TclUniCharFind(
+    const Tcl_UniChar *string,	/* String to search. */
+    Tcl_Size strLen,		/* Length of string, in chars. */
+    const Tcl_UniChar *needle,	/* Chars to look for. */
+    Tcl_Size needleLen)		/* Length of needle, in chars. */
+{
+    unsigned char shift[256];
+    Tcl_Size i, pos, last = strLen - needleLen;
+    Tcl_UniChar tail = needle[needleLen - 1];
+
+    if (last < 0) {
+	return -1;
+    }
+    if ((needleLen == 1) || (strLen < SEARCH_SKIP_THRESHOLD)) {
+	for (pos = 0; pos <= last; pos++) {
+	    if ((string[pos] == needle[0]) && (0 == memcmp(string + pos + 1,
+		    needle + 1, (needleLen - 1) * sizeof(Tcl_UniChar)))) {
+		return pos;
+	    }
+	}
+	return -1;
+    }
+
+    /*
+     * Shifts are capped at 255, which only shortens some skips.
+     */
+
+    memset(shift, (needleLen > 255) ? 255 : (int) needleLen, sizeof(shift));
+    for (i = 0; i < needleLen - 1; i++) {
+	Tcl_Size dist = needleLen - 1 - i;
+
+	shift[needle[i] & 0xFF] = (dist > 255) ? 255 : (unsigned char) dist;
+    }
+    for (pos = 0; pos <= last;
+	    pos += shift[string[pos + needleLen - 1] & 0xFF]) {
+	if ((string[pos + needleLen - 1] == tail) && (0 == memcmp(
+		string + pos, needle, (needleLen - 1) * sizeof(Tcl_UniChar)))) {
+	    return pos;
+	}
+    }
+    return -1;
+}
+
+Tcl_Size
+TclUniCharFindLast(
+    const Tcl_UniChar *string,	/* String to search. */
+    Tcl_Size strLen,		/* Length of string, in chars. */
+    const Tcl_UniChar *needle,	/* Chars to look for. */
+    Tcl_Size needleLen)		/* Length of needle, in chars. */
+{
+    unsigned char shift[256];
+    Tcl_Size i, pos;
+
+    if (strLen < needleLen) {
+	return -1;
+    }
+    if ((needleLen == 1) || (strLen < SEARCH_SKIP_THRESHOLD)) {
+	for (pos = strLen - needleLen; pos >= 0; pos--) {
+	    if ((string[pos] == needle[0]) && (0 == memcmp(string + pos + 1,
+		    needle + 1, (needleLen - 1) * sizeof(Tcl_UniChar)))) {
+		return pos;
+	    }
+	}
+	return -1;
+    }
+
+    /*
+     * Mirror image of TclUniCharFind: the window is keyed on its first
+     * char and slides towards the start of the string.
+     */
+
+    memset(shift, (needleLen > 255) ? 255 : (int) needleLen, sizeof(shift));
+    for (i = needleLen - 1; i > 0; i--) {
+	shift[needle[i] & 0xFF] = (i > 255) ? 255 : (unsigned char) i;
+    }
+    for (pos = strLen - needleLen; pos >= 0;
+	    pos -= shift[string[pos] & 0xFF]) {
+	if ((string[pos] == needle[0]) && (0 == memcmp(string + pos + 1,
+		needle + 1, (needleLen - 1) * sizeof(Tcl_UniChar)))) {
+	    return pos;
+	}
+    }
+    return -1;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -2501,6 +2776,10 @@ TclUniCharCaseMatch(
  *	Tcl_StringCaseMatch. This variant of TclUniCharCaseMatch uses counted
  *	Strings, so embedded NULLs are allowed.
  *
+ *	Patterns made of a literal with optional leading and trailing "*"s
+ *	are answered by direct comparison or substring search; everything
+ *	else goes to the backtracking matcher, UniCharMatch.
+ *
  * Results:
  *	The return value is 1 if string matches pattern, and 0 otherwise. The
  *	matching operation permits the following special characters in the
@@ -2520,6 +2799,76 @@ TclUniCharMatch(
 				 * characters. */
     Tcl_Size ptnLen,		/* Length of Pattern */
     int nocase)			/* 0 for case sensitive, 1 for insensitive */
+{
+    const Tcl_UniChar *lit = pattern, *litEnd = pattern + ptnLen, *p;
+    Tcl_Size litLen;
+
+    while ((lit < litEnd) && (*lit == '*')) {
+	lit++;
+    }
+    while ((litEnd > lit) && (litEnd[-1] == '*')) {
+	litEnd--;
+    }
+    for (p = lit; p < litEnd; p++) {
+	if ((*p == '*') || (*p == '?') || (*p == '[') || (*p == '\\')) {
+	    return UniCharMatch(string, strLen, pattern, ptnLen, nocase);
+	}
+    }
+    litLen = litEnd - lit;
+    if (litLen > strLen) {
+	return 0;
+    }
+    if (lit == pattern) {
+	/*
+	 * "lit" or "lit*": compare against the start of the string.
+	 */
+
+	if ((litEnd == pattern + ptnLen) && (litLen != strLen)) {
+	    return 0;
+	}
+    } else if (litEnd == pattern + ptnLen) {
+	/*
+	 * "*lit": compare against the end of the string.
+	 */
+
+	string += strLen - litLen;
+    } else if (litLen == 0) {
+	return 1;
+    } else if (nocase) {
+	return UniCharMatch(string, strLen, pattern, ptnLen, nocase);
+    } else {
+	return (TclUniCharFind(string, strLen, lit, litLen) >= 0);
+    }
+    if (nocase) {
+	return (TclUniCharNcasecmp(string, lit, litLen) == 0);
+    }
+    return (memcmp(string, lit, litLen * sizeof(Tcl_UniChar)) == 0);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * UniCharMatch --
+ *
+ *	Backtracking glob matcher behind TclUniCharMatch.
+ *
+ * Results:
+ *	The return value is 1 if string matches pattern, and 0 otherwise.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+UniCharMatch(
+    const Tcl_UniChar *string,	/* Unicode String. */
+    Tcl_Size strLen,		/* Length of String */
+    const Tcl_UniChar *pattern,	/* Pattern, which may contain special
+				 * characters. */
+    Tcl_Size ptnLen,		/* Length of Pattern */
+    int nocase)			/* 0 for case sensitive, 1 for insensitive */
 {
     const Tcl_UniChar *stringEnd, *patternEnd;
     Tcl_UniChar p;
@@ -2584,7 +2933,7 @@ TclUniCharMatch(
 			}
 		    }
 		}
-		if (TclUniCharMatch(string, stringEnd - string,
+		if (UniCharMatch(string, stringEnd - string,
 			pattern, patternEnd - pattern, nocase)) {
 		    return 1;
 		}
@@ -95,6 +95,14 @@ static ProcessGlobalValue executableName = {
 #define CONVERT_MASK	(CONVERT_BRACE | CONVERT_ESCAPE)
 #define CONVERT_ANY	16
 
+/*
+ * Strings shorter than this many bytes are searched by plain scanning in
+ * TclByteArrayFind and TclByteArrayFindLast; filling the shift table would
+ * cost more than it saves.
+ */
+
+#define SEARCH_SKIP_THRESHOLD	64
+
 /*
  * Prototypes for functions defined later in this file.
  */
@@ -112,6 +120,11 @@ static int		FindElement(Tcl_Interp *interp, const char *string,
 			    const char *typeCode, const char **elementPtr,
 			    const char **nextPtr, Tcl_Size *sizePtr,
 			    int *literalPtr);
+static int		ByteArrayMatch(const unsigned char *string,
+			    Tcl_Size strLen, const unsigned char *pattern,
+			    Tcl_Size ptnLen);
+static int		StringCaseMatch(const char *str, const char *pattern,
+			    int nocase);
 /*
  * The following is the Tcl object type definition for an object that
  * represents a list index in the form, "end-offset". It is used as a
@@ -2105,6 +2118,81 @@ Tcl_StringCaseMatch(
     const char *pattern,	/* Pattern, which may contain special
 				 * characters. */
     int nocase)			/* 0 for case sensitive, 1 for insensitive */
+{
+    const char *lit = pattern, *litEnd, *p;
+    size_t litLen, strLen;
+
+    /*
+     * A pattern that is an ASCII literal with optional leading and trailing
+     * "*"s is answered with byte comparisons: an ASCII byte in a UTF-8
+     * string is always a whole char, and no other byte sequence decodes to
+     * one. Case folding is left to the general matcher, since non-ASCII
+     * chars such as U+212A fold onto ASCII ones.
+     */
+
+    if (nocase) {
+	return StringCaseMatch(str, pattern, nocase);
+    }
+    while (*lit == '*') {
+	lit++;
+    }
+    for (p = lit; *p != '\0'; p++) {
+	if ((*p == '?') || (*p == '[') || (*p == '\\') || (UCHAR(*p) >= 0x80)) {
+	    return StringCaseMatch(str, pattern, nocase);
+	}
+    }
+    litEnd = p;
+    while ((litEnd > lit) && (litEnd[-1] == '*')) {
+	litEnd--;
+    }
+    for (p = lit; p < litEnd; p++) {
+	if (*p == '*') {
+	    return StringCaseMatch(str, pattern, nocase);
+	}
+    }
+    litLen = litEnd - lit;
+    if (lit == pattern) {
+	if (strncmp(str, lit, litLen) != 0) {
+	    return 0;
+	}
+	return ((*litEnd == '*') || (str[litLen] == '\0'));
+    }
+    if (litLen == 0) {
+	return 1;
+    }
+    strLen = strlen(str);
+    if (litLen > strLen) {
+	return 0;
+    }
+    if (*litEnd == '\0') {
+	return (memcmp(str + strLen - litLen, lit, litLen) == 0);
+    }
+    return (TclByteArrayFind((const unsigned char *) str, strLen,
+	    (const unsigned char *) lit, litLen) >= 0);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * StringCaseMatch --
+ *
+ *	Backtracking glob matcher behind Tcl_StringCaseMatch.
+ *
+ * Results:
+ *	The return value is 1 if string matches pattern, and 0 otherwise.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+StringCaseMatch(
+    const char *str,		/* String. */
+    const char *pattern,	/* Pattern, which may contain special
+				 * characters. */
+    int nocase)			/* 0 for case sensitive, 1 for insensitive */
 {
     int p, charLen;
     int ch1 = 0, ch2 = 0;
@@ -2189,7 +2277,7 @@ Tcl_StringCaseMatch(
 			}
 		    }
 		}
-		if (Tcl_StringCaseMatch(str, pattern, nocase)) {
+		if (StringCaseMatch(str, pattern, nocase)) {
 		    return 1;
 		}
 		if (*str == '\0') {
@@ -2314,6 +2402,113 @@ Tcl_StringCaseMatch(
     }
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclByteArrayFind, TclByteArrayFindLast --
+ *
+ *	Locate the first (last) occurrence of a needle in a counted byte
+ *	string. Short searches scan for the leading byte with memchr; longer
+ *	ones use Boyer-Moore-Horspool skipping.
+ *
+ * Results:
+ *	The byte index of the match, or -1 if needle does not occur in
+ *	string. The needle must be at least one byte long.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+Tcl_Size
+TclByteArrayFind(
+    const unsigned char *string,/* String to search. */
+    Tcl_Size strLen,		/* Length of string, in bytes. */
+    const unsigned char *needle,/* Bytes to look for. */
+    Tcl_Size needleLen)		/* Length of needle, in bytes. */
+{
+    unsigned char shift[256];
+    Tcl_Size i, pos, last = strLen - needleLen;
+    const unsigned char *check;
+
+    if (last < 0) {
+	return -1;
+    }
+    if ((needleLen == 1) || (strLen < SEARCH_SKIP_THRESHOLD)) {
+	for (pos = 0; pos <= last; pos = check - string + 1) {
+	    check = (const unsigned char *)
+		    memchr(string + pos, needle[0], last + 1 - pos);
+	    if (check == NULL) {
+		break;
+	    }
+	    if (0 == memcmp(check + 1, needle + 1, needleLen - 1)) {
+		return check - string;
+	    }
+	}
+	return -1;
+    }
+
+    /*
+     * Shifts are capped at 255, which only shortens some skips.
+     */
+
+    memset(shift, (needleLen > 255) ? 255 : (int) needleLen, sizeof(shift));
+    for (i = 0; i < needleLen - 1; i++) {
+	Tcl_Size dist = needleLen - 1 - i;
+
+	shift[needle[i]] = (dist > 255) ? 255 : (unsigned char) dist;
+    }
+    for (pos = 0; pos <= last; pos += shift[string[pos + needleLen - 1]]) {
+	if ((string[pos + needleLen - 1] == needle[needleLen - 1])
+		&& (0 == memcmp(string + pos, needle, needleLen - 1))) {
+	    return pos;
+	}
+    }
+    return -1;
+}
+
+Tcl_Size
+TclByteArrayFindLast(
+    const unsigned char *string,/* String to search. */
+    Tcl_Size strLen,		/* Length of string, in bytes. */
+    const unsigned char *needle,/* Bytes to look for. */
+    Tcl_Size needleLen)		/* Length of needle, in bytes. */
+{
+    unsigned char shift[256];
+    Tcl_Size i, pos;
+
+    if (strLen < needleLen) {
+	return -1;
+    }
+    if ((needleLen == 1) || (strLen < SEARCH_SKIP_THRESHOLD)) {
+	for (pos = strLen - needleLen; pos >= 0; pos--) {
+	    if ((string[pos] == needle[0])
+		    && (0 == memcmp(string + pos + 1, needle + 1, needleLen - 1))) {
+		return pos;
+	    }
+	}
+	return -1;
+    }
+
+    /*
+     * Mirror image of TclByteArrayFind: the window is keyed on its first
+     * byte and slides towards the start of the string.
+     */
+
+    memset(shift, (needleLen > 255) ? 255 : (int) needleLen, sizeof(shift));
+    for (i = needleLen - 1; i > 0; i--) {
+	shift[needle[i]] = (i > 255) ? 255 : (unsigned char) i;
+    }
+    for (pos = strLen - needleLen; pos >= 0; pos -= shift[string[pos]]) {
+	if ((string[pos] == needle[0])
+		&& (0 == memcmp(string + pos + 1, needle + 1, needleLen - 1))) {
+	    return pos;
+	}
+    }
+    return -1;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -2343,6 +2538,68 @@ TclByteArrayMatch(
 				 * characters. */
     Tcl_Size ptnLen,			/* Length of Pattern */
     TCL_UNUSED(int) /*flags*/)
+{
+    const unsigned char *lit = pattern, *litEnd = pattern + ptnLen, *p;
+    Tcl_Size litLen;
+
+    /*
+     * Literal patterns with optional leading and trailing "*"s are answered
+     * by direct comparison or substring search.
+     */
+
+    while ((lit < litEnd) && (*lit == '*')) {
+	lit++;
+    }
+    while ((litEnd > lit) && (litEnd[-1] == '*')) {
+	litEnd--;
+    }
+    for (p = lit; p < litEnd; p++) {
+	if ((*p == '*') || (*p == '?') || (*p == '[') || (*p == '\\')) {
+	    return ByteArrayMatch(string, strLen, pattern, ptnLen);
+	}
+    }
+    litLen = litEnd - lit;
+    if (litLen > strLen) {
+	return 0;
+    }
+    if (lit == pattern) {
+	if ((litEnd == pattern + ptnLen) && (litLen != strLen)) {
+	    return 0;
+	}
+    } else if (litEnd == pattern + ptnLen) {
+	string += strLen - litLen;
+    } else if (litLen == 0) {
+	return 1;
+    } else {
+	return (TclByteArrayFind(string, strLen, lit, litLen) >= 0);
+    }
+    return (memcmp(string, lit, litLen) == 0);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * ByteArrayMatch --
+ *
+ *	Backtracking glob matcher behind TclByteArrayMatch.
+ *
+ * Results:
+ *	The return value is 1 if string matches pattern, and 0 otherwise.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+ByteArrayMatch(
+    const unsigned char *string,/* String. */
+    Tcl_Size strLen,		/* Length of String */
+    const unsigned char *pattern,
+				/* Pattern, which may contain special
+				 * characters. */
+    Tcl_Size ptnLen)		/* Length of Pattern */
 {
     const unsigned char *stringEnd, *patternEnd;
     unsigned char p;
@@ -2397,8 +2654,8 @@ TclByteArrayMatch(
 			string++;
 		    }
 		}
-		if (TclByteArrayMatch(string, stringEnd - string,
-			pattern, patternEnd - pattern, 0)) {
+		if (ByteArrayMatch(string, stringEnd - string,
+			pattern, patternEnd - pattern)) {
 		    return 1;
 		}
 		if (string == stringEnd) {
@@ -451,6 +451,7 @@ static const Tcl_ChannelType zipChannelType = {
     ZipChannelWideSeek,
     NULL,			/* Thread action function. */
     NULL,			/* Truncate function. */
+    NULL,			/* Vectored output function. */
 };
 
 /*
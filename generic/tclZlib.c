@@ -222,7 +222,8 @@ static const Tcl_ChannelType zlibChannelType = {
     ZlibTransformEventHandler,
     NULL,			/* Seek proc. */
     NULL,			/* Thread action proc. */
-    NULL			/* Truncate proc. */
+    NULL,			/* Truncate proc. */
+    NULL			/* Vectored output proc. */
 };
 
 /*
@@ -0,0 +1,131 @@
+# encodingTables.tcl --
+#
+#	This program reads the single-byte table encodings in the
+#	library/encoding directory and generates the corresponding
+#	tclEncodingTables.c file, so that those encodings can be created
+#	without reading and parsing their .enc files at run time.
+#
+#	Usage: tclsh encodingTables.tcl <encodingDir> <outputDir>
+#
+# See the file "license.terms" for information on usage and redistribution
+# of this file, and for a DISCLAIMER OF ALL WARRANTIES.
+
+namespace eval enc {
+    variable tables {};		# list of {name fallback symbol page}
+				# entries, one per compiled-in encoding,
+				# sorted by name
+}
+
+# enc::readTable --
+#
+#	Parses one .enc file. Only single-byte encodings whose whole table
+#	fits in page 00 are accepted; anything else is left to be loaded from
+#	its file at run time.
+#
+# Results:
+#	A list {fallback symbol page}, where page is a list of 256 integers,
+#	or an empty list if the file is not a single-page table encoding.
+
+proc enc::readTable {fileName} {
+    set f [open $fileName r]
+    fconfigure $f -encoding utf-8
+    set lines [split [read $f] \n]
+    close $f
+
+    set i 0
+    while {[string index [lindex $lines $i] 0] eq "#"} {
+	incr i
+    }
+    if {[string trim [lindex $lines $i]] ne "S"} {
+	return {}
+    }
+    incr i
+    lassign [lindex $lines $i] fallback symbol numPages
+    if {$numPages != 1 || [string trim [lindex $lines [incr i]]] ne "00"} {
+	return {}
+    }
+
+    set page {}
+    for {set row 0} {$row < 16} {incr row} {
+	set line [string trim [lindex $lines [incr i]]]
+	if {[string length $line] != 64} {
+	    error "$fileName: malformed table row \"$line\""
+	}
+	foreach ch [regexp -all -inline {[0-9A-Fa-f]{4}} $line] {
+	    lappend page [scan $ch %x]
+	}
+    }
+    foreach line [lrange $lines [incr i] end] {
+	if {[string trim $line] ne ""} {
+	    # Trailing sections such as 'R'everse mappings are not supported.
+	    return {}
+	}
+    }
+    return [list [scan $fallback %x] $symbol $page]
+}
+
+proc enc::main {} {
+    global argc argv
+    variable tables
+
+    if {$argc != 2} {
+	puts stderr "\nusage: $argv0 <encodingDir> <outputDir>\n"
+	exit 1
+    }
+
+    foreach fileName [lsort [glob -directory [lindex $argv 0] *.enc]] {
+	set table [readTable $fileName]
+	if {[llength $table]} {
+	    lappend tables [list [file rootname [file tail $fileName]] {*}$table]
+	}
+    }
+    puts "[llength $tables] single-byte encodings"
+
+    set f [open [file join [lindex $argv 1] tclEncodingTables.c] w]
+    fconfigure $f -translation lf -encoding utf-8
+    puts $f "/*
+ * tclEncodingTables.c --
+ *
+ *	Tables for the single-byte encodings that are compiled into the Tcl
+ *	library instead of being read from library/encoding.  This file is
+ *	automatically generated by the tools/encodingTables.tcl script.  Do
+ *	not modify this file by hand.
+ *
+ * See the file \"license.terms\" for information on usage and redistribution
+ * of this file, and for a DISCLAIMER OF ALL WARRANTIES.
+ */
+
+/*
+ * Each entry holds the encoding name, its fallback character, whether it is
+ * a symbol encoding, and the 256 Unicode code points that its bytes map to.
+ * The entries are sorted by name.
+ */
+
+static const CompiledEncoding compiledEncodings\[\] = \{"
+    set last [expr {[llength $tables] - 1}]
+    foreach table $tables {
+	lassign $table name fallback symbol page
+	puts $f [format "    \{\"%s\", 0x%04X, %d, \{" $name $fallback $symbol]
+	for {set i 0} {$i < 256} {incr i 8} {
+	    set line "\t"
+	    foreach ch [lrange $page $i [expr {$i + 7}]] {
+		append line [format "0x%04X, " $ch]
+	    }
+	    if {$i == 248} {
+		set line [string trimright $line ", "]
+	    }
+	    puts $f [string trimright $line]
+	}
+	if {[incr last -1] >= 0} {
+	    puts $f "    \}\},"
+	} else {
+	    puts $f "    \}\}"
+	}
+    }
+    puts $f "\};"
+    close $f
+}
+
+enc::main
+
+return
@@ -26,6 +26,14 @@
 #include <sys/eventfd.h>
 #endif /* HAVE_EVENTFD */
 #include <sys/queue.h>
+#ifdef NOTIFIER_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#ifndef IORING_FEAT_EXT_ARG
+#   undef NOTIFIER_IO_URING	/* Kernel headers older than Linux 5.11 */
+#endif
+#endif /* NOTIFIER_IO_URING */
 
 /*
  * This structure is used to keep track of the notifier info for a registered
@@ -43,7 +51,6 @@ typedef struct FileHandler {
     Tcl_FileProc *proc;		/* Function to call, in the style of
 				 * Tcl_CreateFileHandler. */
     void *clientData;	/* Argument to pass to proc. */
-    struct FileHandler *nextPtr;/* Next in list of all files we care about. */
     LIST_ENTRY(FileHandler) readyNode;
 				/* Next/previous in list of FileHandlers asso-
 				 * ciated with regular files (S_IFREG) that are
@@ -63,11 +70,57 @@ struct ThreadSpecificData;
 struct PlatformEventData {
     FileHandler *filePtr;
     struct ThreadSpecificData *tsdPtr;
+#ifdef NOTIFIER_IO_URING
+    int armed;			/* True while the kernel holds a poll request
+				 * for this struct. */
+    int armedMask;		/* Poll events of that request. */
+    int armPending;		/* True while on the list of structs to arm
+				 * before the next wait. */
+    struct PlatformEventData *nextArmPtr;
+				/* Next in that list. */
+    LIST_ENTRY(PlatformEventData) orphanNode;
+				/* Next/previous in the list of structs whose
+				 * FileHandler is gone or has moved on to a
+				 * new struct, but which may still be named by
+				 * a completion. */
+#endif /* NOTIFIER_IO_URING */
 };
 
+#ifdef NOTIFIER_IO_URING
+/*
+ * The following structure holds the io_uring(7) instance of a thread, used
+ * instead of epoll(7) when configured with --enable-io-uring and the kernel
+ * supports it. Only poll requests are issued. They are one-shot, and are
+ * re-armed before each wait, which keeps the level-triggered behaviour of
+ * the epoll notifier. Requests made between two waits are submitted by the
+ * same io_uring_enter(2) call that waits.
+ */
+
+typedef struct {
+    int fd;			/* io_uring fd, or 0 when epoll(7) is used. */
+    unsigned *sqHead;		/* Submission queue, as mapped from the */
+    unsigned *sqTail;		/* kernel. */
+    unsigned *sqMask;
+    unsigned *sqArray;
+    unsigned sqEntries;
+    struct io_uring_sqe *sqes;
+    unsigned *cqHead;		/* Completion queue, as mapped from the */
+    unsigned *cqTail;		/* kernel. */
+    unsigned *cqMask;
+    struct io_uring_cqe *cqes;
+    void *ringAddr;		/* Mapping of both queues. */
+    size_t ringSize;
+    size_t sqesSize;		/* Size of the mapping of sqes. */
+} PlatformRing;
+
+#define PLATFORM_RING_ENTRIES	1024
+#endif /* NOTIFIER_IO_URING */
+
 /*
  * The following structure is what is added to the Tcl event queue when file
- * handlers are ready to fire.
+ * handlers are ready to fire. One is allocated for each ready descriptor;
+ * they cannot be kept on a free list here, because Tcl_ServiceEvent and
+ * Tcl_DeleteEvents release queued events with Tcl_Free themselves.
  */
 
 typedef struct {
@@ -89,8 +142,10 @@ typedef struct {
 LIST_HEAD(PlatformReadyFileHandlerList, FileHandler);
 typedef struct ThreadSpecificData {
     FileHandler *triggerFilePtr;
-    FileHandler *firstFileHandlerPtr;
-				/* Pointer to head of file handler list. */
+    FileHandler **fileHandlers;	/* Table of file handlers, indexed by file
+				 * descriptor. Slots without a handler are
+				 * NULL. */
+    int numFileHandlers;	/* Number of slots in fileHandlers. */
     struct PlatformReadyFileHandlerList firstReadyFileHandlerPtr;
 				/* Pointer to head of list of FileHandlers
 				 * associated with regular files (S_IFREG)
@@ -112,6 +167,14 @@ typedef struct ThreadSpecificData {
 				 * returned by epoll_wait(2). */
     size_t maxReadyEvents;	/* Count of epoll_events in readyEvents. */
     int asyncPending;		/* True when signal triggered thread. */
+#ifdef NOTIFIER_IO_URING
+    PlatformRing ring;		/* io_uring(7) instance, if in use. */
+    struct PlatformEventData *firstArmPtr;
+				/* Structs to arm before the next wait. */
+    LIST_HEAD(PlatformOrphanList, PlatformEventData) orphans;
+				/* Structs waiting for their last completion
+				 * before they can be freed. */
+#endif /* NOTIFIER_IO_URING */
 } ThreadSpecificData;
 
 static Tcl_ThreadDataKey dataKey;
@@ -120,12 +183,29 @@ static Tcl_ThreadDataKey dataKey;
  * Forward declarations.
  */
 
+static inline FileHandler *LookUpFileHandler(ThreadSpecificData *tsdPtr,
+			    int fd, FileHandler **prevPtrPtr);
 static void		PlatformEventsControl(FileHandler *filePtr,
 			    ThreadSpecificData *tsdPtr, int op, int isNew);
 static void		PlatformEventsInit(void);
 static int		PlatformEventsTranslate(struct epoll_event *event);
 static int		PlatformEventsWait(struct epoll_event *events,
 			    size_t numEvents, struct timeval *timePtr);
+#ifdef NOTIFIER_IO_URING
+static void		PlatformRingControl(FileHandler *filePtr,
+			    ThreadSpecificData *tsdPtr, int op, int isNew,
+			    int isRegular);
+static void		PlatformRingFinalize(ThreadSpecificData *tsdPtr);
+static int		PlatformRingInit(ThreadSpecificData *tsdPtr);
+static void		PlatformRingOrphan(ThreadSpecificData *tsdPtr,
+			    struct PlatformEventData *pedPtr);
+static void		PlatformRingQueue(ThreadSpecificData *tsdPtr,
+			    int opcode, int fd, unsigned events,
+			    struct PlatformEventData *pedPtr);
+static int		PlatformRingWait(ThreadSpecificData *tsdPtr,
+			    struct epoll_event *events, size_t numEvents,
+			    int timeout);
+#endif /* NOTIFIER_IO_URING */
 
 /*
  * Incorporate the base notifier implementation.
@@ -211,6 +291,10 @@ PlatformEventsControl(
 		Tcl_Alloc(sizeof(struct PlatformEventData));
 	newPedPtr->filePtr = filePtr;
 	newPedPtr->tsdPtr = tsdPtr;
+#ifdef NOTIFIER_IO_URING
+	newPedPtr->armed = 0;
+	newPedPtr->armPending = 0;
+#endif /* NOTIFIER_IO_URING */
 	filePtr->pedPtr = newPedPtr;
     }
     newEvent.data.ptr = filePtr->pedPtr;
@@ -226,6 +310,13 @@ PlatformEventsControl(
 	Tcl_Panic("fstat: %s", strerror(errno));
     }
 
+#ifdef NOTIFIER_IO_URING
+    if (tsdPtr->ring.fd > 0) {
+	PlatformRingControl(filePtr, tsdPtr, op, isNew,
+		S_ISREG(fdStat.st_mode));
+	return;
+    }
+#endif /* NOTIFIER_IO_URING */
    if (epoll_ctl(tsdPtr->eventsFd, op, filePtr->fd, &newEvent) == -1) {
        switch (errno) {
 	    case EPERM:
@@ -267,6 +358,7 @@ PlatformEventsControl(
  *	- The per-thread eventfd(2) is closed, if non-zero, and set to -1.
  *	- The per-thread epoll(7) fd is closed, if non-zero, and set to 0.
  *	- The per-thread epoll_event structs are freed, if any, and set to 0.
+ *	- The per-thread table of file handlers is freed, if any.
  *
  *	tsdPtr->notifierMutex is destroyed.
  *
@@ -297,6 +389,9 @@ TclpFinalizeNotifier(
 #endif /* HAVE_EVENTFD */
     Tcl_Free(tsdPtr->triggerFilePtr->pedPtr);
     Tcl_Free(tsdPtr->triggerFilePtr);
+#ifdef NOTIFIER_IO_URING
+    PlatformRingFinalize(tsdPtr);
+#endif /* NOTIFIER_IO_URING */
     if (tsdPtr->eventsFd > 0) {
 	close(tsdPtr->eventsFd);
 	tsdPtr->eventsFd = 0;
@@ -305,6 +400,11 @@ TclpFinalizeNotifier(
 	Tcl_Free(tsdPtr->readyEvents);
 	tsdPtr->maxReadyEvents = 0;
     }
+    if (tsdPtr->fileHandlers) {
+	Tcl_Free(tsdPtr->fileHandlers);
+	tsdPtr->fileHandlers = NULL;
+	tsdPtr->numFileHandlers = 0;
+    }
     pthread_mutex_unlock(&tsdPtr->notifierMutex);
     if ((errno = pthread_mutex_destroy(&tsdPtr->notifierMutex))) {
 	Tcl_Panic("pthread_mutex_destroy: %s", strerror(errno));
@@ -327,7 +427,8 @@ TclpFinalizeNotifier(
  *	The following per-thread entities are initialised:
  *	- notifierMutex is initialised.
  *	- The eventfd(2) is created w/ EFD_CLOEXEC and EFD_NONBLOCK.
- *	- The epoll(7) fd is created w/ EPOLL_CLOEXEC.
+ *	- The epoll(7) fd is created w/ EPOLL_CLOEXEC, unless an io_uring(7)
+ *	  instance could be set up to be used instead.
  *	- A FileHandler struct is allocated and initialised for the
  *	  eventfd(2), registering interest for TCL_READABLE on it via
  *	  PlatformEventsControl().
@@ -361,6 +462,9 @@ PlatformEventsInit(void)
     filePtr->fd = tsdPtr->triggerPipe[0];
 #endif /* HAVE_EVENTFD */
     tsdPtr->triggerFilePtr = filePtr;
+#ifdef NOTIFIER_IO_URING
+    if (!PlatformRingInit(tsdPtr))
+#endif /* NOTIFIER_IO_URING */
     if ((tsdPtr->eventsFd = epoll_create1(EPOLL_CLOEXEC)) == -1) {
 	Tcl_Panic("epoll_create1: %s", strerror(errno));
     }
@@ -468,6 +572,11 @@ PlatformEventsWait(
      */
 
     gettimeofday(&tv0, NULL);
+#ifdef NOTIFIER_IO_URING
+    if (tsdPtr->ring.fd > 0) {
+	numFound = PlatformRingWait(tsdPtr, events, numEvents, timeout);
+    } else
+#endif /* NOTIFIER_IO_URING */
     numFound = epoll_wait(tsdPtr->eventsFd, events, (int) numEvents, timeout);
     gettimeofday(&tv1, NULL);
     if (timePtr && (timePtr->tv_sec && timePtr->tv_usec)) {
@@ -485,6 +594,455 @@ PlatformEventsWait(
     }
     return numFound;
 }
+#ifdef NOTIFIER_IO_URING
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PlatformRingInit --
+ *
+ *	This function sets up an io_uring(7) instance for the thread of the
+ *	caller and maps its queues. Kernels lacking io_uring, or the features
+ *	this notifier relies on (Linux 5.11 or later), are left to epoll(7).
+ *
+ * Results:
+ *	Returns 1 if the instance is ready for use, 0 otherwise.
+ *
+ * Side effects:
+ *	On success, tsdPtr->ring is filled in and the lists of structs to
+ *	arm and of orphaned structs are initialised.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+PlatformRingInit(
+    ThreadSpecificData *tsdPtr)
+{
+    PlatformRing *ringPtr = &tsdPtr->ring;
+    struct io_uring_params params;
+    size_t sqSize, cqSize;
+    char *ringAddr;
+    void *sqesAddr;
+    int fd;
+
+    memset(&params, 0, sizeof(params));
+    fd = (int) syscall(__NR_io_uring_setup, PLATFORM_RING_ENTRIES, &params);
+    if (fd < 0) {
+	return 0;
+    }
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP)
+	    || !(params.features & IORING_FEAT_NODROP)
+	    || !(params.features & IORING_FEAT_EXT_ARG)) {
+	close(fd);
+	return 0;
+    }
+
+    sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqSize = params.cq_off.cqes
+	    + params.cq_entries * sizeof(struct io_uring_cqe);
+    ringPtr->ringSize = (sqSize > cqSize) ? sqSize : cqSize;
+    ringAddr = (char *) mmap(NULL, ringPtr->ringSize, PROT_READ | PROT_WRITE,
+	    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ringAddr == MAP_FAILED) {
+	close(fd);
+	return 0;
+    }
+    ringPtr->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqesAddr = mmap(NULL, ringPtr->sqesSize, PROT_READ | PROT_WRITE,
+	    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqesAddr == MAP_FAILED) {
+	munmap(ringAddr, ringPtr->ringSize);
+	close(fd);
+	return 0;
+    }
+
+    ringPtr->ringAddr = ringAddr;
+    ringPtr->sqHead = (unsigned *) (ringAddr + params.sq_off.head);
+    ringPtr->sqTail = (unsigned *) (ringAddr + params.sq_off.tail);
+    ringPtr->sqMask = (unsigned *) (ringAddr + params.sq_off.ring_mask);
+    ringPtr->sqArray = (unsigned *) (ringAddr + params.sq_off.array);
+    ringPtr->sqEntries = params.sq_entries;
+    ringPtr->sqes = (struct io_uring_sqe *) sqesAddr;
+    ringPtr->cqHead = (unsigned *) (ringAddr + params.cq_off.head);
+    ringPtr->cqTail = (unsigned *) (ringAddr + params.cq_off.tail);
+    ringPtr->cqMask = (unsigned *) (ringAddr + params.cq_off.ring_mask);
+    ringPtr->cqes = (struct io_uring_cqe *) (ringAddr + params.cq_off.cqes);
+    ringPtr->fd = fd;
+    tsdPtr->firstArmPtr = NULL;
+    LIST_INIT(&tsdPtr->orphans);
+    return 1;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PlatformRingFinalize --
+ *
+ *	This function releases the io_uring(7) instance of the thread of the
+ *	caller, if any, and the structs still waiting for a completion.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The queues are unmapped and the io_uring fd is closed and set to 0.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+PlatformRingFinalize(
+    ThreadSpecificData *tsdPtr)
+{
+    PlatformRing *ringPtr = &tsdPtr->ring;
+    struct PlatformEventData *pedPtr;
+
+    if (ringPtr->fd <= 0) {
+	return;
+    }
+    munmap(ringPtr->sqes, ringPtr->sqesSize);
+    munmap(ringPtr->ringAddr, ringPtr->ringSize);
+    close(ringPtr->fd);
+    ringPtr->fd = 0;
+    while ((pedPtr = LIST_FIRST(&tsdPtr->orphans)) != NULL) {
+	LIST_REMOVE(pedPtr, orphanNode);
+	Tcl_Free(pedPtr);
+    }
+    tsdPtr->firstArmPtr = NULL;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PlatformRingQueue --
+ *
+ *	This function adds a poll request to the submission queue. It is sent
+ *	to the kernel by the next call to PlatformRingWait, or right away if
+ *	the queue is full.
+ *
+ *	IORING_OP_POLL_ADD requests wait for the given poll(2) events on fd.
+ *	IORING_OP_POLL_REMOVE requests cancel the poll request of pedPtr.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	May call io_uring_enter(2).
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+PlatformRingQueue(
+    ThreadSpecificData *tsdPtr,
+    int opcode,
+    int fd,
+    unsigned events,
+    struct PlatformEventData *pedPtr)
+{
+    PlatformRing *ringPtr = &tsdPtr->ring;
+    struct io_uring_sqe *sqePtr;
+    unsigned tail = *ringPtr->sqTail;
+    unsigned index;
+
+    while (tail - __atomic_load_n(ringPtr->sqHead, __ATOMIC_ACQUIRE)
+	    >= ringPtr->sqEntries) {
+	if (syscall(__NR_io_uring_enter, ringPtr->fd,
+		tail - *ringPtr->sqHead, 0, 0, NULL, 0) == -1
+		&& errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+	    Tcl_Panic("io_uring_enter: %s", strerror(errno));
+	}
+    }
+
+    index = tail & *ringPtr->sqMask;
+    sqePtr = &ringPtr->sqes[index];
+    memset(sqePtr, 0, sizeof(*sqePtr));
+    sqePtr->opcode = (uint8_t) opcode;
+    if (opcode == IORING_OP_POLL_ADD) {
+	sqePtr->fd = fd;
+#if __BYTE_ORDER == __BIG_ENDIAN
+	events = (events << 16) | (events >> 16);
+#endif
+	sqePtr->poll32_events = events;
+	sqePtr->user_data = (uint64_t) (uintptr_t) pedPtr;
+    } else {
+	sqePtr->fd = -1;
+	sqePtr->addr = (uint64_t) (uintptr_t) pedPtr;
+	sqePtr->user_data = 0;
+    }
+    ringPtr->sqArray[index] = index;
+    __atomic_store_n(ringPtr->sqTail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PlatformRingOrphan --
+ *
+ *	This function detaches pedPtr from its FileHandler. If the kernel
+ *	still holds a poll request for it, the request is cancelled and
+ *	pedPtr is freed once its completion has been seen.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	pedPtr is freed or added to the list of orphaned structs.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+PlatformRingOrphan(
+    ThreadSpecificData *tsdPtr,
+    struct PlatformEventData *pedPtr)
+{
+    pedPtr->filePtr = NULL;
+    if (pedPtr->armed) {
+	PlatformRingQueue(tsdPtr, IORING_OP_POLL_REMOVE, -1, 0, pedPtr);
+    } else if (!pedPtr->armPending) {
+	Tcl_Free(pedPtr);
+	return;
+    }
+    LIST_INSERT_HEAD(&tsdPtr->orphans, pedPtr, orphanNode);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PlatformRingControl --
+ *
+ *	This function is the io_uring(7) counterpart of the epoll_ctl(2) call
+ *	in PlatformEventsControl. Regular files are kept on the list of ready
+ *	FileHandlers, as with epoll(7). Other files get a poll request when
+ *	PlatformRingWait is next called.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	When the events of interest of an armed FileHandler change, its poll
+ *	request is cancelled and a new PlatformEventData struct is associated
+ *	with it.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+PlatformRingControl(
+    FileHandler *filePtr,
+    ThreadSpecificData *tsdPtr,
+    int op,
+    int isNew,
+    int isRegular)
+{
+    struct PlatformEventData *pedPtr = filePtr->pedPtr;
+
+    if (isRegular) {
+	switch (op) {
+	case EPOLL_CTL_ADD:
+	    if (isNew) {
+		LIST_INSERT_HEAD(&tsdPtr->firstReadyFileHandlerPtr, filePtr,
+			readyNode);
+	    }
+	    break;
+	case EPOLL_CTL_DEL:
+	    LIST_REMOVE(filePtr, readyNode);
+	    break;
+	}
+	return;
+    }
+
+    switch (op) {
+    case EPOLL_CTL_ADD:
+    case EPOLL_CTL_MOD:
+	if (pedPtr->armed) {
+	    unsigned events = 0;
+
+	    if (filePtr->mask & (TCL_READABLE | TCL_EXCEPTION)) {
+		events |= EPOLLIN;
+	    }
+	    if (filePtr->mask & TCL_WRITABLE) {
+		events |= EPOLLOUT;
+	    }
+	    if ((int) events == pedPtr->armedMask) {
+		return;
+	    }
+	    PlatformRingOrphan(tsdPtr, pedPtr);
+	    pedPtr = (struct PlatformEventData *)
+		    Tcl_Alloc(sizeof(struct PlatformEventData));
+	    pedPtr->filePtr = filePtr;
+	    pedPtr->tsdPtr = tsdPtr;
+	    pedPtr->armed = 0;
+	    pedPtr->armPending = 0;
+	    filePtr->pedPtr = pedPtr;
+	}
+	if (!pedPtr->armPending) {
+	    pedPtr->armPending = 1;
+	    pedPtr->nextArmPtr = tsdPtr->firstArmPtr;
+	    tsdPtr->firstArmPtr = pedPtr;
+	}
+	break;
+    case EPOLL_CTL_DEL:
+	filePtr->pedPtr = NULL;
+	PlatformRingOrphan(tsdPtr, pedPtr);
+	break;
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PlatformRingWait --
+ *
+ *	This function is the io_uring(7) counterpart of epoll_wait(2). It
+ *	arms the poll requests queued since the last call, submits them, and
+ *	waits for completions with a single io_uring_enter(2) call.
+ *
+ * Results:
+ *	Returns the number of events stored in events, which are laid out as
+ *	epoll_wait(2) would return them. The poll(2) and epoll(7) event bits
+ *	have the same values on Linux.
+ *
+ * Side effects:
+ *	FileHandlers whose poll request completed are queued to be armed
+ *	again before the next wait. Orphaned structs whose last completion
+ *	is seen are freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+PlatformRingWait(
+    ThreadSpecificData *tsdPtr,
+    struct epoll_event *events,
+    size_t numEvents,
+    int timeout)		/* In milliseconds, -1 to wait forever. */
+{
+    PlatformRing *ringPtr = &tsdPtr->ring;
+    struct PlatformEventData *pedPtr;
+    struct io_uring_getevents_arg arg;
+    struct __kernel_timespec ts;
+    unsigned head, tail, flags = IORING_ENTER_EXT_ARG;
+    int numFound = 0;
+
+    while ((pedPtr = tsdPtr->firstArmPtr) != NULL) {
+	unsigned mask = 0;
+
+	tsdPtr->firstArmPtr = pedPtr->nextArmPtr;
+	pedPtr->armPending = 0;
+	if (pedPtr->filePtr == NULL) {
+	    if (!pedPtr->armed) {
+		LIST_REMOVE(pedPtr, orphanNode);
+		Tcl_Free(pedPtr);
+	    }
+	    continue;
+	}
+	if (pedPtr->filePtr->mask & (TCL_READABLE | TCL_EXCEPTION)) {
+	    mask |= EPOLLIN;
+	}
+	if (pedPtr->filePtr->mask & TCL_WRITABLE) {
+	    mask |= EPOLLOUT;
+	}
+	if (pedPtr->armed || !mask) {
+	    continue;
+	}
+	PlatformRingQueue(tsdPtr, IORING_OP_POLL_ADD, pedPtr->filePtr->fd,
+		mask, pedPtr);
+	pedPtr->armed = 1;
+	pedPtr->armedMask = (int) mask;
+    }
+
+    memset(&arg, 0, sizeof(arg));
+    if (timeout >= 0) {
+	ts.tv_sec = timeout / 1000;
+	ts.tv_nsec = (long long) (timeout % 1000) * 1000000;
+	arg.ts = (uint64_t) (uintptr_t) &ts;
+    }
+    if (timeout != 0) {
+	flags |= IORING_ENTER_GETEVENTS;
+    }
+    if (syscall(__NR_io_uring_enter, ringPtr->fd,
+	    *ringPtr->sqTail - __atomic_load_n(ringPtr->sqHead,
+	    __ATOMIC_ACQUIRE), (timeout != 0), flags, &arg, sizeof(arg)) == -1
+	    && errno != EINTR && errno != ETIME && errno != EAGAIN
+	    && errno != EBUSY) {
+	return -1;
+    }
+
+    head = *ringPtr->cqHead;
+    tail = __atomic_load_n(ringPtr->cqTail, __ATOMIC_ACQUIRE);
+    while ((head != tail) && ((size_t) numFound < numEvents)) {
+	struct io_uring_cqe *cqePtr = &ringPtr->cqes[head & *ringPtr->cqMask];
+
+	head++;
+	pedPtr = (struct PlatformEventData *) (uintptr_t) cqePtr->user_data;
+	if (pedPtr == NULL) {
+	    continue;		/* Completion of an IORING_OP_POLL_REMOVE. */
+	}
+	pedPtr->armed = 0;
+	if (pedPtr->filePtr == NULL) {
+	    if (!pedPtr->armPending) {
+		LIST_REMOVE(pedPtr, orphanNode);
+		Tcl_Free(pedPtr);
+	    }
+	    continue;
+	}
+	if (cqePtr->res < 0) {
+	    continue;		/* Not armed again, e.g. after EBADF. */
+	}
+	if (!pedPtr->armPending) {
+	    pedPtr->armPending = 1;
+	    pedPtr->nextArmPtr = tsdPtr->firstArmPtr;
+	    tsdPtr->firstArmPtr = pedPtr;
+	}
+	events[numFound].events = (uint32_t) cqePtr->res;
+	events[numFound].data.ptr = pedPtr;
+	numFound++;
+    }
+    __atomic_store_n(ringPtr->cqHead, head, __ATOMIC_RELEASE);
+    return numFound;
+}
+#endif /* NOTIFIER_IO_URING */
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * LookUpFileHandler --
+ *
+ *	Look up the file handler structure associated with a file descriptor
+ *	in the table of file handlers of the thread of the caller. This
+ *	replaces the version in tclUnixNotfy.c, which walks a list and would
+ *	make every file event and every change of interest cost time in
+ *	proportion to the number of watched files.
+ *
+ * Returns:
+ *	A pointer to the file handler, or NULL if it can't be found.
+ *
+ * Side effects:
+ *	If prevPtrPtr is non-NULL, NULL is written to it: handlers are not
+ *	chained, so there is no previous one to report.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static inline FileHandler *
+LookUpFileHandler(
+    ThreadSpecificData *tsdPtr,	/* Where to look things up. */
+    int fd,			/* What we are looking for. */
+    FileHandler **prevPtrPtr)	/* If non-NULL, where to report the previous
+				 * pointer. */
+{
+    if (prevPtrPtr) {
+	*prevPtrPtr = NULL;
+    }
+    if (fd < 0 || fd >= tsdPtr->numFileHandlers) {
+	return NULL;
+    }
+    return tsdPtr->fileHandlers[fd];
+}
+
 
 /*
  *----------------------------------------------------------------------
@@ -520,11 +1078,21 @@ TclpCreateFileHandler(
     int isNew = (filePtr == NULL);
 
     if (isNew) {
+	if (fd >= tsdPtr->numFileHandlers) {
+	    int numFileHandlers = tsdPtr->numFileHandlers;
+
+	    tsdPtr->numFileHandlers = (fd < 32) ? 64 : 2 * fd;
+	    tsdPtr->fileHandlers = (FileHandler **) Tcl_Realloc(
+		    tsdPtr->fileHandlers,
+		    tsdPtr->numFileHandlers * sizeof(FileHandler *));
+	    memset(tsdPtr->fileHandlers + numFileHandlers, 0,
+		    (tsdPtr->numFileHandlers - numFileHandlers)
+		    * sizeof(FileHandler *));
+	}
 	filePtr = (FileHandler *) Tcl_Alloc(sizeof(FileHandler));
 	filePtr->fd = fd;
 	filePtr->readyMask = 0;
-	filePtr->nextPtr = tsdPtr->firstFileHandlerPtr;
-	tsdPtr->firstFileHandlerPtr = filePtr;
+	tsdPtr->fileHandlers[fd] = filePtr;
     }
     filePtr->proc = proc;
     filePtr->clientData = clientData;
@@ -559,14 +1127,14 @@ TclpDeleteFileHandler(
     int fd)			/* Stream id for which to remove callback
 				 * function. */
 {
-    FileHandler *filePtr, *prevPtr;
+    FileHandler *filePtr;
     ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
 
     /*
      * Find the entry for the given file (and return if there isn't one).
      */
 
-    filePtr = LookUpFileHandler(tsdPtr, fd, &prevPtr);
+    filePtr = LookUpFileHandler(tsdPtr, fd, NULL);
     if (filePtr == NULL) {
 	return;
     }
@@ -584,11 +1152,7 @@ TclpDeleteFileHandler(
      * Clean up information in the callback record.
      */
 
-    if (prevPtr == NULL) {
-	tsdPtr->firstFileHandlerPtr = filePtr->nextPtr;
-    } else {
-	prevPtr->nextPtr = filePtr->nextPtr;
-    }
+    tsdPtr->fileHandlers[fd] = NULL;
     Tcl_Free(filePtr);
 }
 
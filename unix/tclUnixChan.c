@@ -13,6 +13,9 @@
 
 #include "tclInt.h"	/* Internal definitions for Tcl. */
 #include "tclIO.h"	/* To get Channel type declaration. */
+#ifdef __linux__
+#   include <sys/sendfile.h>
+#endif
 
 #undef SUPPORTS_TTY
 #if defined(HAVE_TERMIOS_H)
@@ -131,6 +134,9 @@ static int		FileInputProc(void *instanceData, char *buf,
 			    int toRead, int *errorCode);
 static int		FileOutputProc(void *instanceData,
 			    const char *buf, int toWrite, int *errorCode);
+static int		FileOutputvProc(void *instanceData,
+			    const Tcl_ChannelIOVec *vec, int count,
+			    int *errorCode);
 static int		FileTruncateProc(void *instanceData,
 			    long long length);
 static long long	FileWideSeekProc(void *instanceData,
@@ -161,7 +167,7 @@ static int		TtySetOptionProc(void *instanceData,
 
 static const Tcl_ChannelType fileChannelType = {
     "file",			/* Type name. */
-    TCL_CHANNEL_VERSION_5,
+    TCL_CHANNEL_VERSION_6,
     NULL,			/* Deprecated. */
     FileInputProc,
     FileOutputProc,
@@ -176,7 +182,8 @@ static const Tcl_ChannelType fileChannelType = {
     NULL,			/* Bubbled event handler proc. */
     FileWideSeekProc,
     NULL,			/* Thread action proc. */
-    FileTruncateProc
+    FileTruncateProc,
+    FileOutputvProc
 };
 
 #ifdef SUPPORTS_TTY
@@ -187,7 +194,7 @@ static const Tcl_ChannelType fileChannelType = {
 
 static const Tcl_ChannelType ttyChannelType = {
     "tty",
-    TCL_CHANNEL_VERSION_5,
+    TCL_CHANNEL_VERSION_6,
     NULL,			/* Deprecated. */
     FileInputProc,
     FileOutputProc,
@@ -202,7 +209,8 @@ static const Tcl_ChannelType ttyChannelType = {
     NULL,			/* Bubbled event handler proc. */
     NULL,			/* Seek proc. */
     NULL,			/* Thread action proc. */
-    NULL			/* Truncate proc. */
+    NULL,			/* Truncate proc. */
+    FileOutputvProc
 };
 #endif	/* SUPPORTS_TTY */
 
@@ -335,6 +343,36 @@ FileOutputProc(
     return -1;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * FileOutputvProc --
+ *
+ *	This function is invoked from the generic IO level to write several
+ *	buffers of output to a file or terminal channel at once.
+ *
+ * Results:
+ *	The number of bytes written is returned or -1 on error. An output
+ *	argument contains a POSIX error code if an error occurred, or zero.
+ *
+ * Side effects:
+ *	Writes output on the output device of the channel.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+FileOutputvProc(
+    void *instanceData,		/* File state. */
+    const Tcl_ChannelIOVec *vec,/* The data buffers. */
+    int count,			/* How many buffers to write? */
+    int *errorCodePtr)		/* Where to store error code. */
+{
+    FileState *fsPtr = (FileState *)instanceData;
+
+    return TclUnixWritev(fsPtr->fd, vec, count, errorCodePtr);
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -2161,6 +2199,79 @@ FileTruncateProc(
     return 0;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclpChannelSendfile --
+ *
+ *	Asks the kernel to move bytes from one channel to another without
+ *	passing them through user space. Used by [chan copy] when neither
+ *	channel has buffered data or any transformation applied. Only Linux
+ *	sendfile() is supported, and only when the input is a regular file
+ *	and the output is a file, pipe or TCP socket.
+ *
+ * Results:
+ *	The number of bytes moved, 0 at the end of the input file, or -1 in
+ *	which case *errorCodePtr is set. EAGAIN means the output cannot
+ *	take more data now; any other code means the caller should move the
+ *	data itself. Nothing has been transferred when -1 is returned.
+ *
+ * Side effects:
+ *	Advances the file position of the input and, for files, the output.
+ *
+ *----------------------------------------------------------------------
+ */
+
+long long
+TclpChannelSendfile(
+    Tcl_Channel inChan,		/* Unstacked channel to read from. */
+    Tcl_Channel outChan,	/* Unstacked channel to write to. */
+    long long toCopy,		/* Maximum number of bytes to move. */
+    int *errorCodePtr)		/* Where to store the error code. */
+{
+#ifdef __linux__
+    const Tcl_ChannelType *outTypePtr = Tcl_GetChannelType(outChan);
+    void *inData, *outData;
+    Tcl_StatBuf buf;
+    ssize_t moved;
+
+    if ((Tcl_GetChannelType(inChan) != &fileChannelType)
+	    || ((outTypePtr != &fileChannelType)
+		&& (strcmp(outTypePtr->typeName, "tcp") != 0)
+		&& (strcmp(outTypePtr->typeName, "pipe") != 0))
+	    || (Tcl_GetChannelHandle(inChan, TCL_READABLE, &inData) != TCL_OK)
+	    || (Tcl_GetChannelHandle(outChan, TCL_WRITABLE, &outData) != TCL_OK)
+	    || (TclOSfstat(PTR2INT(inData), &buf) != 0)
+	    || !S_ISREG(buf.st_mode)) {
+	*errorCodePtr = ENOTSUP;
+	return -1;
+    }
+
+    /*
+     * Linux moves at most 0x7FFFF000 bytes per call whatever is asked.
+     */
+
+    if (toCopy > 0x7FFFF000) {
+	toCopy = 0x7FFFF000;
+    }
+    do {
+	moved = sendfile(PTR2INT(outData), PTR2INT(inData), NULL,
+		(size_t) toCopy);
+    } while ((moved < 0) && (errno == EINTR));
+    if (moved < 0) {
+	*errorCodePtr = (errno == EWOULDBLOCK) ? EAGAIN : errno;
+	return -1;
+    }
+    return moved;
+#else
+    (void)inChan;
+    (void)outChan;
+    (void)toCopy;
+    *errorCodePtr = ENOTSUP;
+    return -1;
+#endif /* __linux__ */
+}
+
 /*
  * Local Variables:
  * mode: c
@@ -10,6 +10,7 @@
 #include "tclInt.h"
 #include <errno.h>
 #include <string.h>
+#include <sys/uio.h>
 
 /*
  * See also: SC_BLOCKING_STYLE in unix/tcl.m4
@@ -159,6 +160,54 @@ TclUnixSetBlockingMode(
 #endif /* !USE_FIONBIO */
 }
 
+/*
+ *---------------------------------------------------------------------------
+ *
+ * TclUnixWritev --
+ *
+ *	Writes several buffers to a file descriptor with a single writev()
+ *	call. Shared by the output vector procs of the file, pipe and TCP
+ *	channel drivers.
+ *
+ * Results:
+ *	The number of bytes written, which may be fewer than requested, or -1
+ *	with the POSIX error code stored in *errorCodePtr.
+ *
+ *---------------------------------------------------------------------------
+ */
+
+#define UNIX_IOV_MAX	64
+
+int
+TclUnixWritev(
+    int fd,			/* File descriptor to write to. */
+    const Tcl_ChannelIOVec *vec,/* The buffers to write. */
+    int count,			/* Number of buffers in vec. */
+    int *errorCodePtr)		/* Where to store the error code. */
+{
+    struct iovec iov[UNIX_IOV_MAX];
+    ssize_t written;
+    int i;
+
+    if (count > UNIX_IOV_MAX) {
+	count = UNIX_IOV_MAX;
+    }
+    for (i = 0; i < count; i++) {
+	iov[i].iov_base = (void *) vec[i].buf;
+	iov[i].iov_len = (size_t) vec[i].len;
+    }
+
+    *errorCodePtr = 0;
+    do {
+	written = writev(fd, iov, count);
+    } while ((written < 0) && (errno == EINTR));
+    if (written < 0) {
+	*errorCodePtr = errno;
+	return -1;
+    }
+    return (int) written;
+}
+
 /*
  *---------------------------------------------------------------------------
  *
@@ -157,9 +157,13 @@ TclpAlertNotifier(
  *	If prevPtrPtr is non-NULL, it will be written to if the file handler
  *	is found.
  *
+ *	The epoll notifier keeps its file handlers in a table indexed by file
+ *	descriptor and has its own version of this function.
+ *
  *----------------------------------------------------------------------
  */
 
+#ifndef NOTIFIER_EPOLL
 static inline FileHandler *
 LookUpFileHandler(
     ThreadSpecificData *tsdPtr,	/* Where to look things up. */
@@ -192,6 +196,7 @@ LookUpFileHandler(
     }
     return filePtr;
 }
+#endif /* !NOTIFIER_EPOLL */
 
 /*
  *----------------------------------------------------------------------
@@ -290,20 +295,15 @@ FileHandlerEventProc(
     }
 
     /*
-     * Search through the file handlers to find the one whose handle matches
-     * the event. We do this rather than keeping a pointer to the file handler
-     * directly in the event, so that the handler can be deleted while the
-     * event is queued without leaving a dangling pointer.
+     * Look up the file handler whose handle matches the event. We do this
+     * rather than keeping a pointer to the file handler directly in the
+     * event, so that the handler can be deleted while the event is queued
+     * without leaving a dangling pointer.
      */
 
     tsdPtr = TCL_TSD_INIT(&dataKey);
-
-    for (filePtr = tsdPtr->firstFileHandlerPtr; filePtr != NULL;
-	    filePtr = filePtr->nextPtr) {
-	if (filePtr->fd != fileEvPtr->fd) {
-	    continue;
-	}
-
+    filePtr = LookUpFileHandler(tsdPtr, fileEvPtr->fd, NULL);
+    if (filePtr != NULL) {
 	/*
 	 * The code is tricky for two reasons:
 	 * 1. The file handler's desired events could have changed since the
@@ -321,7 +321,6 @@ FileHandlerEventProc(
 	if (mask != 0) {
 	    filePtr->proc(filePtr->clientData, mask);
 	}
-	break;
     }
     return 1;
 }
@@ -68,6 +68,9 @@ static int		PipeInputProc(void *instanceData, char *buf,
 			    int toRead, int *errorCode);
 static int		PipeOutputProc(void *instanceData,
 			    const char *buf, int toWrite, int *errorCode);
+static int		PipeOutputvProc(void *instanceData,
+			    const Tcl_ChannelIOVec *vec, int count,
+			    int *errorCode);
 static void		PipeWatchProc(void *instanceData, int mask);
 static void		RestoreSignals(void);
 static int		SetupStdFile(TclFile file, int type);
@@ -79,7 +82,7 @@ static int		SetupStdFile(TclFile file, int type);
 
 static const Tcl_ChannelType pipeChannelType = {
     "pipe",
-    TCL_CHANNEL_VERSION_5,
+    TCL_CHANNEL_VERSION_6,
     NULL,			/* Deprecated. */
     PipeInputProc,
     PipeOutputProc,
@@ -94,7 +97,8 @@ static const Tcl_ChannelType pipeChannelType = {
     NULL,			/* Bubbled event handler proc. */
     NULL,			/* Seek proc. */
     NULL,			/* Thread action proc. */
-    NULL			/* Truncation proc. */
+    NULL,			/* Truncation proc. */
+    PipeOutputvProc
 };
 
 /*
@@ -1217,6 +1221,36 @@ PipeOutputProc(
     return written;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * PipeOutputvProc --
+ *
+ *	This function is invoked from the generic IO level to write several
+ *	buffers of output to a command pipeline based channel at once.
+ *
+ * Results:
+ *	The number of bytes written is returned or -1 on error. An output
+ *	argument contains a POSIX error code if an error occurred, or zero.
+ *
+ * Side effects:
+ *	Writes output on the output device of the channel.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+PipeOutputvProc(
+    void *instanceData,		/* Pipe state. */
+    const Tcl_ChannelIOVec *vec,/* The data buffers. */
+    int count,			/* How many buffers to write? */
+    int *errorCodePtr)		/* Where to store error code. */
+{
+    PipeState *psPtr = (PipeState *)instanceData;
+
+    return TclUnixWritev(GetFd(psPtr->outFile), vec, count, errorCodePtr);
+}
+
 /*
  *----------------------------------------------------------------------
  *
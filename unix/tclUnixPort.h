@@ -146,6 +146,9 @@ extern "C" {
 #include <unistd.h>
 
 MODULE_SCOPE int TclUnixSetBlockingMode(int fd, int mode);
+struct Tcl_ChannelIOVec; /* forward declaration, see tcl.h */
+MODULE_SCOPE int TclUnixWritev(int fd, const struct Tcl_ChannelIOVec *vec,
+			    int count, int *errorCodePtr);
 
 #include <utime.h>
 
@@ -11,6 +11,7 @@
 
 #include "tclInt.h"
 #include <netinet/tcp.h>
+#include <sys/uio.h>
 
 /*
  * Helper macros to make parts of this file clearer. The macros do exactly
@@ -139,6 +140,9 @@ static int		TcpInputProc(void *instanceData, char *buf,
 			    int toRead, int *errorCode);
 static int		TcpOutputProc(void *instanceData,
 			    const char *buf, int toWrite, int *errorCode);
+static int		TcpOutputvProc(void *instanceData,
+			    const Tcl_ChannelIOVec *vec, int count,
+			    int *errorCode);
 static int		TcpSetOptionProc(void *instanceData,
 			    Tcl_Interp *interp, const char *optionName,
 			    const char *value);
@@ -154,7 +158,7 @@ static Tcl_FileProc	WrapNotify;
 
 static const Tcl_ChannelType tcpChannelType = {
     "tcp",
-    TCL_CHANNEL_VERSION_5,
+    TCL_CHANNEL_VERSION_6,
     NULL,			/* Deprecated. */
     TcpInputProc,
     TcpOutputProc,
@@ -169,7 +173,8 @@ static const Tcl_ChannelType tcpChannelType = {
     NULL,			/* Bubbled event handler proc. */
     NULL,			/* Seek proc. */
     TcpThreadActionProc,
-    NULL			/* Truncate proc. */
+    NULL,			/* Truncate proc. */
+    TcpOutputvProc
 };
 
 /*
@@ -573,6 +578,64 @@ TcpOutputProc(
     return -1;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TcpOutputvProc --
+ *
+ *	This function is invoked by the generic IO level to write several
+ *	buffers of output to a TCP socket based channel at once. Like
+ *	TcpOutputProc it uses sendmsg, not writev, to get reliable error
+ *	reporting.
+ *
+ * Results:
+ *	The number of bytes written is returned. An output argument is set to
+ *	a POSIX error code if an error occurred, or zero.
+ *
+ * Side effects:
+ *	Writes output on the output device of the channel.
+ *
+ *----------------------------------------------------------------------
+ */
+
+#define TCP_IOV_MAX	64
+
+static int
+TcpOutputvProc(
+    void *instanceData,		/* Socket state. */
+    const Tcl_ChannelIOVec *vec,/* The data buffers. */
+    int count,			/* How many buffers to write? */
+    int *errorCodePtr)		/* Where to store error code. */
+{
+    TcpState *statePtr = (TcpState *)instanceData;
+    struct iovec iov[TCP_IOV_MAX];
+    struct msghdr msg;
+    ssize_t written;
+    int i;
+
+    *errorCodePtr = 0;
+    if (WaitForConnect(statePtr, errorCodePtr) != 0) {
+	return -1;
+    }
+    if (count > TCP_IOV_MAX) {
+	count = TCP_IOV_MAX;
+    }
+    for (i = 0; i < count; i++) {
+	iov[i].iov_base = (void *) vec[i].buf;
+	iov[i].iov_len = (size_t) vec[i].len;
+    }
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+    written = sendmsg(statePtr->fds.fd, &msg, 0);
+
+    if (written >= 0) {
+	return (int) written;
+    }
+    *errorCodePtr = errno;
+    return -1;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -122,7 +122,8 @@ static const Tcl_ChannelType fileChannelType = {
     NULL,			/* Bubbled event handler proc. */
     FileWideSeekProc,
     FileThreadActionProc,
-    FileTruncateProc
+    FileTruncateProc,
+    NULL			/* Vectored output proc. */
 };
 
 /*
@@ -1733,6 +1734,34 @@ NativeIsComPort(
     return 0;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TclpChannelSendfile --
+ *
+ *	Kernel-assisted copying between channels is not implemented on
+ *	Windows; [chan copy] always moves the data through Tcl's buffers.
+ *
+ * Results:
+ *	Always -1, with *errorCodePtr set to ENOTSUP.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+long long
+TclpChannelSendfile(
+    TCL_UNUSED(Tcl_Channel),
+    TCL_UNUSED(Tcl_Channel),
+    TCL_UNUSED(long long),
+    int *errorCodePtr)
+{
+    *errorCodePtr = ENOTSUP;
+    return -1;
+}
+
 /*
  * Local Variables:
  * mode: c
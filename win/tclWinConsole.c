@@ -314,7 +314,8 @@ static const Tcl_ChannelType consoleChannelType = {
     NULL,			/* Bubbled event handler proc. */
     NULL,			/* Seek proc. */
     ConsoleThreadActionProc,
-    NULL			/* Truncation proc. */
+    NULL,			/* Truncation proc. */
+    NULL			/* Vectored output proc. */
 };
 
 /*
@@ -217,7 +217,8 @@ static const Tcl_ChannelType pipeChannelType = {
     NULL,			/* Bubbled event handler proc. */
     NULL,			/* Seek proc. */
     PipeThreadActionProc,
-    NULL			/* Truncate proc. */
+    NULL,			/* Truncate proc. */
+    NULL			/* Vectored output proc. */
 };
 
 /*
@@ -218,7 +218,8 @@ static const Tcl_ChannelType serialChannelType = {
     NULL,			/* Bubbled event handler proc. */
     NULL,			/* Seek proc. */
     SerialThreadActionProc,
-    NULL			/* Truncate proc. */
+    NULL,			/* Truncate proc. */
+    NULL			/* Vectored output proc. */
 };
 
 /*